@@ -0,0 +1,291 @@
+// James Zhu
+// October 2026
+// Implementation of the arrival sampler classes and the factory that
+// creates them from the parameter file.
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <climits>
+using namespace std;
+
+#include "ArrivalSamplerClass.h"
+
+// Number of evenly spaced probabilities the inverse CDF is stored at, and
+// the number of cells the density is integrated over to find them
+const int QUANTILE_TABLE_SIZE = 4097;
+const int DENSITY_INTEGRATION_STEPS = 1 << 16;
+
+// Returns true unless the value is infinite or NaN (isfinite is C99)
+static bool getIsFinite(const double value) {
+    return value - value == 0;
+}
+
+NormalSamplerClass::NormalSamplerClass(const double inMean,
+                                       const double inStdDev)
+ : mean(inMean), stdDev(inStdDev) {}
+
+double NormalSamplerClass::sample(RandomStreamClass &randomStream) {
+    return randomStream.getPositiveNormalReal(mean, stdDev);
+}
+
+void NormalSamplerClass::print(ostream &outStream) const {
+    outStream << "Normal - Mean: " << mean << " StdDev: " << stdDev;
+}
+
+ExponentialSamplerClass::ExponentialSamplerClass(const double inMean)
+ : mean(inMean) {}
+
+double ExponentialSamplerClass::sample(RandomStreamClass &randomStream) {
+    return -mean * log(randomStream.getUniformReal());
+}
+
+void ExponentialSamplerClass::print(ostream &outStream) const {
+    outStream << "Exponential - Mean: " << mean;
+}
+
+EmpiricalSamplerClass::EmpiricalSamplerClass(
+    const double inBinWidth, const vector< double > &inWeights)
+ : binWidth(inBinWidth), binWeights(inWeights) {
+    const int numBins = inWeights.size();
+    double totalWeight = 0;
+    vector< double > scaled(numBins);
+    vector< int > small;
+    vector< int > large;
+
+    for (int i = 0; i < numBins; i++) {
+        totalWeight += inWeights[i];
+    }
+
+    // Vose's alias method: scale so the average bin holds exactly 1, then
+    // repeatedly top up an under-full bin from an over-full one.
+    aliasProbs.assign(numBins, 1.0);
+    aliasBins.assign(numBins, 0);
+    for (int i = 0; i < numBins; i++) {
+        aliasBins[i] = i;
+        scaled[i] = inWeights[i] * numBins / totalWeight;
+        if (scaled[i] < 1.0) {
+            small.push_back(i);
+        }
+        else {
+            large.push_back(i);
+        }
+    }
+    while (!small.empty() && !large.empty()) {
+        int lessBin = small.back();
+        int moreBin = large.back();
+        small.pop_back();
+        aliasProbs[lessBin] = scaled[lessBin];
+        aliasBins[lessBin] = moreBin;
+        scaled[moreBin] -= (1.0 - scaled[lessBin]);
+        if (scaled[moreBin] < 1.0) {
+            large.pop_back();
+            small.push_back(moreBin);
+        }
+    }
+    // Whatever is left over is full up to rounding error
+}
+
+double EmpiricalSamplerClass::sample(RandomStreamClass &randomStream) {
+    const int numBins = aliasProbs.size();
+    double scaledDraw = randomStream.getUniformReal() * numBins;
+    int bin = (int)scaledDraw;
+    double withinBin = scaledDraw - bin;
+
+    if (bin >= numBins) {
+        bin = numBins - 1;
+    }
+    if (randomStream.getUniformReal() >= aliasProbs[bin]) {
+        bin = aliasBins[bin];
+    }
+    return (bin + withinBin) * binWidth;
+}
+
+void EmpiricalSamplerClass::print(ostream &outStream) const {
+    outStream << "Empirical - Bin Width: " << binWidth << " Weights:";
+    for (unsigned int i = 0; i < binWeights.size(); i++) {
+        outStream << " " << binWeights[i];
+    }
+}
+
+TabulatedSamplerClass::TabulatedSamplerClass()
+ : isTableValid(false) {}
+
+void TabulatedSamplerClass::buildTable(const double upperBound,
+                                       const double offset) {
+    const double cellWidth = upperBound / DENSITY_INTEGRATION_STEPS;
+    vector< double > cdf(DENSITY_INTEGRATION_STEPS + 1, 0.0);
+
+    // Midpoint rule, so densities that are infinite at 0 are still fine
+    for (int i = 0; i < DENSITY_INTEGRATION_STEPS; i++) {
+        cdf[i + 1] = cdf[i] + density((i + 0.5) * cellWidth) * cellWidth;
+    }
+
+    // Walk the CDF once, recording where it crosses each table probability
+    quantiles.assign(QUANTILE_TABLE_SIZE, upperBound);
+    quantiles[0] = 0;
+    int cell = 0;
+    for (int k = 1; k < QUANTILE_TABLE_SIZE - 1; k++) {
+        double target = cdf[DENSITY_INTEGRATION_STEPS] * k /
+                        (QUANTILE_TABLE_SIZE - 1);
+        while (cell < DENSITY_INTEGRATION_STEPS - 1 &&
+               cdf[cell + 1] < target) {
+            cell++;
+        }
+        double cellMass = cdf[cell + 1] - cdf[cell];
+        double frac = (cellMass > 0) ? (target - cdf[cell]) / cellMass : 0;
+        quantiles[k] = (cell + frac) * cellWidth;
+    }
+
+    // Interpolating all the way out to upperBound would fatten the tail,
+    // so end the table where the last interval keeps the tail's mean
+    double tailMass = 0;
+    double tailMoment = 0;
+    for (int i = cell; i < DENSITY_INTEGRATION_STEPS; i++) {
+        double cellMass = cdf[i + 1] - cdf[i];
+        tailMass += cellMass;
+        tailMoment += cellMass * (i + 0.5) * cellWidth;
+    }
+    if (tailMass > 0) {
+        quantiles[QUANTILE_TABLE_SIZE - 1] =
+            2 * (tailMoment / tailMass) - quantiles[QUANTILE_TABLE_SIZE - 2];
+    }
+
+    isTableValid = getIsFinite(cdf[DENSITY_INTEGRATION_STEPS]) &&
+                   cdf[DENSITY_INTEGRATION_STEPS] > 0;
+    // A gap is added to an int time, so it must fit in one too
+    for (int k = 0; k < QUANTILE_TABLE_SIZE && isTableValid; k++) {
+        isTableValid = getIsFinite(quantiles[k]) &&
+                       offset + quantiles[k] <= INT_MAX;
+    }
+}
+
+double TabulatedSamplerClass::sample(RandomStreamClass &randomStream) {
+    double scaledDraw = randomStream.getUniformReal() *
+                        (QUANTILE_TABLE_SIZE - 1);
+    int idx = (int)scaledDraw;
+    double frac = scaledDraw - idx;
+
+    if (idx >= QUANTILE_TABLE_SIZE - 1) {
+        return quantiles[QUANTILE_TABLE_SIZE - 1];
+    }
+    return quantiles[idx] + frac * (quantiles[idx + 1] - quantiles[idx]);
+}
+
+LognormalSamplerClass::LognormalSamplerClass(const double inMean,
+                                             const double inStdDev)
+ : mean(inMean), stdDev(inStdDev) {
+    double logVariance = log(1.0 + (stdDev * stdDev) / (mean * mean));
+    logStdDev = sqrt(logVariance);
+    logMean = log(mean) - logVariance / 2;
+    // Five log-standard-deviations out leaves well under 1e-6 in the tail
+    buildTable(exp(logMean + 5 * logStdDev), 0);
+}
+
+double LognormalSamplerClass::density(const double x) const {
+    double z = (log(x) - logMean) / logStdDev;
+    return exp(-0.5 * z * z) / x;
+}
+
+void LognormalSamplerClass::print(ostream &outStream) const {
+    outStream << "Lognormal - Mean: " << mean << " StdDev: " << stdDev;
+}
+
+ShiftedGammaSamplerClass::ShiftedGammaSamplerClass(const double inShift,
+                                                   const double inShape,
+                                                   const double inScale)
+ : shift(inShift), shape(inShape), scale(inScale),
+   mode((inShape > 1) ? (inShape - 1) * inScale : 0) {
+    // Generous enough to cover the tail for both small and large shapes
+    buildTable(scale * (shape + 20 * sqrt(shape) + 20), shift);
+}
+
+double ShiftedGammaSamplerClass::density(const double x) const {
+    // Relative to the peak, in log space, so large shapes don't overflow
+    if (mode > 0) {
+        return exp((shape - 1) * log(x / mode) - (x - mode) / scale);
+    }
+    return exp((shape - 1) * log(x) - x / scale);
+}
+
+double ShiftedGammaSamplerClass::sample(RandomStreamClass &randomStream) {
+    return shift + TabulatedSamplerClass::sample(randomStream);
+}
+
+void ShiftedGammaSamplerClass::print(ostream &outStream) const {
+    outStream << "Shifted Gamma - Shift: " << shift << " Shape: " << shape <<
+                 " Scale: " << scale;
+}
+
+ArrivalSamplerClass* createArrivalSampler(istream &inStream) {
+    string distName;
+    ArrivalSamplerClass *sampler = NULL;
+
+    inStream >> distName;
+    if (distName == "normal") {
+        double mean, stdDev;
+        inStream >> mean >> stdDev;
+        if (!inStream.fail() && mean > 0 && mean <= INT_MAX &&
+            stdDev >= 0 && stdDev <= INT_MAX) {
+            sampler = new NormalSamplerClass(mean, stdDev);
+        }
+    }
+    else if (distName == "exponential") {
+        double mean;
+        inStream >> mean;
+        if (!inStream.fail() && mean > 0 && mean <= INT_MAX) {
+            sampler = new ExponentialSamplerClass(mean);
+        }
+    }
+    else if (distName == "lognormal") {
+        double mean, stdDev;
+        inStream >> mean >> stdDev;
+        if (!inStream.fail() && mean > 0 && stdDev > 0) {
+            LognormalSamplerClass *lognormal =
+                new LognormalSamplerClass(mean, stdDev);
+            if (lognormal->getIsTableValid()) {
+                sampler = lognormal;
+            }
+            else {
+                delete lognormal;
+            }
+        }
+    }
+    else if (distName == "gamma") {
+        double shift, shape, scale;
+        inStream >> shift >> shape >> scale;
+        if (!inStream.fail() && shift >= 0 && shape > 0 && scale > 0) {
+            ShiftedGammaSamplerClass *gamma =
+                new ShiftedGammaSamplerClass(shift, shape, scale);
+            if (gamma->getIsTableValid()) {
+                sampler = gamma;
+            }
+            else {
+                delete gamma;
+            }
+        }
+    }
+    else if (distName == "empirical") {
+        double binWidth;
+        int numBins;
+        double totalWeight = 0;
+        bool weightsValid = true;
+        inStream >> binWidth >> numBins;
+        vector< double > weights;
+        for (int i = 0; i < numBins && !inStream.fail(); i++) {
+            double weight;
+            inStream >> weight;
+            weights.push_back(weight);
+            weightsValid = weightsValid && (weight >= 0);
+            totalWeight += weight;
+        }
+        // The largest gap drawn is the end of the last bin
+        if (!inStream.fail() && binWidth > 0 && numBins > 0 &&
+            binWidth * numBins <= INT_MAX && weightsValid &&
+            totalWeight > 0) {
+            sampler = new EmpiricalSamplerClass(binWidth, weights);
+        }
+    }
+    return sampler;
+}
@@ -0,0 +1,206 @@
+#ifndef _ARRIVALSAMPLERCLASS_H_
+#define _ARRIVALSAMPLERCLASS_H_
+
+#include <iostream>
+#include <vector>
+
+#include "RandomStreamClass.h"
+
+//Programmer: James Zhu
+//Date: October 2026
+//Purpose: A small library of interarrival-time distributions that share a
+//         common sampler interface, so each direction of the intersection
+//         can be given its own arrival model in the parameter file.  Every
+//         sampler draws in O(1): closed forms where they exist, otherwise
+//         an alias table or an inverse-CDF lookup table that is built once
+//         when the sampler is created.
+
+//The common interface all arrival samplers implement.
+class ArrivalSamplerClass
+{
+  public:
+    virtual ~ArrivalSamplerClass(
+         )
+    {
+    }
+
+    //Draws the time until the next arrival from the given stream.
+    virtual double sample(
+         RandomStreamClass &randomStream
+         ) = 0;
+
+    //Prints the distribution and its parameters on a single line.
+    virtual void print(
+         std::ostream &outStream
+         ) const = 0;
+};
+
+//Normal gaps, with negative draws flipped positive just like
+//getPositiveNormal, but without truncating the result to an int.
+class NormalSamplerClass : public ArrivalSamplerClass
+{
+  private:
+    double mean;
+    double stdDev;
+  public:
+    NormalSamplerClass(
+         const double inMean,
+         const double inStdDev
+         );
+    double sample(
+         RandomStreamClass &randomStream
+         );
+    void print(
+         std::ostream &outStream
+         ) const;
+};
+
+//Exponential gaps, i.e. Poisson arrivals, sampled by closed-form inversion.
+class ExponentialSamplerClass : public ArrivalSamplerClass
+{
+  private:
+    double mean;
+  public:
+    ExponentialSamplerClass(
+         const double inMean
+         );
+    double sample(
+         RandomStreamClass &randomStream
+         );
+    void print(
+         std::ostream &outStream
+         ) const;
+};
+
+//Gaps drawn from a histogram of observed values.  Bin i covers
+//[i * binWidth, (i + 1) * binWidth) and is picked in O(1) via Vose's
+//alias method, then the gap is placed uniformly within the bin.
+class EmpiricalSamplerClass : public ArrivalSamplerClass
+{
+  private:
+    double binWidth;
+    std::vector< double > binWeights; //As given, kept for printing
+    std::vector< double > aliasProbs; //Chance of keeping each bin
+    std::vector< int > aliasBins; //Bin used instead when not kept
+  public:
+    //Builds the alias table from the (non-negative, not all zero) weights.
+    EmpiricalSamplerClass(
+         const double inBinWidth,
+         const std::vector< double > &inWeights
+         );
+    double sample(
+         RandomStreamClass &randomStream
+         );
+    void print(
+         std::ostream &outStream
+         ) const;
+};
+
+//Base for distributions without a usable closed-form inverse CDF.  The
+//density is integrated numerically once, and the inverse CDF is stored
+//at evenly spaced probabilities so a draw is one table lookup plus a
+//linear interpolation.
+class TabulatedSamplerClass : public ArrivalSamplerClass
+{
+  private:
+    std::vector< double > quantiles; //Inverse CDF at k / (size - 1)
+    bool isTableValid; //Whether every quantile is finite and, with the
+                       //offset added, fits in an int, and the density
+                       //had a finite, positive total to build them from
+  protected:
+    //Returns the (possibly unnormalized) density at x > 0.  It must stay
+    //finite over the whole table, however extreme the parameters.
+    virtual double density(
+         const double x
+         ) const = 0;
+
+    //Fills the quantile table by integrating density over (0, upperBound],
+    //beyond which the remaining probability is treated as negligible.
+    //The offset is what the derived class adds to every draw, so the
+    //table is only valid if the largest gap drawn still fits in an int.
+    //Must be called by derived constructors once their parameters are set.
+    void buildTable(
+         const double upperBound,
+         const double offset
+         );
+  public:
+    //Creates a sampler whose table is not yet built.
+    TabulatedSamplerClass(
+         );
+
+    //Returns true if the table built is fit to sample from.
+    bool getIsTableValid(
+         ) const
+    {
+      return isTableValid;
+    }
+
+    double sample(
+         RandomStreamClass &randomStream
+         );
+};
+
+//Lognormal gaps, parameterized by the mean and standard deviation of the
+//gap itself rather than of its logarithm.
+class LognormalSamplerClass : public TabulatedSamplerClass
+{
+  private:
+    double mean;
+    double stdDev;
+    double logMean; //Mean of the underlying normal
+    double logStdDev; //Standard deviation of the underlying normal
+  protected:
+    double density(
+         const double x
+         ) const;
+  public:
+    LognormalSamplerClass(
+         const double inMean,
+         const double inStdDev
+         );
+    void print(
+         std::ostream &outStream
+         ) const;
+};
+
+//Gamma gaps shifted right by a minimum headway: shift + Gamma(shape, scale).
+class ShiftedGammaSamplerClass : public TabulatedSamplerClass
+{
+  private:
+    double shift;
+    double shape;
+    double scale;
+    double mode; //Peak of the unshifted density, or 0 if it is at 0
+  protected:
+    double density(
+         const double x
+         ) const;
+  public:
+    ShiftedGammaSamplerClass(
+         const double inShift,
+         const double inShape,
+         const double inScale
+         );
+    double sample(
+         RandomStreamClass &randomStream
+         );
+    void print(
+         std::ostream &outStream
+         ) const;
+};
+
+//Reads a distribution name followed by its parameters from the stream and
+//returns a newly allocated sampler for it, which the caller must delete.
+//Returns NULL if the name is unknown or the parameters are invalid
+//(including ones too extreme to tabulate).
+//Accepted forms:
+//  normal <mean> <stdDev>
+//  exponential <mean>
+//  lognormal <mean> <stdDev>
+//  gamma <shift> <shape> <scale>
+//  empirical <binWidth> <numBins> <weight1> ... <weightN>
+ArrivalSamplerClass* createArrivalSampler(
+     std::istream &inStream
+     );
+
+#endif // _ARRIVALSAMPLERCLASS_H_
@@ -0,0 +1,216 @@
+// James Zhu
+// October 2026
+// Implementation of the ArrivalTraceClass, which streams recorded
+// arrivals out of a memory-mapped trace file without copying it.
+
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <climits>
+using namespace std;
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "ArrivalTraceClass.h"
+
+ArrivalTraceClass::ArrivalTraceClass()
+ : fileDesc(-1), mappedData(NULL), mappedLength(0), dataStartOffset(0),
+   isBinary(false), sharedOffset(0), numPending(0), isBadTimestamp(false) {
+    rewind();
+}
+
+ArrivalTraceClass::~ArrivalTraceClass() {
+    closeTraceFile();
+}
+
+bool ArrivalTraceClass::openTraceFile(const string &inTraceFname) {
+    struct stat fileStats;
+
+    closeTraceFile();
+
+    fileDesc = open(inTraceFname.c_str(), O_RDONLY);
+    if (fileDesc < 0) {
+        cout << "ERROR: Unable to open arrival trace: " << inTraceFname
+             << endl;
+        return false;
+    }
+    if (fstat(fileDesc, &fileStats) != 0 || fileStats.st_size <= 0) {
+        cout << "ERROR: Arrival trace is empty or unreadable: "
+             << inTraceFname << endl;
+        closeTraceFile();
+        return false;
+    }
+
+    mappedLength = (size_t)fileStats.st_size;
+    void *mapping = mmap(NULL, mappedLength, PROT_READ, MAP_PRIVATE,
+                         fileDesc, 0);
+    if (mapping == MAP_FAILED) {
+        cout << "ERROR: Unable to map arrival trace: " << inTraceFname
+             << endl;
+        mappedLength = 0;
+        closeTraceFile();
+        return false;
+    }
+    mappedData = (const char *)mapping;
+
+    // The cursor moves front to back, so let the kernel read ahead
+    madvise(mapping, mappedLength, MADV_SEQUENTIAL);
+
+    // Detect the format from the leading magic bytes
+    isBinary = (mappedLength >= ARRIVAL_TRACE_MAGIC_LEN &&
+                memcmp(mappedData, ARRIVAL_TRACE_MAGIC,
+                       ARRIVAL_TRACE_MAGIC_LEN) == 0);
+    dataStartOffset = isBinary ? ARRIVAL_TRACE_MAGIC_LEN : 0;
+    rewind();
+    traceFname = inTraceFname;
+    return true;
+}
+
+void ArrivalTraceClass::closeTraceFile() {
+    if (mappedData != NULL) {
+        munmap((void *)mappedData, mappedLength);
+        mappedData = NULL;
+    }
+    if (fileDesc >= 0) {
+        close(fileDesc);
+        fileDesc = -1;
+    }
+    mappedLength = 0;
+    traceFname = "";
+}
+
+void ArrivalTraceClass::rewind() {
+    sharedOffset = dataStartOffset;
+    for (int i = 0; i < NUM_DIRECTIONS; i++) {
+        pendingTimes[i].clear();
+        isDetached[i] = false;
+        detachedOffsets[i] = dataStartOffset;
+    }
+    numPending = 0;
+    isBadTimestamp = false;
+}
+
+bool ArrivalTraceClass::getNextArrivalTime(const int dirIdx, int &outTime) {
+    int recordTime = 0;
+    int recordDirIdx = -1;
+
+    if (mappedData == NULL || dirIdx < 0 || dirIdx >= NUM_DIRECTIONS) {
+        return false;
+    }
+    if (!pendingTimes[dirIdx].empty()) {
+        outTime = pendingTimes[dirIdx].front();
+        pendingTimes[dirIdx].pop_front();
+        numPending--;
+        return true;
+    }
+    if (isDetached[dirIdx]) {
+        return findNextDetachedRecord(dirIdx, outTime);
+    }
+
+    while (readRecord(sharedOffset, recordTime, recordDirIdx)) {
+        if (recordDirIdx == dirIdx) {
+            outTime = recordTime;
+            return true;
+        }
+        if (recordDirIdx >= 0 && !isDetached[recordDirIdx]) {
+            pendingTimes[recordDirIdx].push_back(recordTime);
+            numPending++;
+            if (numPending >= ARRIVAL_TRACE_MAX_PENDING) {
+                // Every record of this direction before here has been
+                // read, so its own cursor carries on from here
+                isDetached[dirIdx] = true;
+                detachedOffsets[dirIdx] = sharedOffset;
+                return findNextDetachedRecord(dirIdx, outTime);
+            }
+        }
+    }
+    return false;
+}
+
+bool ArrivalTraceClass::findNextDetachedRecord(const int dirIdx,
+                                               int &outTime) {
+    int recordDirIdx = -1;
+
+    while (readRecord(detachedOffsets[dirIdx], outTime, recordDirIdx)) {
+        if (recordDirIdx == dirIdx) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ArrivalTraceClass::readRecord(size_t &offset, int &outTime,
+                                   int &outDirIdx) {
+    // The first letter of each direction name identifies it in the trace
+    const char DIRECTION_LETTERS[NUM_DIRECTIONS] = {
+        EAST_DIRECTION[0], WEST_DIRECTION[0],
+        NORTH_DIRECTION[0], SOUTH_DIRECTION[0] };
+    const char *data = mappedData;
+
+    outDirIdx = -1;
+    if (isBinary) {
+        const size_t RECORD_LEN = 2 * sizeof(int);
+        int record[2];
+
+        if (offset + RECORD_LEN > mappedLength) {
+            offset = mappedLength;
+            return false;
+        }
+        // memcpy rather than a cast, since records need not be aligned
+        memcpy(record, mappedData + offset, RECORD_LEN);
+        offset += RECORD_LEN;
+        outTime = record[0];
+        if (record[1] >= 0 && record[1] < NUM_DIRECTIONS) {
+            outDirIdx = record[1];
+        }
+        return true;
+    }
+
+    if (offset >= mappedLength) {
+        return false;
+    }
+    // Parse the line in place: digits, a comma, then the direction
+    size_t pos = offset;
+    bool isRecord = (data[pos] >= '0' && data[pos] <= '9');
+    int timestamp = 0;
+    while (pos < mappedLength && data[pos] >= '0' && data[pos] <= '9') {
+        const int digit = data[pos] - '0';
+        if (timestamp > (INT_MAX - digit) / 10) {
+            if (!isBadTimestamp) {
+                cout << "ERROR: Arrival trace timestamp above " << INT_MAX <<
+                        " at byte " << offset << " of " << traceFname <<
+                        endl;
+                isBadTimestamp = true;
+            }
+            offset = mappedLength;
+            return false;
+        }
+        timestamp = timestamp * 10 + digit;
+        pos++;
+    }
+    while (pos < mappedLength && (data[pos] == ',' || data[pos] == ' ' ||
+           data[pos] == '\t')) {
+        pos++;
+    }
+    if (isRecord && pos < mappedLength) {
+        for (int i = 0; i < NUM_DIRECTIONS; i++) {
+            if (data[pos] == DIRECTION_LETTERS[i]) {
+                outDirIdx = i;
+            }
+        }
+    }
+    outTime = timestamp;
+
+    // Move past the end of this line whether or not it is a record
+    const void *lineEnd = memchr(data + pos, '\n', mappedLength - pos);
+    if (lineEnd == NULL) {
+        offset = mappedLength;
+    }
+    else {
+        offset = ((const char *)lineEnd - data) + 1;
+    }
+    return true;
+}
@@ -0,0 +1,140 @@
+#ifndef _ARRIVALTRACECLASS_H_
+#define _ARRIVALTRACECLASS_H_
+
+#include <string>
+#include <deque>
+#include <cstddef>
+
+#include "constants.h"
+
+//Most records read ahead for the other directions, in all, while looking
+//for one direction's next record.  Past this, that direction reads the
+//rest of the file with a cursor of its own instead.
+const size_t ARRIVAL_TRACE_MAX_PENDING = 1 << 20;
+
+//Programmer: James Zhu
+//Date: October 2026
+//Purpose: Replays recorded detector arrivals (timestamp, direction) from a
+//         trace file instead of drawing them from a distribution.  The file
+//         is memory-mapped and read in place, so multi-GB traces are never
+//         copied into memory.  The simulation only ever asks for the
+//         next arrival of one direction at a time, so the four direction
+//         streams are merged lazily by the event list itself.
+//
+//         The file is read once, front to back, by a single shared
+//         cursor: records it passes for other directions than the one
+//         asked for wait in that direction's pending slots until asked
+//         for.  As the simulation asks for each direction's arrivals in
+//         time order, only a short stretch of the trace is ever pending.
+//         A direction with far rarer records (or none left) would make
+//         the others pile up, so once ARRIVAL_TRACE_MAX_PENDING records
+//         are pending it is detached: it scans on with its own cursor,
+//         and the shared cursor skips its records from then on.
+//
+//         Two file formats are supported:
+//           - CSV text: one "timestamp,direction" record per line, where
+//             direction is East/West/North/South (only the first letter
+//             is checked).  Lines not starting with a digit (headers,
+//             comments) are skipped.  A timestamp above INT_MAX ends the
+//             trace with an error.
+//           - Binary: the 8 byte magic ARRIVAL_TRACE_MAGIC followed by
+//             fixed-size records of two native 32-bit ints (timestamp,
+//             direction index).
+//         Records must be sorted by timestamp.
+class ArrivalTraceClass
+{
+  private:
+    int fileDesc; //Descriptor of the open trace file, or -1 if none
+    const char *mappedData; //Start of the read-only mapping of the file
+    size_t mappedLength; //Number of bytes in the mapping
+    size_t dataStartOffset; //Offset of the first record (after any magic)
+    bool isBinary; //True if the file uses the fixed-size binary format
+    size_t sharedOffset; //Offset of the next record the shared cursor
+                         //hasn't read
+    std::deque< int > pendingTimes[NUM_DIRECTIONS]; //Timestamps the shared
+                                                    //cursor has read for
+                                                    //each direction, not
+                                                    //yet asked for
+    size_t numPending; //Timestamps in all the pending slots
+    bool isDetached[NUM_DIRECTIONS]; //Whether each direction has its own
+                                     //cursor rather than the shared one
+    size_t detachedOffsets[NUM_DIRECTIONS]; //Offset of a detached
+                                            //direction's next record
+    bool isBadTimestamp; //Whether a timestamp too large was found
+    std::string traceFname; //Name of the currently open trace file
+
+    //Reads the record (or skipped line) at offset, and moves offset past
+    //it.  Provides its timestamp and DIRECTION_* index via outTime and
+    //outDirIdx, the index being -1 for a line or record to skip.
+    //Returns false at the end of the trace, or at a timestamp above
+    //INT_MAX (printing an error the first time).
+    bool readRecord(
+         size_t &offset,
+         int &outTime,
+         int &outDirIdx
+         );
+
+    //Finds a detached direction's next record with its own cursor.
+    //Returns false when the trace is exhausted.
+    bool findNextDetachedRecord(
+         const int dirIdx,
+         int &outTime
+         );
+
+    //Not copyable - the mapping is owned by exactly one object.
+    ArrivalTraceClass(
+         const ArrivalTraceClass &rhs
+         );
+    ArrivalTraceClass& operator=(
+         const ArrivalTraceClass &rhs
+         );
+
+  public:
+    //Creates a trace object with no file open.
+    ArrivalTraceClass(
+         );
+
+    //Unmaps and closes any open trace file.
+    ~ArrivalTraceClass(
+         );
+
+    //Opens and memory-maps the specified trace file, detecting its format.
+    //Returns true on success.  Any previously open trace is closed first.
+    bool openTraceFile(
+         const std::string &inTraceFname
+         );
+
+    //Unmaps and closes the trace file, if one is open.
+    void closeTraceFile(
+         );
+
+    //Moves the cursor back to the first record, forgetting every pending
+    //record, to replay the trace from the start.
+    void rewind(
+         );
+
+    //Returns true if a trace file is currently open.
+    bool getIsOpen(
+         ) const
+    {
+      return (mappedData != NULL);
+    }
+
+    //Returns the name of the open trace file.
+    const std::string& getTraceFname(
+         ) const
+    {
+      return traceFname;
+    }
+
+    //Provides the timestamp of the next recorded arrival in the specified
+    //direction (one of the DIRECTION_* constants) via outTime, and moves
+    //past it.  Returns false if there are no further arrivals in that
+    //direction.
+    bool getNextArrivalTime(
+         const int dirIdx,
+         int &outTime
+         );
+};
+
+#endif // _ARRIVALTRACECLASS_H_
@@ -0,0 +1,152 @@
+// James Zhu
+// October 2026
+// Implementation of the AsyncLogBufferClass, a double-buffered stream
+// buffer whose text is written out by a background thread.
+
+#include <streambuf>
+#include <vector>
+using namespace std;
+
+#include <pthread.h>
+
+#include "AsyncLogBufferClass.h"
+
+AsyncLogBufferClass::AsyncLogBufferClass()
+ : targetBuffer(NULL), fillIdx(0), pendingIdx(-1), pendingLength(0),
+   isStopping(false) {
+    pthread_mutex_init(&handOffMutex, NULL);
+    pthread_cond_init(&bufferFilled, NULL);
+    pthread_cond_init(&bufferEmptied, NULL);
+    // No put area until there is a target, so all text is discarded
+    setp(NULL, NULL);
+}
+
+AsyncLogBufferClass::~AsyncLogBufferClass() {
+    if (targetBuffer != NULL) {
+        stopWriter();
+    }
+    pthread_cond_destroy(&bufferEmptied);
+    pthread_cond_destroy(&bufferFilled);
+    pthread_mutex_destroy(&handOffMutex);
+}
+
+bool AsyncLogBufferClass::setTarget(streambuf *inTarget) {
+    if (targetBuffer != NULL) {
+        stopWriter();
+    }
+    setp(NULL, NULL);
+    targetBuffer = inTarget;
+    if (targetBuffer == NULL) {
+        return true;
+    }
+    return startWriter();
+}
+
+bool AsyncLogBufferClass::startWriter() {
+    // Allocated once, the first time there is a target
+    for (int i = 0; i < 2; i++) {
+        buffers[i].resize(ASYNC_LOG_BUFFER_SIZE);
+    }
+    fillIdx = 0;
+    setp(&buffers[fillIdx][0], &buffers[fillIdx][0] + ASYNC_LOG_BUFFER_SIZE);
+    pendingIdx = -1;
+    isStopping = false;
+    if (pthread_create(&writerThread, NULL, runWriter, this) != 0) {
+        setp(NULL, NULL);
+        targetBuffer = NULL;
+        return false;
+    }
+    return true;
+}
+
+void AsyncLogBufferClass::stopWriter() {
+    drain();
+    pthread_mutex_lock(&handOffMutex);
+    isStopping = true;
+    pthread_cond_signal(&bufferFilled);
+    pthread_mutex_unlock(&handOffMutex);
+
+    pthread_join(writerThread, NULL);
+    setp(NULL, NULL);
+    targetBuffer = NULL;
+}
+
+void AsyncLogBufferClass::handOver() {
+    const int length = (int)(pptr() - pbase());
+
+    if (length == 0) {
+        return;
+    }
+    pthread_mutex_lock(&handOffMutex);
+    // The other buffer is the one the writer may still be writing
+    while (pendingIdx != -1) {
+        pthread_cond_wait(&bufferEmptied, &handOffMutex);
+    }
+    pendingIdx = fillIdx;
+    pendingLength = length;
+    pthread_cond_signal(&bufferFilled);
+    pthread_mutex_unlock(&handOffMutex);
+
+    fillIdx = 1 - fillIdx;
+    setp(&buffers[fillIdx][0], &buffers[fillIdx][0] + ASYNC_LOG_BUFFER_SIZE);
+}
+
+void AsyncLogBufferClass::drain() {
+    if (targetBuffer == NULL) {
+        return;
+    }
+    handOver();
+    pthread_mutex_lock(&handOffMutex);
+    while (pendingIdx != -1) {
+        pthread_cond_wait(&bufferEmptied, &handOffMutex);
+    }
+    pthread_mutex_unlock(&handOffMutex);
+}
+
+AsyncLogBufferClass::int_type AsyncLogBufferClass::overflow(int_type ch) {
+    if (targetBuffer == NULL) {
+        return traits_type::not_eof(ch);
+    }
+    handOver();
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+    }
+    return traits_type::not_eof(ch);
+}
+
+int AsyncLogBufferClass::sync() {
+    return 0;
+}
+
+void* AsyncLogBufferClass::runWriter(void *logBufferPtr) {
+    AsyncLogBufferClass *logBuffer = (AsyncLogBufferClass *)logBufferPtr;
+
+    while (true) {
+        pthread_mutex_lock(&logBuffer->handOffMutex);
+        while (logBuffer->pendingIdx == -1 && !logBuffer->isStopping) {
+            pthread_cond_wait(&logBuffer->bufferFilled,
+                              &logBuffer->handOffMutex);
+        }
+        // Stopping only follows a drain, so nothing is left to write
+        if (logBuffer->pendingIdx == -1) {
+            pthread_mutex_unlock(&logBuffer->handOffMutex);
+            break;
+        }
+        const int writeIdx = logBuffer->pendingIdx;
+        const int length = logBuffer->pendingLength;
+        pthread_mutex_unlock(&logBuffer->handOffMutex);
+
+        // The simulation doesn't touch a pending buffer, so no lock is
+        // needed to write it
+        logBuffer->targetBuffer->sputn(&logBuffer->buffers[writeIdx][0],
+                                       length);
+        logBuffer->targetBuffer->pubsync();
+
+        pthread_mutex_lock(&logBuffer->handOffMutex);
+        logBuffer->pendingIdx = -1;
+        pthread_cond_signal(&logBuffer->bufferEmptied);
+        pthread_mutex_unlock(&logBuffer->handOffMutex);
+    }
+    return NULL;
+}
@@ -0,0 +1,112 @@
+#ifndef _ASYNCLOGBUFFERCLASS_H_
+#define _ASYNCLOGBUFFERCLASS_H_
+
+#include <streambuf>
+#include <vector>
+#include <pthread.h>
+
+//Bytes in each of the two buffers
+const int ASYNC_LOG_BUFFER_SIZE = 64 * 1024;
+
+//Programmer: James Zhu
+//Date: October 2026
+//Purpose: A stream buffer that lets a simulation narrate its events
+//         without waiting on the terminal or the disk.  Text is formatted
+//         straight into one of two buffers; once that buffer is full it
+//         is handed to a background thread, which writes it to the
+//         target stream buffer while the simulation fills the other.
+//         The simulation only waits when the writer is a whole buffer
+//         behind.
+//
+//         Flushing the stream (as endl does after every line) does NOT
+//         write anything out, since that would put the wait back on every
+//         line.  Text reaches the target when a buffer fills, and
+//         everything pending is written by drain, so the owner drains
+//         before anything else is written to the same target.
+//
+//         Each simulation owns its own, so simulations on separate
+//         threads never share a buffer.
+class AsyncLogBufferClass : public std::streambuf
+{
+  private:
+    std::streambuf *targetBuffer; //Where the text is written, or NULL
+                                  //when the writer isn't running
+    std::vector< char > buffers[2]; //Filled in turn by the simulation
+    int fillIdx; //Buffer the simulation is filling (the put area)
+
+    int pendingIdx; //Buffer handed to the writer and not yet written,
+                    //or -1 if none
+    int pendingLength; //Bytes in it
+    bool isStopping; //Set when the writer should exit once idle
+
+    pthread_t writerThread;
+    pthread_mutex_t handOffMutex; //Guards pendingIdx, pendingLength and
+                                  //isStopping
+    pthread_cond_t bufferFilled; //Signalled when a buffer is handed over
+                                 //or the writer should stop
+    pthread_cond_t bufferEmptied; //Signalled when a buffer is written
+
+    //Hands the text in the put area to the writer, waiting for the
+    //other buffer to be free, and makes that buffer the put area.
+    void handOver(
+         );
+
+    //Starts the writer thread for the current target.  Returns false,
+    //leaving the target NULL, if the thread can't be started.
+    bool startWriter(
+         );
+
+    //Writes out everything pending and stops the writer thread.
+    void stopWriter(
+         );
+
+    //Thread body: writes each buffer handed over to the target until
+    //told to stop.  The argument is the log buffer.
+    static void* runWriter(
+         void *logBufferPtr
+         );
+
+    //Not copyable - the thread and buffers belong to exactly one object.
+    AsyncLogBufferClass(
+         const AsyncLogBufferClass &rhs
+         );
+    AsyncLogBufferClass& operator=(
+         const AsyncLogBufferClass &rhs
+         );
+
+  protected:
+    //Called when the put area is full: hands it over and stores the
+    //character in the other buffer.
+    int_type overflow(
+         int_type ch
+         );
+
+    //Called when the stream is flushed.  Does nothing, as lines are
+    //written a buffer at a time.
+    int sync(
+         );
+
+  public:
+    //Creates a buffer with no target, which discards its text.
+    AsyncLogBufferClass(
+         );
+
+    //Writes out everything pending and stops the writer.
+    ~AsyncLogBufferClass(
+         );
+
+    //Writes out everything pending to the current target, then sends
+    //text to the given stream buffer from now on, or discards it if
+    //inTarget is NULL.  Returns false, discarding text, if the writer
+    //thread can't be started.
+    bool setTarget(
+         std::streambuf *inTarget
+         );
+
+    //Writes out everything formatted so far, waiting until the writer
+    //has written it and flushed the target.
+    void drain(
+         );
+};
+
+#endif // _ASYNCLOGBUFFERCLASS_H_
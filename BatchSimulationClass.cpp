@@ -0,0 +1,305 @@
+// James Zhu
+// October 2026
+// Implementation of the lockstep batch simulation.  Every loop over the
+// lanes of a block is written without branches (selects and masks only)
+// so it vectorizes, and the stepping functions are built for several
+// instruction sets with the best one picked when the program starts.
+
+#include <cmath>
+#include <algorithm>
+using namespace std;
+
+#include "BatchSimulationClass.h"
+
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__)
+#define BATCH_TARGET_CLONES \
+    __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define BATCH_TARGET_CLONES
+#endif
+
+// Same construction as getPositiveNormal in random.cpp
+const int NUM_NORMAL_UNIFORMS = 12;
+const int NORMAL_UNIFORM_MAX = 1000;
+
+// Streams of a lane's xorshift generators
+const uint32_t ARRIVAL_STREAM = 1;
+const uint32_t YELLOW_STREAM = 2;
+
+// One step of Marsaglia's 32-bit xorshift generator
+static inline uint32_t xorshift32(uint32_t state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+// Maps a generator output onto [0, range), for ranges up to 65536, by
+// scaling its top 16 bits.  Unlike a modulo this stays in 32-bit vector
+// arithmetic.
+static inline uint32_t uniformBelow(const uint32_t state,
+                                    const uint32_t range) {
+    return ((state >> 16) * range) >> 16;
+}
+
+// Mixes a scenario seed and stream number into a non-zero generator state
+static uint32_t seedStream(const int seedVal, const uint32_t stream) {
+    uint32_t state = (uint32_t)seedVal * 0x9E3779B9u + stream * 0x85EBCA6Bu;
+    state ^= state >> 16;
+    state *= 0x7FEB352Du;
+    state ^= state >> 15;
+    state *= 0x846CA68Bu;
+    state ^= state >> 16;
+    return (state == 0) ? 0x6D2B79F5u : state;
+}
+
+BatchSimulationClass::BatchSimulationClass() : maxYellowTime(0) {}
+
+void BatchSimulationClass::loadBlock(const SimulationParamsStruct *params,
+                                     const int numScenarios) {
+    maxYellowTime = 0;
+    for (int l = 0; l < BATCH_LANES; l++) {
+        // Spare lanes copy the first scenario so their values stay sane
+        const SimulationParamsStruct &p = params[(l < numScenarios) ? l : 0];
+
+        endTimes[l] = p.timeToStopSim;
+        lightDurations[0][l] = p.eastWestGreenTime;
+        lightDurations[1][l] = p.eastWestYellowTime;
+        lightDurations[2][l] = p.northSouthGreenTime;
+        lightDurations[3][l] = p.northSouthYellowTime;
+        for (int d = 0; d < NUM_DIRECTIONS; d++) {
+            arrivalMeans[d][l] = (int)p.arrivalMeans[d];
+            arrivalStdDevs[d][l] = (int)p.arrivalStdDevs[d];
+            queueLengths[d][l] = 0;
+            maxQueueLengths[d][l] = 0;
+            numTotalAdvanced[d][l] = 0;
+        }
+        percentAdvanceOnYellow[l] = p.percentCarsAdvanceOnYellow;
+        maxYellowTime = max(maxYellowTime, max(p.eastWestYellowTime,
+                                               p.northSouthYellowTime));
+
+        isDone[l] = (l < numScenarios) ? 0 : 1;
+        currentTimes[l] = 0;
+        currentLights[l] = LIGHT_GREEN_EW;
+        nextSeqs[l] = 0;
+        arrivalRngs[l] = seedStream(p.randomSeedVal, ARRIVAL_STREAM);
+        yellowRngs[l] = seedStream(p.randomSeedVal, YELLOW_STREAM);
+    }
+}
+
+void BatchSimulationClass::scheduleSeedEvents() {
+    int gaps[BATCH_LANES];
+
+    for (int d = 0; d < NUM_DIRECTIONS; d++) {
+        for (int l = 0; l < BATCH_LANES; l++) {
+            eventKinds[l] = isDone[l] ? BATCH_EVENT_NONE : d;
+        }
+        drawArrivalGaps(gaps);
+        for (int l = 0; l < BATCH_LANES; l++) {
+            arrivalTimes[d][l] = gaps[l];
+            arrivalSeqs[d][l] = nextSeqs[l]++;
+        }
+    }
+    for (int l = 0; l < BATCH_LANES; l++) {
+        lightChangeTimes[l] = lightDurations[0][l];
+        lightChangeSeqs[l] = nextSeqs[l]++;
+    }
+}
+
+BATCH_TARGET_CLONES
+void BatchSimulationClass::drawArrivalGaps(int gaps[BATCH_LANES]) {
+    for (int l = 0; l < BATCH_LANES; l++) {
+        const int kind = eventKinds[l];
+        const int mean = (kind == DIRECTION_EAST) ? arrivalMeans[0][l] :
+                         (kind == DIRECTION_WEST) ? arrivalMeans[1][l] :
+                         (kind == DIRECTION_NORTH) ? arrivalMeans[2][l] :
+                         arrivalMeans[3][l];
+        const int stdDev = (kind == DIRECTION_EAST) ? arrivalStdDevs[0][l] :
+                           (kind == DIRECTION_WEST) ? arrivalStdDevs[1][l] :
+                           (kind == DIRECTION_NORTH) ? arrivalStdDevs[2][l] :
+                           arrivalStdDevs[3][l];
+        uint32_t state = arrivalRngs[l];
+        int sum = 0;
+
+        for (int i = 0; i < NUM_NORMAL_UNIFORMS; i++) {
+            state = xorshift32(state);
+            sum += uniformBelow(state, NORMAL_UNIFORM_MAX + 1);
+        }
+        // Lanes not handling an arrival drew too, but keep their state
+        arrivalRngs[l] = (kind < NUM_DIRECTIONS) ? state : arrivalRngs[l];
+
+        double standardNormal = (double)sum / NORMAL_UNIFORM_MAX -
+                                NUM_NORMAL_UNIFORMS * 0.5;
+        gaps[l] = (int)fabs(mean + stdDev * standardNormal);
+    }
+}
+
+BATCH_TARGET_CLONES
+void BatchSimulationClass::advanceCarsOnPhaseEnd() {
+    int isChanging[BATCH_LANES];
+    int isYellowEnding[BATCH_LANES];
+    int phaseDurations[BATCH_LANES];
+    int waiting[2][BATCH_LANES];
+    int numAdvanced[2][BATCH_LANES];
+    int anyYellowEnding = 0;
+
+    for (int l = 0; l < BATCH_LANES; l++) {
+        const int light = currentLights[l];
+        const int isEastWest = (light <= LIGHT_YELLOW_EW) ? 1 : 0;
+        isChanging[l] = (eventKinds[l] == BATCH_EVENT_LIGHT) ? 1 : 0;
+        isYellowEnding[l] = (light % 2 == 0) ? isChanging[l] : 0;
+        phaseDurations[l] = (light == LIGHT_GREEN_EW) ? lightDurations[0][l] :
+                            (light == LIGHT_YELLOW_EW) ? lightDurations[1][l] :
+                            (light == LIGHT_GREEN_NS) ? lightDurations[2][l] :
+                            lightDurations[3][l];
+        waiting[0][l] = isEastWest ? queueLengths[DIRECTION_EAST][l] :
+                                     queueLengths[DIRECTION_NORTH][l];
+        waiting[1][l] = isEastWest ? queueLengths[DIRECTION_WEST][l] :
+                                     queueLengths[DIRECTION_SOUTH][l];
+        // Green lets one car through per tic; yellow is decided below
+        for (int k = 0; k < 2; k++) {
+            numAdvanced[k][l] = (isChanging[l] > isYellowEnding[l]) ?
+                                min(waiting[k][l], phaseDurations[l]) : 0;
+        }
+        anyYellowEnding |= isYellowEnding[l];
+    }
+
+    // Each car at the front decides in turn, and the first that stops
+    // holds up the rest; the east (north) cars all decide before the west
+    // (south) ones, as in the simulation
+    if (anyYellowEnding) {
+        for (int k = 0; k < 2; k++) {
+            int numCars[BATCH_LANES];
+            int isDeciding[BATCH_LANES];
+            for (int l = 0; l < BATCH_LANES; l++) {
+                numCars[l] = min(phaseDurations[l], waiting[k][l]);
+                isDeciding[l] = isYellowEnding[l];
+            }
+            for (int car = 0; car < maxYellowTime; car++) {
+                for (int l = 0; l < BATCH_LANES; l++) {
+                    uint32_t next = xorshift32(yellowRngs[l]);
+                    int chance = (int)uniformBelow(next, INCLUSIVE_MAX -
+                                                   INCLUSIVE_MIN + 1) +
+                                 INCLUSIVE_MIN;
+                    int doesAdvance = (chance <= percentAdvanceOnYellow[l]) ?
+                                      1 : 0;
+                    isDeciding[l] = (car < numCars[l]) ? isDeciding[l] : 0;
+                    yellowRngs[l] = isDeciding[l] ? next : yellowRngs[l];
+                    isDeciding[l] &= doesAdvance;
+                    numAdvanced[k][l] += isDeciding[l];
+                }
+            }
+        }
+    }
+
+    for (int l = 0; l < BATCH_LANES; l++) {
+        const int isEastWest = (currentLights[l] <= LIGHT_YELLOW_EW) ? 1 : 0;
+        const int eastWestCars[2] = {
+            isEastWest ? numAdvanced[0][l] : 0,
+            isEastWest ? numAdvanced[1][l] : 0 };
+        const int northSouthCars[2] = {
+            isEastWest ? 0 : numAdvanced[0][l],
+            isEastWest ? 0 : numAdvanced[1][l] };
+        queueLengths[DIRECTION_EAST][l] -= eastWestCars[0];
+        queueLengths[DIRECTION_WEST][l] -= eastWestCars[1];
+        queueLengths[DIRECTION_NORTH][l] -= northSouthCars[0];
+        queueLengths[DIRECTION_SOUTH][l] -= northSouthCars[1];
+        numTotalAdvanced[DIRECTION_EAST][l] += eastWestCars[0];
+        numTotalAdvanced[DIRECTION_WEST][l] += eastWestCars[1];
+        numTotalAdvanced[DIRECTION_NORTH][l] += northSouthCars[0];
+        numTotalAdvanced[DIRECTION_SOUTH][l] += northSouthCars[1];
+    }
+}
+
+BATCH_TARGET_CLONES
+bool BatchSimulationClass::stepLanes() {
+    int gaps[BATCH_LANES];
+    int anyArrival = 0;
+    int anyLightChange = 0;
+    int anyActive = 0;
+
+    // Find each lane's next event: earliest time, then earliest scheduled
+    for (int l = 0; l < BATCH_LANES; l++) {
+        int nextTime = lightChangeTimes[l];
+        int nextSeq = lightChangeSeqs[l];
+        int kind = BATCH_EVENT_LIGHT;
+        for (int d = 0; d < NUM_DIRECTIONS; d++) {
+            int isSooner = (arrivalTimes[d][l] < nextTime ||
+                            (arrivalTimes[d][l] == nextTime &&
+                             arrivalSeqs[d][l] < nextSeq)) ? 1 : 0;
+            nextTime = isSooner ? arrivalTimes[d][l] : nextTime;
+            nextSeq = isSooner ? arrivalSeqs[d][l] : nextSeq;
+            kind = isSooner ? d : kind;
+        }
+        int isActive = (nextTime <= endTimes[l]) ? 1 - isDone[l] : 0;
+        isDone[l] = 1 - isActive;
+        currentTimes[l] = isActive ? nextTime : currentTimes[l];
+        eventKinds[l] = isActive ? kind : BATCH_EVENT_NONE;
+        anyArrival |= (kind < NUM_DIRECTIONS) ? isActive : 0;
+        anyLightChange |= (kind == BATCH_EVENT_LIGHT) ? isActive : 0;
+        anyActive |= isActive;
+    }
+
+    if (anyArrival) {
+        drawArrivalGaps(gaps);
+        for (int d = 0; d < NUM_DIRECTIONS; d++) {
+            for (int l = 0; l < BATCH_LANES; l++) {
+                int isArriving = (eventKinds[l] == d) ? 1 : 0;
+                queueLengths[d][l] += isArriving;
+                maxQueueLengths[d][l] = max(maxQueueLengths[d][l],
+                                            queueLengths[d][l]);
+                arrivalTimes[d][l] = isArriving ?
+                                     currentTimes[l] + gaps[l] :
+                                     arrivalTimes[d][l];
+                arrivalSeqs[d][l] = isArriving ? nextSeqs[l] :
+                                                 arrivalSeqs[d][l];
+            }
+        }
+    }
+
+    if (anyLightChange) {
+        advanceCarsOnPhaseEnd();
+        for (int l = 0; l < BATCH_LANES; l++) {
+            int isChanging = (eventKinds[l] == BATCH_EVENT_LIGHT) ? 1 : 0;
+            int newLight = currentLights[l] % NUM_BATCH_LIGHTS + 1;
+            int duration = (newLight == LIGHT_GREEN_EW) ?
+                           lightDurations[0][l] :
+                           (newLight == LIGHT_YELLOW_EW) ?
+                           lightDurations[1][l] :
+                           (newLight == LIGHT_GREEN_NS) ?
+                           lightDurations[2][l] : lightDurations[3][l];
+            currentLights[l] = isChanging ? newLight : currentLights[l];
+            lightChangeTimes[l] = isChanging ?
+                                  currentTimes[l] + duration :
+                                  lightChangeTimes[l];
+            lightChangeSeqs[l] = isChanging ? nextSeqs[l] :
+                                              lightChangeSeqs[l];
+        }
+    }
+
+    // Every event handled schedules exactly one new one
+    for (int l = 0; l < BATCH_LANES; l++) {
+        nextSeqs[l] += (eventKinds[l] != BATCH_EVENT_NONE) ? 1 : 0;
+    }
+    return anyActive;
+}
+
+void BatchSimulationClass::runScenarios(const SimulationParamsStruct *params,
+                                        const int numScenarios,
+                                        SimulationStatsStruct *stats) {
+    for (int first = 0; first < numScenarios; first += BATCH_LANES) {
+        const int numInBlock = min(BATCH_LANES, numScenarios - first);
+
+        loadBlock(params + first, numInBlock);
+        scheduleSeedEvents();
+        while (stepLanes()) {
+        }
+
+        for (int l = 0; l < numInBlock; l++) {
+            for (int d = 0; d < NUM_DIRECTIONS; d++) {
+                stats[first + l].maxQueueLengths[d] = maxQueueLengths[d][l];
+                stats[first + l].numTotalAdvanced[d] = numTotalAdvanced[d][l];
+            }
+        }
+    }
+}
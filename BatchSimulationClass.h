@@ -0,0 +1,115 @@
+#ifndef _BATCHSIMULATIONCLASS_H_
+#define _BATCHSIMULATIONCLASS_H_
+
+#include <stdint.h>
+
+#include "constants.h"
+#include "SimulationStructs.h"
+
+//Number of scenarios simulated side by side in one block.  16 ints fill
+//one AVX-512 register (or two AVX2 registers).
+const int BATCH_LANES = 16;
+
+//Number of light states in the basic cycle, LIGHT_GREEN_EW through
+//LIGHT_YELLOW_NS
+const int NUM_BATCH_LIGHTS = 4;
+
+//What a lane handles in a step, other than an arrival (whose kind is the
+//arriving direction's index)
+const int BATCH_EVENT_LIGHT = NUM_DIRECTIONS;
+const int BATCH_EVENT_NONE = NUM_DIRECTIONS + 1;
+
+//Programmer: James Zhu
+//Date: October 2026
+//Purpose: Runs many independent fixed-timing scenarios of the basic
+//         intersection simulation (the nine required parameters only) in
+//         lockstep, BATCH_LANES at a time.  Each scenario only needs four
+//         queue counts, a light state and its five pending events, so the
+//         state of a block is kept as structure-of-arrays, one array
+//         element per lane, and every step handles the next event of
+//         every lane at once with branch-free loops over the lanes that
+//         the compiler vectorizes.
+//
+//         Events are ordered by time and then by the order they were
+//         scheduled in, exactly as in IntersectionSimulationClass, and
+//         queues are counts rather than lists of cars, so any scenario
+//         without randomness (zero standard deviations, and 0 or 100
+//         percent advancing on yellow) gives exactly the statistics of
+//         IntersectionSimulationClass.  Random scenarios draw from two
+//         xorshift streams per lane (arrivals, yellow decisions) seeded
+//         from the scenario's seed instead of the global rand(), so they
+//         match the single-scenario simulation in distribution only.
+class BatchSimulationClass
+{
+  private:
+    //Parameters of the scenario in each lane
+    int endTimes[BATCH_LANES]; //Time after which events aren't handled
+    int lightDurations[NUM_BATCH_LIGHTS][BATCH_LANES]; //Tics each light
+                                                       //state lasts
+    int arrivalMeans[NUM_DIRECTIONS][BATCH_LANES]; //Truncated to ints as
+    int arrivalStdDevs[NUM_DIRECTIONS][BATCH_LANES]; //the simulation does
+    int percentAdvanceOnYellow[BATCH_LANES]; //0 to 100
+    int maxYellowTime; //Longest yellow of any lane in the block
+
+    //Execution state of each lane
+    int isDone[BATCH_LANES]; //1 once the lane's next event is past its end
+    int currentTimes[BATCH_LANES]; //Time of the lane's latest event
+    int currentLights[BATCH_LANES]; //LIGHT_GREEN_EW to LIGHT_YELLOW_NS
+    int lightChangeTimes[BATCH_LANES]; //Time of the pending light change
+    int lightChangeSeqs[BATCH_LANES]; //Order it was scheduled in
+    int arrivalTimes[NUM_DIRECTIONS][BATCH_LANES]; //Time of each pending
+                                                   //arrival
+    int arrivalSeqs[NUM_DIRECTIONS][BATCH_LANES]; //Order each was scheduled
+    int nextSeqs[BATCH_LANES]; //Order number for the next scheduled event
+    int eventKinds[BATCH_LANES]; //What the lane is handling this step: a
+                                 //direction index for an arrival, or one
+                                 //of the BATCH_EVENT_* values
+    uint32_t arrivalRngs[BATCH_LANES]; //Xorshift state for arrival gaps
+    uint32_t yellowRngs[BATCH_LANES]; //Xorshift state for yellow choices
+    int queueLengths[NUM_DIRECTIONS][BATCH_LANES]; //Cars waiting
+
+    //Statistics of each lane
+    int maxQueueLengths[NUM_DIRECTIONS][BATCH_LANES];
+    int numTotalAdvanced[NUM_DIRECTIONS][BATCH_LANES];
+
+    //Sets up every lane of the block, the first numScenarios from the
+    //given parameters and any others as already finished.
+    void loadBlock(
+         const SimulationParamsStruct *params,
+         const int numScenarios
+         );
+
+    //Schedules the seed events of every lane, in the same order as
+    //IntersectionSimulationClass::scheduleSeedEvents.
+    void scheduleSeedEvents(
+         );
+
+    //Handles the next event of every unfinished lane.  Returns false once
+    //every lane of the block has finished.
+    bool stepLanes(
+         );
+
+    //Draws the next arrival gap of each lane handling an arrival.
+    void drawArrivalGaps(
+         int gaps[BATCH_LANES]
+         );
+
+    //Advances the cars of each lane whose light is changing, as the
+    //simulation does at the end of the light state that is ending.
+    void advanceCarsOnPhaseEnd(
+         );
+
+  public:
+    BatchSimulationClass(
+         );
+
+    //Simulates numScenarios independent scenarios, BATCH_LANES at a time,
+    //storing each scenario's statistics in the matching element of stats.
+    void runScenarios(
+         const SimulationParamsStruct *params,
+         const int numScenarios,
+         SimulationStatsStruct *stats
+         );
+};
+
+#endif // _BATCHSIMULATIONCLASS_H_
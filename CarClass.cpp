@@ -4,7 +4,7 @@
 using namespace std;
 
 //Assign the static attribute used for auto-assigning unique ids
-int CarClass::nextIdVal = 0;
+__thread int CarClass::nextIdVal = 0;
 
 ostream& operator<<(
      ostream& outStream,
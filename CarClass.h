@@ -15,7 +15,10 @@
 class CarClass
 {
   private:
-    static int nextIdVal; //Static attribute used to auto-assign unique ids
+    static __thread int nextIdVal; //Static attribute used to auto-assign
+                                   //unique ids, one per thread so
+                                   //simulations on separate threads
+                                   //don't race on it
     int uniqueId; //A unique identifier auto-assigned to each car
     std::string travelDir; //Direction this car object is traveling
     int arrivalTime; //The time at which the car arrived at the intersection
@@ -38,13 +41,29 @@ class CarClass
     //An explicit default ctor that allows an "empty" car to be
     //created so that one can be declared in order to be passed
     //into a function by reference to be populated (such as
-    //the FIFOQueueClass::dequeue method).
+    //the RingQueueClass::dequeue method).
     CarClass(
          )
     {
       uniqueId = CAR_ID_NOT_SET;
     }
 
+    //Returns the id the next car created on this thread will get.
+    static int getNextId(
+         )
+    {
+      return nextIdVal;
+    }
+
+    //Sets the id the next car created on this thread will get, so a
+    //restored run numbers its cars as it did the first time.
+    static void setNextId(
+         const int inNextIdVal
+         )
+    {
+      nextIdVal = inNextIdVal;
+    }
+
     //Simple getter for the car's unique id value attribute
     int getId(
          ) const
@@ -52,6 +71,13 @@ class CarClass
       return uniqueId;
     }
 
+    //Simple getter for the time the car arrived at the intersection
+    int getArrivalTime(
+         ) const
+    {
+      return arrivalTime;
+    }
+
     //Since this insertion operator really ought to be a method, but 
     //can't be due to the way C++ manages operator overloading, we
     //make it an "honorary method" by declaring it as a friend.
@@ -0,0 +1,238 @@
+// James Zhu
+// October 2026
+// Implementation of the ColumnarReaderClass, which reads columnar result
+// files in place out of a read-only memory mapping.
+
+#include <string>
+#include <vector>
+#include <cstring>
+#include <stdint.h>
+using namespace std;
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "ColumnarReaderClass.h"
+
+// Returns the offset rounded up to the next multiple of the alignment
+static int64_t alignOffset(const int64_t offset) {
+    return (offset + COLUMNAR_ALIGNMENT - 1) / COLUMNAR_ALIGNMENT *
+           COLUMNAR_ALIGNMENT;
+}
+
+ColumnarReaderClass::ColumnarReaderClass()
+ : mappedData(NULL), mappedLength(0), numRows(0) {}
+
+ColumnarReaderClass::~ColumnarReaderClass() {
+    close();
+}
+
+bool ColumnarReaderClass::open(const string &inFname) {
+    struct stat fileStats;
+
+    close();
+    int fileDesc = ::open(inFname.c_str(), O_RDONLY);
+    if (fileDesc < 0) {
+        return false;
+    }
+    if (fstat(fileDesc, &fileStats) != 0 || fileStats.st_size == 0) {
+        ::close(fileDesc);
+        return false;
+    }
+    mappedLength = (size_t)fileStats.st_size;
+    void *mapping = mmap(NULL, mappedLength, PROT_READ, MAP_PRIVATE,
+                         fileDesc, 0);
+    ::close(fileDesc);
+    if (mapping == MAP_FAILED) {
+        mappedLength = 0;
+        return false;
+    }
+    mappedData = (const char *)mapping;
+
+    if (!parseLayout()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void ColumnarReaderClass::close() {
+    if (mappedData != NULL) {
+        munmap((void *)mappedData, mappedLength);
+    }
+    mappedData = NULL;
+    mappedLength = 0;
+    columns.clear();
+    columnOffsets.clear();
+    rowGroupNumRows.clear();
+    numRows = 0;
+}
+
+bool ColumnarReaderClass::parseLayout() {
+    const int64_t length = (int64_t)mappedLength;
+    // The magic, the footer's last three fields and the closing magic
+    const int64_t minLength = 2 * COLUMNAR_MAGIC_LENGTH + 3 * 8;
+    int64_t pos = 0;
+    int64_t numColumns = 0;
+
+    if (length < minLength || length % COLUMNAR_ALIGNMENT != 0 ||
+        memcmp(mappedData, COLUMNAR_MAGIC, COLUMNAR_MAGIC_LENGTH) != 0 ||
+        memcmp(mappedData + length - COLUMNAR_MAGIC_LENGTH, COLUMNAR_MAGIC,
+               COLUMNAR_MAGIC_LENGTH) != 0) {
+        return false;
+    }
+    // Every field read is 8-byte aligned, as the mapping itself is
+    const int64_t *footerEnd = (const int64_t *)(mappedData + length -
+                                                 COLUMNAR_MAGIC_LENGTH);
+    const int64_t footerOffset = footerEnd[-1];
+    numRows = footerEnd[-2];
+    const int64_t numRowGroups = footerEnd[-3];
+    if (footerOffset < COLUMNAR_MAGIC_LENGTH || numRowGroups < 0 ||
+        numRowGroups > length / 8 ||
+        footerOffset + numRowGroups * 8 + minLength -
+        COLUMNAR_MAGIC_LENGTH != length) {
+        return false;
+    }
+    const int64_t *rowGroupOffsets = (const int64_t *)(mappedData +
+                                                       footerOffset);
+
+    // The schema
+    pos = COLUMNAR_MAGIC_LENGTH;
+    numColumns = *(const int64_t *)(mappedData + pos);
+    pos += 8;
+    if (numColumns <= 0 || numColumns > footerOffset / 16) {
+        return false;
+    }
+    for (int i = 0; i < numColumns; i++) {
+        if (pos + 16 > footerOffset) {
+            return false;
+        }
+        ColumnSpecStruct column;
+        const int64_t *fields = (const int64_t *)(mappedData + pos);
+        column.type = (int)fields[0];
+        const int64_t nameLength = fields[1];
+        pos += 16;
+        if (column.type < 0 || column.type >= NUM_COLUMN_TYPES ||
+            nameLength < 0 || pos + nameLength > footerOffset) {
+            return false;
+        }
+        column.name.assign(mappedData + pos, (size_t)nameLength);
+        pos = alignOffset(pos + nameLength);
+        columns.push_back(column);
+    }
+
+    // The row groups, each checked to lie before the footer
+    int64_t totalRows = 0;
+    for (int g = 0; g < numRowGroups; g++) {
+        pos = rowGroupOffsets[g];
+        if (pos < COLUMNAR_MAGIC_LENGTH || pos % COLUMNAR_ALIGNMENT != 0 ||
+            pos + 8 > footerOffset) {
+            return false;
+        }
+        const int64_t groupRows = *(const int64_t *)(mappedData + pos);
+        if (groupRows <= 0 || groupRows > footerOffset) {
+            return false;
+        }
+        pos += 8;
+        columnOffsets.push_back(vector< int64_t >());
+        for (int i = 0; i < numColumns; i++) {
+            columnOffsets.back().push_back(pos);
+            pos = alignOffset(pos + groupRows *
+                              COLUMN_TYPE_SIZES[columns[i].type]);
+        }
+        if (pos > footerOffset) {
+            return false;
+        }
+        rowGroupNumRows.push_back((int)groupRows);
+        totalRows += groupRows;
+    }
+    return totalRows == numRows;
+}
+
+int ColumnarReaderClass::findColumn(const string &name) const {
+    for (int i = 0; i < (int)columns.size(); i++) {
+        if (columns[i].name == name) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+const int32_t* ColumnarReaderClass::getIntColumn(const int groupIdx,
+                                                 const int columnIdx) const {
+    if (columns[columnIdx].type != COLUMN_INT32) {
+        return NULL;
+    }
+    return (const int32_t *)(mappedData +
+                             columnOffsets[groupIdx][columnIdx]);
+}
+
+const double* ColumnarReaderClass::getRealColumn(const int groupIdx,
+                                                 const int columnIdx) const {
+    if (columns[columnIdx].type != COLUMN_FLOAT64) {
+        return NULL;
+    }
+    return (const double *)(mappedData + columnOffsets[groupIdx][columnIdx]);
+}
+
+bool getIsSimulationResultFile(const ColumnarReaderClass &reader) {
+    vector< ColumnSpecStruct > resultColumns;
+
+    getSimulationResultColumns(resultColumns);
+    if (reader.getNumColumns() != (int)resultColumns.size()) {
+        return false;
+    }
+    for (int i = 0; i < (int)resultColumns.size(); i++) {
+        if (reader.getColumn(i).name != resultColumns[i].name ||
+            reader.getColumn(i).type != resultColumns[i].type) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool readSimulationResult(const ColumnarReaderClass &reader,
+                          const int groupIdx, const int rowIdx,
+                          SimulationParamsStruct &outParams,
+                          SimulationStatsStruct &outStats) {
+    int columnIdx = 0;
+
+    if (!getIsSimulationResultFile(reader) || groupIdx < 0 ||
+        groupIdx >= reader.getNumRowGroups() || rowIdx < 0 ||
+        rowIdx >= reader.getRowGroupNumRows(groupIdx)) {
+        return false;
+    }
+
+    // Columns in the order writeSimulationResult sets them
+    outParams.randomSeedVal = reader.getIntColumn(groupIdx,
+                                                  columnIdx++)[rowIdx];
+    outParams.timeToStopSim = reader.getIntColumn(groupIdx,
+                                                  columnIdx++)[rowIdx];
+    outParams.eastWestGreenTime = reader.getIntColumn(groupIdx,
+                                                      columnIdx++)[rowIdx];
+    outParams.eastWestYellowTime = reader.getIntColumn(groupIdx,
+                                                       columnIdx++)[rowIdx];
+    outParams.northSouthGreenTime = reader.getIntColumn(groupIdx,
+                                                        columnIdx++)[rowIdx];
+    outParams.northSouthYellowTime = reader.getIntColumn(groupIdx,
+                                                         columnIdx++)[rowIdx];
+    for (int d = 0; d < NUM_DIRECTIONS; d++) {
+        outParams.arrivalMeans[d] = reader.getRealColumn(groupIdx,
+                                                         columnIdx++)[rowIdx];
+        outParams.arrivalStdDevs[d] = reader.getRealColumn(
+                                          groupIdx, columnIdx++)[rowIdx];
+    }
+    outParams.percentCarsAdvanceOnYellow = reader.getIntColumn(
+                                               groupIdx, columnIdx++)[rowIdx];
+    for (int d = 0; d < NUM_DIRECTIONS; d++) {
+        outStats.maxQueueLengths[d] = reader.getIntColumn(
+                                          groupIdx, columnIdx++)[rowIdx];
+    }
+    for (int d = 0; d < NUM_DIRECTIONS; d++) {
+        outStats.numTotalAdvanced[d] = reader.getIntColumn(
+                                           groupIdx, columnIdx++)[rowIdx];
+    }
+    return true;
+}
@@ -0,0 +1,138 @@
+#ifndef _COLUMNARREADERCLASS_H_
+#define _COLUMNARREADERCLASS_H_
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <stdint.h>
+
+#include "ColumnarWriterClass.h"
+
+//Programmer: James Zhu
+//Date: October 2026
+//Purpose: Reads a columnar result file written by ColumnarWriterClass.
+//         The file is memory-mapped, and each column of each row group is
+//         handed out as a pointer to its values in the mapping, so a scan
+//         of one column only pages in that column's bytes and the file is
+//         never copied into memory.
+class ColumnarReaderClass
+{
+  private:
+    const char *mappedData; //Start of the read-only mapping, or NULL
+    size_t mappedLength; //Number of bytes in the mapping
+    std::vector< ColumnSpecStruct > columns; //The schema
+    std::vector< std::vector< int64_t > > columnOffsets; //Where each
+                                                         //column's values
+                                                         //start, per row
+                                                         //group
+    std::vector< int > rowGroupNumRows; //Rows of each row group
+    int64_t numRows; //Rows in the file
+
+    //Reads the schema and footer and locates every column chunk.
+    //Returns false if the file isn't a complete columnar result file.
+    bool parseLayout(
+         );
+
+    //Not copyable - the mapping is owned by exactly one object.
+    ColumnarReaderClass(
+         const ColumnarReaderClass &rhs
+         );
+    ColumnarReaderClass& operator=(
+         const ColumnarReaderClass &rhs
+         );
+
+  public:
+    //Creates a reader with no file open.
+    ColumnarReaderClass(
+         );
+
+    //Unmaps any open file.
+    ~ColumnarReaderClass(
+         );
+
+    //Maps the file and reads its layout.  Returns false if it can't be
+    //opened or isn't a complete columnar result file.  Any file already
+    //open is closed first.
+    bool open(
+         const std::string &inFname
+         );
+
+    //Unmaps the file, if one is open.
+    void close(
+         );
+
+    //Returns the number of columns, or 0 with no file open.
+    int getNumColumns(
+         ) const
+    {
+      return (int)columns.size();
+    }
+
+    //Returns the name and type of a column.
+    const ColumnSpecStruct& getColumn(
+         const int columnIdx
+         ) const
+    {
+      return columns[columnIdx];
+    }
+
+    //Returns the index of the column with the given name, or -1.
+    int findColumn(
+         const std::string &name
+         ) const;
+
+    //Returns the total number of rows.
+    int64_t getNumRows(
+         ) const
+    {
+      return numRows;
+    }
+
+    //Returns the number of row groups.
+    int getNumRowGroups(
+         ) const
+    {
+      return (int)rowGroupNumRows.size();
+    }
+
+    //Returns the number of rows of a row group.
+    int getRowGroupNumRows(
+         const int groupIdx
+         ) const
+    {
+      return rowGroupNumRows[groupIdx];
+    }
+
+    //Returns a COLUMN_INT32 column's values in a row group, or NULL if
+    //the column is of another type.
+    const int32_t* getIntColumn(
+         const int groupIdx,
+         const int columnIdx
+         ) const;
+
+    //Returns a COLUMN_FLOAT64 column's values in a row group, or NULL if
+    //the column is of another type.
+    const double* getRealColumn(
+         const int groupIdx,
+         const int columnIdx
+         ) const;
+};
+
+//Returns true if the reader's file has exactly the simulation result
+//columns of getSimulationResultColumns.
+bool getIsSimulationResultFile(
+     const ColumnarReaderClass &reader
+     );
+
+//Reads a row of a row group of a simulation result file, the reverse of
+//writeSimulationResult.  Returns false if the file doesn't have the
+//simulation result columns or there is no such row.
+bool readSimulationResult(
+     const ColumnarReaderClass &reader,
+     const int groupIdx,
+     const int rowIdx,
+     SimulationParamsStruct &outParams,
+     SimulationStatsStruct &outStats
+     );
+
+#endif // _COLUMNARREADERCLASS_H_
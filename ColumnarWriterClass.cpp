@@ -0,0 +1,207 @@
+// James Zhu
+// October 2026
+// Implementation of the ColumnarWriterClass, which writes rows of results
+// to a columnar file in row groups, and of the simulation result schema.
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cctype>
+#include <stdint.h>
+using namespace std;
+
+#include "ColumnarWriterClass.h"
+
+ColumnarWriterClass::ColumnarWriterClass()
+ : rowGroupSize(0), numBufferedRows(0), numRows(0), isOpen(false) {}
+
+ColumnarWriterClass::~ColumnarWriterClass() {
+    if (isOpen) {
+        close();
+    }
+}
+
+bool ColumnarWriterClass::open(const string &outFname,
+                               const vector< ColumnSpecStruct > &inColumns,
+                               const int inRowGroupSize) {
+    if (isOpen) {
+        close();
+    }
+    if (inColumns.empty() || inRowGroupSize <= 0) {
+        return false;
+    }
+    for (int i = 0; i < (int)inColumns.size(); i++) {
+        if (inColumns[i].type < 0 || inColumns[i].type >= NUM_COLUMN_TYPES) {
+            return false;
+        }
+    }
+
+    outFile.clear();
+    outFile.open(outFname.c_str(), ios::out | ios::binary | ios::trunc);
+    if (outFile.fail()) {
+        return false;
+    }
+    columns = inColumns;
+    rowGroupSize = inRowGroupSize;
+    columnBuffers.assign(columns.size(), vector< char >());
+    for (int i = 0; i < (int)columns.size(); i++) {
+        columnBuffers[i].assign(
+            (size_t)rowGroupSize * COLUMN_TYPE_SIZES[columns[i].type], 0);
+    }
+    numBufferedRows = 0;
+    rowGroupOffsets.clear();
+    numRows = 0;
+    isOpen = true;
+
+    outFile.write(COLUMNAR_MAGIC, COLUMNAR_MAGIC_LENGTH);
+    writeInt64((int64_t)columns.size());
+    for (int i = 0; i < (int)columns.size(); i++) {
+        writeInt64(columns[i].type);
+        writeInt64((int64_t)columns[i].name.size());
+        outFile.write(columns[i].name.data(), columns[i].name.size());
+        writePadding();
+    }
+    return !outFile.fail();
+}
+
+void ColumnarWriterClass::writeInt64(const int64_t value) {
+    outFile.write((const char *)&value, sizeof(value));
+}
+
+void ColumnarWriterClass::writePadding() {
+    const char zeros[COLUMNAR_ALIGNMENT] = { 0 };
+    const int64_t misalignment = (int64_t)outFile.tellp() % COLUMNAR_ALIGNMENT;
+
+    if (misalignment != 0) {
+        outFile.write(zeros, COLUMNAR_ALIGNMENT - misalignment);
+    }
+}
+
+void ColumnarWriterClass::setValue(const int columnIdx,
+                                   const void *valuePtr) {
+    const int valueSize = COLUMN_TYPE_SIZES[columns[columnIdx].type];
+
+    memcpy(&columnBuffers[columnIdx][(size_t)numBufferedRows * valueSize],
+           valuePtr, valueSize);
+}
+
+void ColumnarWriterClass::setInt(const int columnIdx, const int32_t value) {
+    setValue(columnIdx, &value);
+}
+
+void ColumnarWriterClass::setReal(const int columnIdx, const double value) {
+    setValue(columnIdx, &value);
+}
+
+bool ColumnarWriterClass::endRow() {
+    numBufferedRows++;
+    numRows++;
+    if (numBufferedRows == rowGroupSize) {
+        writeRowGroup();
+    }
+    return !outFile.fail();
+}
+
+void ColumnarWriterClass::writeRowGroup() {
+    rowGroupOffsets.push_back((int64_t)outFile.tellp());
+    writeInt64(numBufferedRows);
+    for (int i = 0; i < (int)columns.size(); i++) {
+        outFile.write(&columnBuffers[i][0], (streamsize)numBufferedRows *
+                      COLUMN_TYPE_SIZES[columns[i].type]);
+        writePadding();
+    }
+    numBufferedRows = 0;
+}
+
+bool ColumnarWriterClass::close() {
+    if (!isOpen) {
+        return false;
+    }
+    if (numBufferedRows > 0) {
+        writeRowGroup();
+    }
+
+    const int64_t footerOffset = (int64_t)outFile.tellp();
+    for (int i = 0; i < (int)rowGroupOffsets.size(); i++) {
+        writeInt64(rowGroupOffsets[i]);
+    }
+    writeInt64((int64_t)rowGroupOffsets.size());
+    writeInt64(numRows);
+    writeInt64(footerOffset);
+    outFile.write(COLUMNAR_MAGIC, COLUMNAR_MAGIC_LENGTH);
+
+    const bool success = !outFile.fail();
+    outFile.close();
+    columnBuffers.clear();
+    isOpen = false;
+    return success;
+}
+
+// Names of the required int parameters' columns before the arrival
+// distributions, in parameter file order
+const int NUM_PARAM_INT_COLUMNS = 6;
+const string PARAM_INT_COLUMN_NAMES[NUM_PARAM_INT_COLUMNS] = {
+    "randomSeed", "endTime", "eastWestGreen", "eastWestYellow",
+    "northSouthGreen", "northSouthYellow" };
+const string PERCENT_YELLOW_COLUMN_NAME = "percentAdvanceOnYellow";
+
+static void addColumn(vector< ColumnSpecStruct > &columns, const string &name,
+                      const int type) {
+    ColumnSpecStruct column;
+    column.name = name;
+    column.type = type;
+    columns.push_back(column);
+}
+
+// Returns the direction's name starting lower case, to prefix its columns
+static string getColumnPrefix(const int dirIdx) {
+    string prefix = DIRECTION_NAMES[dirIdx];
+    prefix[0] = (char)tolower(prefix[0]);
+    return prefix;
+}
+
+void getSimulationResultColumns(vector< ColumnSpecStruct > &outColumns) {
+    outColumns.clear();
+    for (int i = 0; i < NUM_PARAM_INT_COLUMNS; i++) {
+        addColumn(outColumns, PARAM_INT_COLUMN_NAMES[i], COLUMN_INT32);
+    }
+    for (int d = 0; d < NUM_DIRECTIONS; d++) {
+        addColumn(outColumns, getColumnPrefix(d) + "ArrivalMean",
+                  COLUMN_FLOAT64);
+        addColumn(outColumns, getColumnPrefix(d) + "ArrivalStdDev",
+                  COLUMN_FLOAT64);
+    }
+    addColumn(outColumns, PERCENT_YELLOW_COLUMN_NAME, COLUMN_INT32);
+    for (int d = 0; d < NUM_DIRECTIONS; d++) {
+        addColumn(outColumns, getColumnPrefix(d) + "MaxQueue", COLUMN_INT32);
+    }
+    for (int d = 0; d < NUM_DIRECTIONS; d++) {
+        addColumn(outColumns, getColumnPrefix(d) + "Advanced", COLUMN_INT32);
+    }
+}
+
+bool writeSimulationResult(ColumnarWriterClass &writer,
+                           const SimulationParamsStruct &params,
+                           const SimulationStatsStruct &stats) {
+    int columnIdx = 0;
+
+    writer.setInt(columnIdx++, params.randomSeedVal);
+    writer.setInt(columnIdx++, params.timeToStopSim);
+    writer.setInt(columnIdx++, params.eastWestGreenTime);
+    writer.setInt(columnIdx++, params.eastWestYellowTime);
+    writer.setInt(columnIdx++, params.northSouthGreenTime);
+    writer.setInt(columnIdx++, params.northSouthYellowTime);
+    for (int d = 0; d < NUM_DIRECTIONS; d++) {
+        writer.setReal(columnIdx++, params.arrivalMeans[d]);
+        writer.setReal(columnIdx++, params.arrivalStdDevs[d]);
+    }
+    writer.setInt(columnIdx++, params.percentCarsAdvanceOnYellow);
+    for (int d = 0; d < NUM_DIRECTIONS; d++) {
+        writer.setInt(columnIdx++, stats.maxQueueLengths[d]);
+    }
+    for (int d = 0; d < NUM_DIRECTIONS; d++) {
+        writer.setInt(columnIdx++, stats.numTotalAdvanced[d]);
+    }
+    return writer.endRow();
+}
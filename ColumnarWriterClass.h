@@ -0,0 +1,152 @@
+#ifndef _COLUMNARWRITERCLASS_H_
+#define _COLUMNARWRITERCLASS_H_
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#include "SimulationStructs.h"
+
+//Magic bytes at the start and the very end of a columnar result file
+const char COLUMNAR_MAGIC[] = "SIMCOL01";
+const int COLUMNAR_MAGIC_LENGTH = 8;
+
+//Types of the values of a column
+const int COLUMN_INT32 = 0; //Native 32-bit ints
+const int COLUMN_FLOAT64 = 1; //Native doubles
+const int NUM_COLUMN_TYPES = 2;
+const int COLUMN_TYPE_SIZES[NUM_COLUMN_TYPES] = { 4, 8 };
+
+//Every header field, column chunk and footer starts on a multiple of
+//this many bytes, so mapped columns can be read as arrays in place
+const int COLUMNAR_ALIGNMENT = 8;
+
+//Rows buffered and written together unless told otherwise
+const int DEFAULT_ROW_GROUP_SIZE = 65536;
+
+//The name and type of one column of a columnar result file.
+struct ColumnSpecStruct
+{
+  std::string name;
+  int type; //One of the COLUMN_* types
+};
+
+//Programmer: James Zhu
+//Date: October 2026
+//Purpose: Writes rows of results to a columnar binary file, so analysis
+//         tools can read one statistic of millions of runs as a plain
+//         array instead of scraping printed lines.  Rows are buffered
+//         column by column and written out as row groups of a fixed
+//         number of rows, so memory stays bounded however many rows are
+//         written.
+//
+//         The file is laid out as follows, every integer native 64-bit
+//         unless noted, and every part padded to COLUMNAR_ALIGNMENT:
+//           - COLUMNAR_MAGIC, the number of columns, then per column its
+//             type, the length of its name and the name itself (the
+//             schema).
+//           - Row groups: each is its number of rows, then each column's
+//             values for those rows, in schema order.
+//           - The footer: the file offset of every row group, the number
+//             of row groups, the total number of rows, the offset of the
+//             footer itself and COLUMNAR_MAGIC again, so a reader finds
+//             every row group from the end of the file.
+class ColumnarWriterClass
+{
+  private:
+    std::ofstream outFile; //The file being written
+    std::vector< ColumnSpecStruct > columns; //The schema
+    int rowGroupSize; //Rows per complete row group
+    std::vector< std::vector< char > > columnBuffers; //Values of the rows
+                                                      //not yet written,
+                                                      //per column
+    int numBufferedRows; //Complete rows in the buffers
+    std::vector< int64_t > rowGroupOffsets; //Where each group written is
+    int64_t numRows; //Rows written or buffered
+    bool isOpen; //Whether a file is being written
+
+    //Writes a 64-bit integer.
+    void writeInt64(
+         const int64_t value
+         );
+
+    //Writes zero bytes up to the next multiple of COLUMNAR_ALIGNMENT.
+    void writePadding(
+         );
+
+    //Writes the buffered rows as a row group and empties the buffers.
+    void writeRowGroup(
+         );
+
+    //Copies the bytes of a value into a column's buffer for the current
+    //row.
+    void setValue(
+         const int columnIdx,
+         const void *valuePtr
+         );
+
+  public:
+    //Creates a writer with no file open.
+    ColumnarWriterClass(
+         );
+
+    //Closes any open file, completing it.
+    ~ColumnarWriterClass(
+         );
+
+    //Creates the file, replacing any existing one, and writes the schema.
+    //Returns false if the schema is empty or has an unknown type, the
+    //row group size isn't positive, or the file can't be written.  Any
+    //file already open is closed first.
+    bool open(
+         const std::string &outFname,
+         const std::vector< ColumnSpecStruct > &inColumns,
+         const int inRowGroupSize = DEFAULT_ROW_GROUP_SIZE
+         );
+
+    //Sets a value of the current row.  The column must be of the
+    //matching type; every column should be set before endRow.
+    void setInt(
+         const int columnIdx,
+         const int32_t value
+         );
+    void setReal(
+         const int columnIdx,
+         const double value
+         );
+
+    //Completes the current row, writing a row group once enough rows are
+    //buffered.  Returns false if writing failed.
+    bool endRow(
+         );
+
+    //Writes any buffered rows and the footer, and closes the file.
+    //Returns false if no file was open or writing failed.
+    bool close(
+         );
+
+    //Returns the number of rows completed so far.
+    int64_t getNumRows(
+         ) const
+    {
+      return numRows;
+    }
+};
+
+//Columns of a simulation result row: the nine required parameters in
+//parameter file order, then each direction's longest queue, then each
+//direction's cars advanced
+void getSimulationResultColumns(
+     std::vector< ColumnSpecStruct > &outColumns
+     );
+
+//Sets and completes a row of a writer opened with the simulation result
+//columns.  Returns false if writing failed.
+bool writeSimulationResult(
+     ColumnarWriterClass &writer,
+     const SimulationParamsStruct &params,
+     const SimulationStatsStruct &stats
+     );
+
+#endif // _COLUMNARWRITERCLASS_H_
@@ -0,0 +1,166 @@
+// James Zhu
+// October 2026
+// Implementation of the ConvergenceMonitorClass, which watches batch
+// means of a run's throughput and queue length for convergence.
+
+#include <iostream>
+#include <cmath>
+using namespace std;
+
+#include "ConvergenceMonitorClass.h"
+
+// Student t quantiles for a two-sided 95% interval, by degrees of freedom
+const int NUM_T_QUANTILES = 30;
+const double T_QUANTILES_95[NUM_T_QUANTILES] = {
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042 };
+
+// Beyond the table, within 0.002 of the exact quantile up to the
+// largest number of batches ever kept
+static double getTQuantile95(const int degreesOfFreedom) {
+    if (degreesOfFreedom <= NUM_T_QUANTILES) {
+        return T_QUANTILES_95[degreesOfFreedom - 1];
+    }
+    return 1.96 + 2.4 / degreesOfFreedom;
+}
+
+ConvergenceMonitorClass::ConvergenceMonitorClass()
+ : checkEvents(0), relativePrecision(0) {
+    restart();
+}
+
+bool ConvergenceMonitorClass::setup(const int inCheckEvents,
+                                    const double inRelativePrecision) {
+    if (inCheckEvents <= 0 || !(inRelativePrecision > 0)) {
+        checkEvents = 0;
+        return false;
+    }
+    checkEvents = inCheckEvents;
+    relativePrecision = inRelativePrecision;
+    restart();
+    return true;
+}
+
+void ConvergenceMonitorClass::restart() {
+    restartAt(0, 0);
+}
+
+void ConvergenceMonitorClass::restartAt(const int startTime,
+                                        const int startAdvanced) {
+    eventsSinceCheck = 0;
+    lastEventTime = startTime;
+    queueArea = 0;
+    lastCheckTime = startTime;
+    lastCheckAdvanced = startAdvanced;
+
+    checksPerBatch = 1;
+    checksInBatch = 0;
+    pendingTics = 0;
+    pendingAdvanced = 0;
+    pendingQueueArea = 0;
+
+    numBatches = 0;
+    for (int i = 0; i < NUM_CONVERGENCE_METRICS; i++) {
+        metricSums[i] = 0;
+        metricSumSquares[i] = 0;
+    }
+    isConverged = false;
+}
+
+double ConvergenceMonitorClass::getBatchMetric(const int batchIdx,
+                                               const int metricIdx) const {
+    if (metricIdx == CONVERGENCE_THROUGHPUT) {
+        return batchAdvanced[batchIdx] / batchTics[batchIdx];
+    }
+    return batchQueueAreas[batchIdx] / batchTics[batchIdx];
+}
+
+void ConvergenceMonitorClass::addToSums(const int batchIdx) {
+    for (int i = 0; i < NUM_CONVERGENCE_METRICS; i++) {
+        double value = getBatchMetric(batchIdx, i);
+        metricSums[i] += value;
+        metricSumSquares[i] += value * value;
+    }
+}
+
+void ConvergenceMonitorClass::mergeBatches() {
+    for (int i = 0; i < NUM_CONVERGENCE_METRICS; i++) {
+        metricSums[i] = 0;
+        metricSumSquares[i] = 0;
+    }
+    numBatches /= 2;
+    for (int i = 0; i < numBatches; i++) {
+        batchTics[i] = batchTics[2 * i] + batchTics[2 * i + 1];
+        batchAdvanced[i] = batchAdvanced[2 * i] + batchAdvanced[2 * i + 1];
+        batchQueueAreas[i] = batchQueueAreas[2 * i] +
+                             batchQueueAreas[2 * i + 1];
+        addToSums(i);
+    }
+    checksPerBatch *= 2;
+}
+
+bool ConvergenceMonitorClass::checkConvergence(const int totalAdvanced) {
+    pendingTics += lastEventTime - lastCheckTime;
+    pendingAdvanced += totalAdvanced - lastCheckAdvanced;
+    pendingQueueArea += queueArea;
+    lastCheckTime = lastEventTime;
+    lastCheckAdvanced = totalAdvanced;
+    queueArea = 0;
+    eventsSinceCheck = 0;
+    checksInBatch++;
+
+    // A batch in which no time has passed has no rates yet, so it simply
+    // carries on into the next check
+    if (checksInBatch < checksPerBatch || pendingTics <= 0) {
+        return isConverged;
+    }
+    batchTics[numBatches] = pendingTics;
+    batchAdvanced[numBatches] = pendingAdvanced;
+    batchQueueAreas[numBatches] = pendingQueueArea;
+    addToSums(numBatches);
+    numBatches++;
+    checksInBatch = 0;
+    pendingTics = 0;
+    pendingAdvanced = 0;
+    pendingQueueArea = 0;
+    if (numBatches == MAX_CONVERGENCE_BATCHES) {
+        mergeBatches();
+    }
+
+    if (!isConverged && numBatches >= MIN_CONVERGENCE_BATCHES) {
+        isConverged = true;
+        for (int i = 0; i < NUM_CONVERGENCE_METRICS; i++) {
+            if (getHalfWidth(i) > relativePrecision * fabs(getMean(i))) {
+                isConverged = false;
+            }
+        }
+    }
+    return isConverged;
+}
+
+double ConvergenceMonitorClass::getMean(const int metricIdx) const {
+    if (numBatches == 0) {
+        return 0;
+    }
+    return metricSums[metricIdx] / numBatches;
+}
+
+double ConvergenceMonitorClass::getHalfWidth(const int metricIdx) const {
+    if (numBatches < 2) {
+        return 0;
+    }
+    double variance = (metricSumSquares[metricIdx] -
+                       metricSums[metricIdx] * metricSums[metricIdx] /
+                       numBatches) / (numBatches - 1);
+    // Rounding can leave a tiny negative variance when batches agree
+    if (variance < 0) {
+        variance = 0;
+    }
+    return getTQuantile95(numBatches - 1) * sqrt(variance / numBatches);
+}
+
+void ConvergenceMonitorClass::print(ostream &outStream) const {
+    outStream << "check every " << checkEvents << " events, relative "
+              << "precision: " << relativePrecision;
+}
@@ -0,0 +1,161 @@
+#ifndef _CONVERGENCEMONITORCLASS_H_
+#define _CONVERGENCEMONITORCLASS_H_
+
+#include <iostream>
+
+//Batches kept at once; when full, neighbouring batches are merged in
+//pairs, doubling the batch size
+const int MAX_CONVERGENCE_BATCHES = 64;
+//Fewest batches a confidence interval is trusted with
+const int MIN_CONVERGENCE_BATCHES = 10;
+
+//The output measures watched for convergence
+const int CONVERGENCE_THROUGHPUT = 0; //Cars advanced per tic
+const int CONVERGENCE_QUEUE_LENGTH = 1; //Time-average cars queued
+const int NUM_CONVERGENCE_METRICS = 2;
+
+//Programmer: James Zhu
+//Date: October 2026
+//Purpose: Decides when a run has measured its throughput and queue length
+//         precisely enough to stop, by the method of batch means.  Every
+//         checkEvents events the simulation closes a check: the cars
+//         advanced and the queue-length-time area since the last one.
+//         Checks are grouped into batches, and the mean of each measure
+//         over the batches, with a 95% confidence interval from their
+//         spread, is compared to the requested relative precision.
+//
+//         Memory is bounded: once MAX_CONVERGENCE_BATCHES batches are
+//         full, neighbouring pairs are merged and each batch from then on
+//         holds twice as many checks, so batches keep growing with the
+//         run (and their correlation keeps shrinking) without more of
+//         them being stored.  Each event costs O(1), and each check
+//         O(1) too, apart from the merge, which is amortized over the
+//         many checks between merges.
+class ConvergenceMonitorClass
+{
+  private:
+    int checkEvents; //Events between checks, or 0 when not monitoring
+    double relativePrecision; //Largest acceptable ratio of the confidence
+                              //interval half width to the mean
+
+    int eventsSinceCheck; //Events counted since the last check
+    int lastEventTime; //Time of the most recent event
+    double queueArea; //Sum of cars queued times tics, since the last check
+    int lastCheckTime; //Time of the last check
+    int lastCheckAdvanced; //Total cars advanced at the last check
+
+    int checksPerBatch; //Checks grouped into each batch
+    int checksInBatch; //Checks in the batch being filled
+    double pendingTics; //Tics of the batch being filled
+    double pendingAdvanced; //Cars advanced in the batch being filled
+    double pendingQueueArea; //Queue area of the batch being filled
+
+    int numBatches; //Batches completed
+    double batchTics[MAX_CONVERGENCE_BATCHES]; //Length of each batch
+    double batchAdvanced[MAX_CONVERGENCE_BATCHES]; //Cars advanced in each
+    double batchQueueAreas[MAX_CONVERGENCE_BATCHES]; //Queue area of each
+    double metricSums[NUM_CONVERGENCE_METRICS]; //Sum over the batches of
+                                                //each batch's measure
+    double metricSumSquares[NUM_CONVERGENCE_METRICS]; //And of its square
+    bool isConverged; //Whether the precision has been reached
+
+    //Returns a measure of one completed batch.
+    double getBatchMetric(
+         const int batchIdx,
+         const int metricIdx
+         ) const;
+
+    //Adds a completed batch's measures to the sums.
+    void addToSums(
+         const int batchIdx
+         );
+
+    //Merges neighbouring batches in pairs and recomputes the sums.
+    void mergeBatches(
+         );
+
+  public:
+    //Creates a monitor that is not monitoring.
+    ConvergenceMonitorClass(
+         );
+
+    //Starts monitoring, checking every inCheckEvents events until the
+    //confidence intervals are within inRelativePrecision of the means.
+    //Returns false, leaving the monitor off, if either is not positive.
+    bool setup(
+         const int inCheckEvents,
+         const double inRelativePrecision
+         );
+
+    //Returns true if the monitor is watching for convergence.
+    bool getIsEnabled(
+         ) const
+    {
+      return (checkEvents > 0);
+    }
+
+    //Forgets every batch, ready to watch a new run from time 0.
+    void restart(
+         );
+
+    //Forgets every batch, ready to watch the rest of a run from
+    //startTime, when startAdvanced cars had been advanced (for example
+    //once its warm-up has been cut off).
+    void restartAt(
+         const int startTime,
+         const int startAdvanced
+         );
+
+    //Accounts for an event about to be handled at eventTime, the queues
+    //having held numQueued cars since the previous event.  Returns true
+    //when this event completes a check, which the caller must then pass
+    //to checkConvergence.
+    bool addEvent(
+         const int eventTime,
+         const int numQueued
+         )
+    {
+      queueArea += (double)numQueued * (eventTime - lastEventTime);
+      lastEventTime = eventTime;
+      eventsSinceCheck++;
+      return (eventsSinceCheck >= checkEvents);
+    }
+
+    //Closes a check, given the total cars advanced so far, and returns
+    //true if the run has now converged.
+    bool checkConvergence(
+         const int totalAdvanced
+         );
+
+    //Returns true if the requested precision has been reached.
+    bool getIsConverged(
+         ) const
+    {
+      return isConverged;
+    }
+
+    //Returns the number of batches completed.
+    int getNumBatches(
+         ) const
+    {
+      return numBatches;
+    }
+
+    //Returns the mean over the batches of a CONVERGENCE_* measure.
+    double getMean(
+         const int metricIdx
+         ) const;
+
+    //Returns the half width of the 95% confidence interval around the
+    //mean of a CONVERGENCE_* measure, or 0 with fewer than two batches.
+    double getHalfWidth(
+         const int metricIdx
+         ) const;
+
+    //Prints the check interval and precision.
+    void print(
+         std::ostream &outStream
+         ) const;
+};
+
+#endif // _CONVERGENCEMONITORCLASS_H_
@@ -31,6 +31,28 @@ ostream& operator<<(ostream& outStream, const EventClass &eventToPrint) {
     else if (eventToPrint.typeId == EVENT_CHANGE_YELLOW_NS) {
         outStream << "Light Change to NS Yellow";
     }
+    else if (eventToPrint.typeId == EVENT_CHECK_GREEN) {
+        outStream << "Signal Controller Green Check";
+    }
+    else if (eventToPrint.typeId == EVENT_CHANGE_GREEN_LEFT_EW) {
+        outStream << "Light Change to EW Left Green";
+    }
+    else if (eventToPrint.typeId == EVENT_CHANGE_YELLOW_LEFT_EW) {
+        outStream << "Light Change to EW Left Yellow";
+    }
+    else if (eventToPrint.typeId == EVENT_CHANGE_GREEN_LEFT_NS) {
+        outStream << "Light Change to NS Left Green";
+    }
+    else if (eventToPrint.typeId == EVENT_CHANGE_YELLOW_LEFT_NS) {
+        outStream << "Light Change to NS Left Yellow";
+    }
+    else if (eventToPrint.typeId >= EVENT_DEPART_FIRST &&
+             eventToPrint.typeId <= EVENT_DEPART_LAST) {
+        int laneQueueIdx = eventToPrint.typeId - EVENT_DEPART_FIRST;
+        outStream << DIRECTION_NAMES[laneQueueIdx / NUM_LANES]
+                  << "-Bound Departure ("
+                  << LANE_NAMES[laneQueueIdx % NUM_LANES] << " lane)";
+    }
     else {
         outStream << "UNKNOWN";
     }
@@ -7,11 +7,17 @@
 #include <iostream>
 #include <string>
 #include <fstream>
+#include <vector>
+#include <climits>
+#include <time.h>
 using namespace std;
 
 #include "IntersectionSimulationClass.h"
 #include "random.h"
 
+// Arrivals, turns and yellow decisions each have their own substreams
+const int NUM_STREAM_PURPOSES = 3;
+
 void IntersectionSimulationClass::readParametersFromFile(
      const string &paramFname
      )
@@ -135,9 +141,11 @@ void IntersectionSimulationClass::readParametersFromFile(
         success = false;
         cout << "ERROR: Unable to read/set percentage yellow advance" << endl;
       }
+    }
 
-      //Use the specified seed to seed the random number generator
-      setSeed(randomSeedVal);
+    if (success)
+    {
+      success = readOptionalParameters(paramF);
     }
 
     paramF.close();
@@ -154,7 +162,278 @@ void IntersectionSimulationClass::readParametersFromFile(
   {
     cout << "Parameters read in successfully - simulation is ready!" << endl;
     isSetupProperly = true;
+
+    //Use the specified seed to seed the random number generator(s)
+    seedRandomStreams();
+  }
+}
+
+bool IntersectionSimulationClass::readOptionalParameters(
+     ifstream &paramF
+     )
+{
+  bool success = true;
+  string keyword;
+
+  while (success && paramF >> keyword)
+  {
+    if (keyword == "arrivalTrace")
+    {
+      string traceFname;
+      paramF >> traceFname;
+      if (paramF.fail() ||
+          !arrivalTrace.openTraceFile(traceFname))
+      {
+        success = false;
+        cout << "ERROR: Unable to read/set arrival trace file" << endl;
+      }
+    }
+    else if (keyword == "arrivalDistribution")
+    {
+      string travelDir;
+      paramF >> travelDir;
+
+      int dirIdx = getDirectionIndex(travelDir);
+      ArrivalSamplerClass *sampler = NULL;
+      if (!paramF.fail() && dirIdx >= 0)
+      {
+        sampler = createArrivalSampler(paramF);
+      }
+      if (sampler == NULL)
+      {
+        success = false;
+        cout << "ERROR: Unable to read/set arrival distribution" << endl;
+      }
+      else
+      {
+        delete arrivalSamplers[dirIdx];
+        arrivalSamplers[dirIdx] = sampler;
+      }
+    }
+    else if (keyword == "signalController")
+    {
+      SignalControllerClass *controller = createSignalController(paramF);
+      if (controller == NULL)
+      {
+        success = false;
+        cout << "ERROR: Unable to read/set signal controller" << endl;
+      }
+      else
+      {
+        delete signalController;
+        signalController = controller;
+      }
+    }
+    else if (keyword == "saturationFlow")
+    {
+      paramF >> saturationHeadway >> startupLostTime;
+      if (paramF.fail() ||
+          saturationHeadway <= 0 ||
+          startupLostTime < 0)
+      {
+        success = false;
+        cout << "ERROR: Unable to read/set saturation flow model" << endl;
+      }
+      else
+      {
+        isSaturationFlow = true;
+      }
+    }
+    else if (keyword == "turningMovements")
+    {
+      string travelDir;
+      int leftPercent = 0;
+      int rightPercent = 0;
+      paramF >> travelDir >> leftPercent >> rightPercent;
+
+      int dirIdx = getDirectionIndex(travelDir);
+      if (paramF.fail() ||
+          dirIdx < 0 ||
+          leftPercent < 0 ||
+          rightPercent < 0 ||
+          leftPercent + rightPercent > 100)
+      {
+        success = false;
+        cout << "ERROR: Unable to read/set turning movements" << endl;
+      }
+      else
+      {
+        leftTurnPercents[dirIdx] = leftPercent;
+        rightTurnPercents[dirIdx] = rightPercent;
+      }
+    }
+    else if (keyword == "protectedLeft")
+    {
+      paramF >> leftTurnGreenTime >> leftTurnYellowTime;
+      if (paramF.fail() ||
+          leftTurnGreenTime <= 0 ||
+          leftTurnYellowTime <= 0)
+      {
+        success = false;
+        cout << "ERROR: Unable to read/set protected left turn times" << endl;
+      }
+      else
+      {
+        hasProtectedLefts = true;
+      }
+    }
+    else if (keyword == "rateProfile")
+    {
+      string travelDir;
+      int period = 0;
+      int numSegments = 0;
+      paramF >> travelDir >> period >> numSegments;
+
+      int dirIdx = getDirectionIndex(travelDir);
+      vector< double > starts;
+      vector< double > mults;
+      for (int i = 0; i < numSegments && !paramF.fail(); i++)
+      {
+        double segStart;
+        double segMult;
+        paramF >> segStart >> segMult;
+        starts.push_back(segStart);
+        mults.push_back(segMult);
+      }
+      if (paramF.fail() ||
+          dirIdx < 0 ||
+          numSegments <= 0 ||
+          !arrivalProfiles[dirIdx].setSegments(period, starts, mults))
+      {
+        success = false;
+        cout << "ERROR: Unable to read/set arrival rate profile" << endl;
+      }
+    }
+    else if (keyword == "storage")
+    {
+      string travelDir;
+      int numCars = 0;
+      string behaviorName;
+      paramF >> travelDir >> numCars >> behaviorName;
+
+      int dirIdx = getDirectionIndex(travelDir);
+      int behavior = -1;
+      for (int i = 0; i < NUM_STORAGE_BEHAVIORS; i++)
+      {
+        if (behaviorName == STORAGE_BEHAVIOR_NAMES[i])
+        {
+          behavior = i;
+        }
+      }
+      if (paramF.fail() ||
+          dirIdx < 0 ||
+          numCars <= 0 ||
+          behavior < 0)
+      {
+        success = false;
+        cout << "ERROR: Unable to read/set approach storage" << endl;
+      }
+      else
+      {
+        storageCapacities[dirIdx] = numCars;
+        storageBehaviors[dirIdx] = behavior;
+        //Any lane may end up holding every car, so each gets room for all
+        for (int laneIdx = 0; laneIdx < NUM_LANES; laneIdx++)
+        {
+          laneQueues[dirIdx * NUM_LANES + laneIdx].setCapacity(numCars,
+                                                               true);
+        }
+      }
+    }
+    else if (keyword == "randomStreams")
+    {
+      isUsingSubstreams = true;
+    }
+    else if (keyword == "antithetic")
+    {
+      isAntithetic = true;
+    }
+    else if (keyword == "asyncLog")
+    {
+      setIsLogAsync(true);
+    }
+    else if (keyword == "traceRecords")
+    {
+      string outFname;
+      paramF >> outFname;
+      if (paramF.fail() ||
+          !traceRecorder.setup(outFname))
+      {
+        success = false;
+        cout << "ERROR: Unable to read/set trace records" << endl;
+      }
+      else
+      {
+        setIsTraceDeferred(true);
+      }
+    }
+    else if (keyword == "warmup")
+    {
+      int checkEvents = 0;
+      paramF >> checkEvents;
+      if (paramF.fail() ||
+          !warmupDetector.setup(checkEvents))
+      {
+        success = false;
+        cout << "ERROR: Unable to read/set warm-up detection" << endl;
+      }
+    }
+    else if (keyword == "convergence")
+    {
+      int checkEvents = 0;
+      double precision = 0;
+      paramF >> checkEvents >> precision;
+      if (paramF.fail() ||
+          !convergenceMonitor.setup(checkEvents, precision))
+      {
+        success = false;
+        cout << "ERROR: Unable to read/set convergence stopping" << endl;
+      }
+    }
+    else if (keyword == "timeSeries")
+    {
+      int interval = 0;
+      int decimation = 0;
+      string outFname;
+      paramF >> interval >> decimation >> outFname;
+      if (paramF.fail() ||
+          !timeSeriesSampler.setup(interval, decimation, outFname))
+      {
+        success = false;
+        cout << "ERROR: Unable to read/set time series sampling" << endl;
+      }
+    }
+    else
+    {
+      success = false;
+      cout << "ERROR: Unknown optional parameter: " << keyword << endl;
+    }
+  }
+
+  return success;
+}
+
+int IntersectionSimulationClass::getDirectionIndex(
+     const string &travelDir
+     ) const
+{
+  if (travelDir == EAST_DIRECTION)
+  {
+    return DIRECTION_EAST;
+  }
+  else if (travelDir == WEST_DIRECTION)
+  {
+    return DIRECTION_WEST;
+  }
+  else if (travelDir == NORTH_DIRECTION)
+  {
+    return DIRECTION_NORTH;
+  }
+  else if (travelDir == SOUTH_DIRECTION)
+  {
+    return DIRECTION_SOUTH;
   }
+  return -1;
 }
 
 void IntersectionSimulationClass::printParameters() const
@@ -188,82 +467,513 @@ void IntersectionSimulationClass::printParameters() const
             " StdDev: " << northArrivalStdDev << endl;
     cout << "    South - Mean: " << southArrivalMean << 
             " StdDev: " << southArrivalStdDev << endl;
+    for (int i = 0; i < NUM_DIRECTIONS; i++)
+    {
+      if (arrivalSamplers[i] != NULL)
+      {
+        cout << "    " << DIRECTION_NAMES[i] << " Overridden By - ";
+        arrivalSamplers[i]->print(cout);
+        cout << endl;
+      }
+      if (arrivalProfiles[i].getIsActive())
+      {
+        cout << "    " << DIRECTION_NAMES[i] << " Rate Profile - ";
+        arrivalProfiles[i].print(cout);
+        cout << endl;
+      }
+    }
+    if (arrivalTrace.getIsOpen())
+    {
+      cout << "  Arrivals replayed from trace: " <<
+              arrivalTrace.getTraceFname() << endl;
+    }
 
     cout << "  Percentage cars advancing through yellow: " <<
             percentCarsAdvanceOnYellow << endl;
+    for (int i = 0; i < NUM_DIRECTIONS; i++)
+    {
+      if (leftTurnPercents[i] + rightTurnPercents[i] > 0)
+      {
+        cout << "  " << DIRECTION_NAMES[i] << " Turning - Left: " <<
+                leftTurnPercents[i] << "% Right: " << rightTurnPercents[i] <<
+                "%" << endl;
+      }
+    }
+    if (hasProtectedLefts)
+    {
+      cout << "  Protected Left Turns - Green: " << leftTurnGreenTime <<
+              " Yellow: " << leftTurnYellowTime << endl;
+    }
+    if (isSaturationFlow)
+    {
+      cout << "  Saturation flow - Headway: " << saturationHeadway <<
+              " Start-up lost time: " << startupLostTime << endl;
+    }
+    for (int i = 0; i < NUM_DIRECTIONS; i++)
+    {
+      if (storageCapacities[i] > 0)
+      {
+        cout << "  " << DIRECTION_NAMES[i] << " Storage - Cars: " <<
+                storageCapacities[i] << " When full: " <<
+                STORAGE_BEHAVIOR_NAMES[storageBehaviors[i]] << endl;
+      }
+    }
+    if (signalController != NULL)
+    {
+      cout << "  Signal controller: ";
+      signalController->print(cout);
+      cout << endl;
+    }
+    if (isUsingSubstreams || isAntithetic)
+    {
+      cout << "  Random draws -" <<
+              (isUsingSubstreams ? " Separate substreams" : "") <<
+              (isAntithetic ? " Antithetic" : "") << endl;
+    }
+    if (warmupDetector.getIsEnabled())
+    {
+      cout << "  Warm-up truncation - ";
+      warmupDetector.print(cout);
+      cout << endl;
+    }
+    if (convergenceMonitor.getIsEnabled())
+    {
+      cout << "  Stop on convergence - ";
+      convergenceMonitor.print(cout);
+      cout << endl;
+    }
+    if (timeSeriesSampler.getIsEnabled())
+    {
+      cout << "  Time series - ";
+      timeSeriesSampler.print(cout);
+      cout << endl;
+    }
+    if (isTraceDeferred)
+    {
+      cout << "  Trace records - ";
+      traceRecorder.print(cout);
+      cout << endl;
+    }
+    if (isLogAsync)
+    {
+      cout << "  Event log - Written by a background thread" << endl;
+    }
   }
   cout << "===== End Simulation Parameters =====" << endl;
 }
 
+void IntersectionSimulationClass::getParameters(
+    SimulationParamsStruct &outParams) const {
+    outParams.randomSeedVal = randomSeedVal;
+    outParams.timeToStopSim = timeToStopSim;
+    outParams.eastWestGreenTime = eastWestGreenTime;
+    outParams.eastWestYellowTime = eastWestYellowTime;
+    outParams.northSouthGreenTime = northSouthGreenTime;
+    outParams.northSouthYellowTime = northSouthYellowTime;
+    outParams.arrivalMeans[DIRECTION_EAST] = eastArrivalMean;
+    outParams.arrivalStdDevs[DIRECTION_EAST] = eastArrivalStdDev;
+    outParams.arrivalMeans[DIRECTION_WEST] = westArrivalMean;
+    outParams.arrivalStdDevs[DIRECTION_WEST] = westArrivalStdDev;
+    outParams.arrivalMeans[DIRECTION_NORTH] = northArrivalMean;
+    outParams.arrivalStdDevs[DIRECTION_NORTH] = northArrivalStdDev;
+    outParams.arrivalMeans[DIRECTION_SOUTH] = southArrivalMean;
+    outParams.arrivalStdDevs[DIRECTION_SOUTH] = southArrivalStdDev;
+    outParams.percentCarsAdvanceOnYellow = percentCarsAdvanceOnYellow;
+}
+
+bool IntersectionSimulationClass::getUsesOptionalModelParameters() const {
+    bool usesOptional = arrivalTrace.getIsOpen() ||
+                        signalController != NULL || isSaturationFlow ||
+                        hasProtectedLefts ||
+                        convergenceMonitor.getIsEnabled() ||
+                        warmupDetector.getIsEnabled() ||
+                        timeSeriesSampler.getIsEnabled();
+
+    for (int i = 0; i < NUM_DIRECTIONS; i++) {
+        usesOptional = usesOptional || arrivalSamplers[i] != NULL ||
+                       arrivalProfiles[i].getIsActive() ||
+                       leftTurnPercents[i] + rightTurnPercents[i] > 0 ||
+                       storageCapacities[i] > 0;
+    }
+    return usesOptional;
+}
+
+bool IntersectionSimulationClass::setParameters(
+    const SimulationParamsStruct &inParams) {
+    if (getSimulationParamsError(inParams) != NULL) {
+        isSetupProperly = false;
+        return false;
+    }
+
+    randomSeedVal = inParams.randomSeedVal;
+    timeToStopSim = inParams.timeToStopSim;
+    eastWestGreenTime = inParams.eastWestGreenTime;
+    eastWestYellowTime = inParams.eastWestYellowTime;
+    northSouthGreenTime = inParams.northSouthGreenTime;
+    northSouthYellowTime = inParams.northSouthYellowTime;
+    eastArrivalMean = inParams.arrivalMeans[DIRECTION_EAST];
+    eastArrivalStdDev = inParams.arrivalStdDevs[DIRECTION_EAST];
+    westArrivalMean = inParams.arrivalMeans[DIRECTION_WEST];
+    westArrivalStdDev = inParams.arrivalStdDevs[DIRECTION_WEST];
+    northArrivalMean = inParams.arrivalMeans[DIRECTION_NORTH];
+    northArrivalStdDev = inParams.arrivalStdDevs[DIRECTION_NORTH];
+    southArrivalMean = inParams.arrivalMeans[DIRECTION_SOUTH];
+    southArrivalStdDev = inParams.arrivalStdDevs[DIRECTION_SOUTH];
+    percentCarsAdvanceOnYellow = inParams.percentCarsAdvanceOnYellow;
+    isSetupProperly = true;
+
+    restart();
+    return true;
+}
+
+void IntersectionSimulationClass::restart() {
+    isStarted = false;
+    currentTime = 0;
+    numEventsHandled = 0;
+    currentLight = LIGHT_GREEN_EW;
+    phaseStartTime = 0;
+    eventList.clear();
+    arrivalTrace.rewind();
+    convergenceMonitor.restart();
+    warmupDetector.restart();
+    timeSeriesSampler.restart();
+    traceRecorder.restart();
+
+    numControllerDecisions = 0;
+    controllerDecisionNanos = 0;
+    for (int i = 0; i < NUM_DIRECTIONS; i++) {
+        arrivalProfiles[i].restart();
+        lastArrivalTimes[i] = NO_ARRIVAL_TIME;
+        maxQueueLengths[i] = 0;
+        numHeldCars[i] = 0;
+        heldChangeTimes[i] = 0;
+        numDivertedCars[i] = 0;
+        numEverHeldCars[i] = 0;
+        maxHeldCars[i] = 0;
+        heldCarTics[i] = 0;
+    }
+    totalDelayTics = 0;
+    numDelayedCars = 0;
+    for (int i = 0; i < NUM_LANE_QUEUES; i++) {
+        laneQueues[i].clear();
+        isDeparturePending[i] = false;
+        isStoppedOnYellow[i] = false;
+        numTotalAdvanced[i] = 0;
+    }
+
+    if (isSetupProperly) {
+        seedRandomStreams();
+    }
+}
+
+void IntersectionSimulationClass::setRandomStreams(
+    const bool inIsUsingSubstreams, const bool inIsAntithetic) {
+    isUsingSubstreams = inIsUsingSubstreams;
+    isAntithetic = inIsAntithetic;
+    restart();
+}
+
+void IntersectionSimulationClass::seedRandomStreams() {
+    RandomStreamClass::seedSharedGenerator(randomSeedVal);
+    for (int i = 0; i < NUM_DIRECTIONS; i++) {
+        if (!isUsingSubstreams) {
+            arrivalStreams[i].useSharedGenerator();
+            turnStreams[i].useSharedGenerator();
+            yellowStreams[i].useSharedGenerator();
+        }
+        arrivalStreams[i].setIsAntithetic(isAntithetic);
+        turnStreams[i].setIsAntithetic(isAntithetic);
+        yellowStreams[i].setIsAntithetic(isAntithetic);
+    }
+    reseedSubstreams(0);
+}
+
+void IntersectionSimulationClass::reseedSubstreams(const int trajectoryNum) {
+    if (!isUsingSubstreams) {
+        return;
+    }
+    // Every trajectory, purpose and direction gets a different substream id
+    const int firstId = trajectoryNum * NUM_STREAM_PURPOSES * NUM_DIRECTIONS;
+    for (int i = 0; i < NUM_DIRECTIONS; i++) {
+        arrivalStreams[i].seedSubstream(randomSeedVal, firstId + i);
+        turnStreams[i].seedSubstream(randomSeedVal,
+                                     firstId + NUM_DIRECTIONS + i);
+        yellowStreams[i].seedSubstream(randomSeedVal,
+                                       firstId + 2 * NUM_DIRECTIONS + i);
+    }
+}
+
+bool IntersectionSimulationClass::getNextEventTime(int &outTime) const {
+    EventClass nextEvent;
+
+    if (!getNextEvent(nextEvent)) {
+        return false;
+    }
+    outTime = nextEvent.getTimeOccurs();
+    return true;
+}
+
+bool IntersectionSimulationClass::runUntil(const int stopTime) {
+    // Only the time of the limit matters when comparing events
+    const EventClass lastEvent(min(stopTime, timeToStopSim), EVENT_UNKNOWN);
+    int nextTime = 0;
+
+    if (!isStarted) {
+        scheduleSeedEvents();
+    }
+    (this->*getKernel().runEvents)(lastEvent, INT_MAX);
+    if (!getNextEventTime(nextTime) || nextTime > timeToStopSim) {
+        finishRun();
+        return false;
+    }
+    return true;
+}
+
+int IntersectionSimulationClass::runEvents(const int numEvents) {
+    const EventClass lastEvent(timeToStopSim, EVENT_UNKNOWN);
+
+    if (!isStarted) {
+        scheduleSeedEvents();
+    }
+    const int numHandled = (this->*getKernel().runEvents)(lastEvent,
+                                                          numEvents);
+    if (numHandled < numEvents) {
+        finishRun();
+    }
+    return numHandled;
+}
+
+bool IntersectionSimulationClass::runUntilQueueLength(const int dirIdx,
+                                                      const int queueLength) {
+    const EventClass lastEvent(timeToStopSim, EVENT_UNKNOWN);
+    EventClass currentEvent;
+    const int firstDirIdx = (dirIdx < 0) ? 0 : dirIdx;
+    const int lastDirIdx = (dirIdx < 0) ? NUM_DIRECTIONS - 1 : dirIdx;
+    const KernelStruct &kernel = getKernel();
+
+    if (!isStarted) {
+        scheduleSeedEvents();
+    }
+    while (true) {
+        // The longest queues only grow one car at a time, on arrivals, so
+        // checking after every event catches the exact crossing
+        for (int i = firstDirIdx; i <= lastDirIdx; i++) {
+            if (maxQueueLengths[i] >= queueLength) {
+                return true;
+            }
+        }
+        if (!eventList.removeFrontIfNotAfter(lastEvent, currentEvent)) {
+            finishRun();
+            return false;
+        }
+        (this->*kernel.handleEvent)(currentEvent);
+    }
+}
+
+void IntersectionSimulationClass::saveState(
+    SimulationSnapshotStruct &outState) const {
+    saveStateWithoutQueues(outState);
+    for (int i = 0; i < NUM_LANE_QUEUES; i++) {
+        outState.laneQueues[i] = laneQueues[i];
+    }
+}
+
+void IntersectionSimulationClass::saveStateWithoutQueues(
+    SimulationSnapshotStruct &outState) const {
+    outState.isStarted = isStarted;
+    outState.currentTime = currentTime;
+    outState.currentLight = currentLight;
+    outState.phaseStartTime = phaseStartTime;
+    outState.eventList = eventList;
+    outState.convergenceMonitor = convergenceMonitor;
+    outState.warmupDetector = warmupDetector;
+    outState.numEventsHandled = numEventsHandled;
+    outState.numControllerDecisions = numControllerDecisions;
+    outState.controllerDecisionNanos = controllerDecisionNanos;
+    outState.numSharedDraws = RandomStreamClass::getNumSharedDraws();
+    outState.nextCarId = CarClass::getNextId();
+    for (int i = 0; i < NUM_DIRECTIONS; i++) {
+        outState.lastArrivalTimes[i] = lastArrivalTimes[i];
+        outState.arrivalProfiles[i] = arrivalProfiles[i];
+        outState.arrivalStreams[i] = arrivalStreams[i];
+        outState.turnStreams[i] = turnStreams[i];
+        outState.yellowStreams[i] = yellowStreams[i];
+        outState.maxQueueLengths[i] = maxQueueLengths[i];
+        outState.numHeldCars[i] = numHeldCars[i];
+        outState.heldChangeTimes[i] = heldChangeTimes[i];
+        outState.numDivertedCars[i] = numDivertedCars[i];
+        outState.numEverHeldCars[i] = numEverHeldCars[i];
+        outState.maxHeldCars[i] = maxHeldCars[i];
+        outState.heldCarTics[i] = heldCarTics[i];
+    }
+    outState.totalDelayTics = totalDelayTics;
+    outState.numDelayedCars = numDelayedCars;
+    for (int i = 0; i < NUM_LANE_QUEUES; i++) {
+        outState.isDeparturePending[i] = isDeparturePending[i];
+        outState.isStoppedOnYellow[i] = isStoppedOnYellow[i];
+        outState.numTotalAdvanced[i] = numTotalAdvanced[i];
+    }
+}
+
+void IntersectionSimulationClass::restoreState(
+    const SimulationSnapshotStruct &inState) {
+    isStarted = inState.isStarted;
+    currentTime = inState.currentTime;
+    currentLight = inState.currentLight;
+    phaseStartTime = inState.phaseStartTime;
+    eventList = inState.eventList;
+    convergenceMonitor = inState.convergenceMonitor;
+    warmupDetector = inState.warmupDetector;
+    numEventsHandled = inState.numEventsHandled;
+    numControllerDecisions = inState.numControllerDecisions;
+    controllerDecisionNanos = inState.controllerDecisionNanos;
+    if (!isUsingSubstreams) {
+        RandomStreamClass::seekSharedGenerator(randomSeedVal,
+                                               inState.numSharedDraws);
+    }
+    CarClass::setNextId(inState.nextCarId);
+    for (int i = 0; i < NUM_DIRECTIONS; i++) {
+        lastArrivalTimes[i] = inState.lastArrivalTimes[i];
+        arrivalProfiles[i] = inState.arrivalProfiles[i];
+        arrivalStreams[i] = inState.arrivalStreams[i];
+        turnStreams[i] = inState.turnStreams[i];
+        yellowStreams[i] = inState.yellowStreams[i];
+        maxQueueLengths[i] = inState.maxQueueLengths[i];
+        numHeldCars[i] = inState.numHeldCars[i];
+        heldChangeTimes[i] = inState.heldChangeTimes[i];
+        numDivertedCars[i] = inState.numDivertedCars[i];
+        numEverHeldCars[i] = inState.numEverHeldCars[i];
+        maxHeldCars[i] = inState.maxHeldCars[i];
+        heldCarTics[i] = inState.heldCarTics[i];
+    }
+    totalDelayTics = inState.totalDelayTics;
+    numDelayedCars = inState.numDelayedCars;
+    for (int i = 0; i < NUM_LANE_QUEUES; i++) {
+        isDeparturePending[i] = inState.isDeparturePending[i];
+        isStoppedOnYellow[i] = inState.isStoppedOnYellow[i];
+        laneQueues[i] = inState.laneQueues[i];
+        numTotalAdvanced[i] = inState.numTotalAdvanced[i];
+    }
+}
+
+void IntersectionSimulationClass::getStatistics(
+    SimulationStatsStruct &outStats) const {
+    for (int i = 0; i < NUM_DIRECTIONS; i++) {
+        outStats.maxQueueLengths[i] = maxQueueLengths[i];
+        outStats.numTotalAdvanced[i] =
+            numTotalAdvanced[i * NUM_LANES + LANE_THROUGH] +
+            numTotalAdvanced[i * NUM_LANES + LANE_LEFT] +
+            numTotalAdvanced[i * NUM_LANES + LANE_RIGHT];
+    }
+}
+
 void IntersectionSimulationClass::scheduleArrival(const string &travelDir) {
+    int dirIdx = getDirectionIndex(travelDir);
+
+    if (dirIdx < 0) {
+        if (isLogging) {
+            narrate(TRACE_INVALID_DIRECTION);
+        }
+        return;
+    }
+    (this->*getKernel().scheduleArrival)(dirIdx);
+}
+
+template <class PolicyT>
+void IntersectionSimulationClass::scheduleArrival(const int dirIdx) {
     int arrivalMean = 0;
     int arrivalStdDev = 0;
-    int eventType = 0;
 
     // Determine parameters based on travel direction
-    if (travelDir == EAST_DIRECTION) {
+    if (dirIdx == DIRECTION_EAST) {
         arrivalMean = eastArrivalMean;
         arrivalStdDev = eastArrivalStdDev;
-        eventType = EVENT_ARRIVE_EAST;
     }
-    else if (travelDir == WEST_DIRECTION) {
+    else if (dirIdx == DIRECTION_WEST) {
         arrivalMean = westArrivalMean;
         arrivalStdDev = westArrivalStdDev;
-        eventType = EVENT_ARRIVE_WEST;
     }
-    else if (travelDir == NORTH_DIRECTION) {
+    else if (dirIdx == DIRECTION_NORTH) {
         arrivalMean = northArrivalMean;
         arrivalStdDev = northArrivalStdDev;
-        eventType = EVENT_ARRIVE_NORTH;
     }
-    else if (travelDir == SOUTH_DIRECTION) {
+    else {
         arrivalMean = southArrivalMean;
         arrivalStdDev = southArrivalStdDev;
-        eventType = EVENT_ARRIVE_SOUTH;
+    }
+
+    // Compute event time, either from the recorded trace or by drawing
+    // from this direction's arrival distribution
+    int eventTime = 0;
+    if (arrivalTrace.getIsOpen()) {
+        if (!arrivalTrace.getNextArrivalTime(dirIdx, eventTime)) {
+            if (PolicyT::HAS_LOGGING && isLogging) {
+                narrate(TRACE_TRACE_ENDED, currentTime, dirIdx);
+            }
+            return;
+        }
+        // A trace is expected to be sorted, but never schedule into the past
+        eventTime = max(eventTime, currentTime);
     }
     else {
-        cout << "Error: Invalid travel direction!" << endl;
-        return;
+        double arrivalGap = 0;
+        if (arrivalSamplers[dirIdx] != NULL) {
+            arrivalGap = arrivalSamplers[dirIdx]->sample(
+                arrivalStreams[dirIdx]);
+        }
+        else {
+            arrivalGap = arrivalStreams[dirIdx].getPositiveNormal(
+                arrivalMean, arrivalStdDev);
+        }
+        // The profile keeps this direction's clock, so fractional gaps
+        // accumulate rather than being truncated away one at a time
+        if (!arrivalProfiles[dirIdx].advanceArrival(arrivalGap, eventTime)) {
+            if (PolicyT::HAS_LOGGING && isLogging) {
+                narrate(arrivalProfiles[dirIdx].getIsPastLastTime() ?
+                        TRACE_PAST_LAST_TIME : TRACE_RATE_ZERO,
+                        currentTime, dirIdx);
+            }
+            return;
+        }
     }
 
-    // Compute arrival time and event time
-    int arrivalTime = getPositiveNormal(arrivalMean, arrivalStdDev);
-    int eventTime = currentTime + arrivalTime;
-
-    // Create and insert event
-    EventClass singleEvent(eventTime, eventType);
+    // Create and insert event; arrival event types are in the same order
+    // as the directions
+    EventClass singleEvent(eventTime, EVENT_ARRIVE_EAST + dirIdx);
     eventList.insertValue(singleEvent);
 
     // Output the scheduled event
-    cout << "Time: " << currentTime 
-         << " Scheduled " << singleEvent << endl;
+    if (PolicyT::HAS_LOGGING && isLogging) {
+        narrate(TRACE_SCHEDULED, currentTime, singleEvent.getType(),
+                singleEvent.getTimeOccurs());
+    }
+}
+
+void IntersectionSimulationClass::scheduleLightChange() {
+    (this->*getKernel().scheduleLightChange)();
 }
 
+template <class PolicyT>
 void IntersectionSimulationClass::scheduleLightChange() {
     int eventTime = 0;
     int nextEventType = 0;
     int duration = 0;
 
     // Determine next event type and duration based on the current light
-    if (currentLight == LIGHT_GREEN_EW) {
-        nextEventType = EVENT_CHANGE_YELLOW_EW;
-        duration = eastWestGreenTime;
-    }
-    else if (currentLight == LIGHT_YELLOW_EW) {
-        nextEventType = EVENT_CHANGE_GREEN_NS;
-        duration = eastWestYellowTime;
-    }
-    else if (currentLight == LIGHT_GREEN_NS) {
-        nextEventType = EVENT_CHANGE_YELLOW_NS;
-        duration = northSouthGreenTime;
+    if (currentLight < LIGHT_GREEN_EW || currentLight > LIGHT_YELLOW_LEFT_NS) {
+        if (PolicyT::HAS_LOGGING && isLogging) {
+            narrate(TRACE_INVALID_LIGHT);
+        }
+        return;
     }
-    else if (currentLight == LIGHT_YELLOW_NS) {
-        nextEventType = EVENT_CHANGE_GREEN_EW;
-        duration = northSouthYellowTime;
+    if (PolicyT::HAS_CONTROLLER && signalController != NULL &&
+        (currentLight == LIGHT_GREEN_EW || currentLight == LIGHT_GREEN_NS)) {
+        nextEventType = EVENT_CHECK_GREEN;
+        duration = consultSignalController(true);
     }
     else {
-        cout << "Error: Invalid light state!" << endl;
-        return;
+        nextEventType = LIGHT_CHANGE_EVENTS[getNextLight(currentLight)];
+        duration = getLightDuration(currentLight);
     }
 
     // Compute event time
@@ -274,300 +984,792 @@ void IntersectionSimulationClass::scheduleLightChange() {
     eventList.insertValue(singleEvent);
 
     // Output the scheduled event
-    cout << "Time: " << currentTime 
-         << " Scheduled " << singleEvent << endl;
+    if (PolicyT::HAS_LOGGING && isLogging) {
+        narrate(TRACE_SCHEDULED, currentTime, singleEvent.getType(),
+                singleEvent.getTimeOccurs());
+    }
 }
 
-// Handle next event
-bool IntersectionSimulationClass::handleNextEvent() {
-    EventClass currentEvent;
+int IntersectionSimulationClass::consultSignalController(
+    const bool isPhaseStart) {
+    int queueLengths[NUM_DIRECTIONS];
+    int ticsSinceArrival[NUM_DIRECTIONS];
+    timespec startStamp;
+    timespec endStamp;
+    int answer = 0;
 
-    // Retrieve the next event
-    if (!eventList.removeFront(currentEvent)) {
-        cout << "No events to handle. Simulation complete." << endl;
-        return false;
+    for (int i = 0; i < NUM_DIRECTIONS; i++) {
+        queueLengths[i] = getApproachQueueLength(i);
+        // Without departure events the green queues only drain when the
+        // light changes, one car per tic, so discount the cars already
+        // served by the green time so far
+        if (!isSaturationFlow &&
+            getLaneSignal(i * NUM_LANES + LANE_THROUGH, currentLight) ==
+            LANE_SIGNAL_GREEN) {
+            queueLengths[i] = max(0, queueLengths[i] -
+                                     (currentTime - phaseStartTime));
+        }
+        ticsSinceArrival[i] = (lastArrivalTimes[i] == NO_ARRIVAL_TIME) ?
+                              INT_MAX : currentTime - lastArrivalTimes[i];
     }
 
-    // Advance the simulation time
-    currentTime = currentEvent.getTimeOccurs();
+    clock_gettime(CLOCK_MONOTONIC, &startStamp);
+    if (isPhaseStart) {
+        answer = signalController->getGreenTime(currentLight, queueLengths);
+    }
+    else {
+        answer = signalController->getGreenExtension(
+            currentLight, currentTime - phaseStartTime, queueLengths,
+            ticsSinceArrival);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &endStamp);
 
-    // Check if the event occurs after the simulation end time
-    if (currentTime > timeToStopSim) {
-        cout << "Next event occurs AFTER the simulation end time "
-             << "(" << currentEvent << ")!" << endl;
-        return false;
+    numControllerDecisions++;
+    controllerDecisionNanos += (endStamp.tv_sec - startStamp.tv_sec) * 1e9 +
+                               (endStamp.tv_nsec - startStamp.tv_nsec);
+    return answer;
+}
+
+void IntersectionSimulationClass::truncateWarmup() {
+    for (int i = 0; i < NUM_LANE_QUEUES; i++) {
+        numTotalAdvanced[i] -= warmupDetector.getAdvancedAtWarmupEnd(i);
     }
-    cout << endl;
-    cout << "Handling " << currentEvent << endl;
-
-    // Handle events for when cars arrive
-    switch (currentEvent.getType()) {
-        case EVENT_ARRIVE_EAST: {
-            CarClass carArrival(EAST_DIRECTION, currentTime);
-            eastQueue.enqueue(carArrival);
-            cout << "Time: " << currentTime << " Car #" << carArrival.getId()
-                 << " arrives east-bound - queue length: "
-                 << eastQueue.getNumElems() << endl;
-
-            scheduleArrival(EAST_DIRECTION);
-            maxEastQueueLength = max(maxEastQueueLength, 
-                                     eastQueue.getNumElems());
-            break;
-        }
-        case EVENT_ARRIVE_WEST: {
-            CarClass carArrival(WEST_DIRECTION, currentTime);
-            westQueue.enqueue(carArrival);
-            cout << "Time: " << currentTime << " Car #" << carArrival.getId()
-                 << " arrives west-bound - queue length: "
-                 << westQueue.getNumElems() << endl;
-
-            scheduleArrival(WEST_DIRECTION);
-            maxWestQueueLength = max(maxWestQueueLength, 
-                                     westQueue.getNumElems());
-            break;
-        }
-        case EVENT_ARRIVE_NORTH: {
-            CarClass carArrival(NORTH_DIRECTION, currentTime);
-            northQueue.enqueue(carArrival);
-            cout << "Time: " << currentTime << " Car #" << carArrival.getId()
-                 << " arrives north-bound - queue length: "
-                 << northQueue.getNumElems() << endl;
-
-            scheduleArrival(NORTH_DIRECTION);
-            maxNorthQueueLength = max(maxNorthQueueLength, 
-                                       northQueue.getNumElems());
-            break;
-        }
-        case EVENT_ARRIVE_SOUTH: {
-            CarClass carArrival(SOUTH_DIRECTION, currentTime);
-            southQueue.enqueue(carArrival);
-            cout << "Time: " << currentTime << " Car #" << carArrival.getId()
-                 << " arrives south-bound - queue length: "
-                 << southQueue.getNumElems() << endl;
-
-            scheduleArrival(SOUTH_DIRECTION);
-            maxSouthQueueLength = max(maxSouthQueueLength, 
-                                       southQueue.getNumElems());
-            break;
-        }
-        // Handle events for light change
-        case EVENT_CHANGE_YELLOW_EW: {
-            cout << "Advancing cars on east-west green" << endl;
-
-            int carsEast = 0, carsWest = 0;
-            while (eastQueue.getNumElems() > NO_QUEUE && 
-                   carsEast < eastWestGreenTime) {
-                CarClass car;
-                eastQueue.dequeue(car);
-                carsEast++;
-                cout << "  Car #" << car.getId() 
-                     << " advances east-bound" << endl;
-            }
-            while (westQueue.getNumElems() > NO_QUEUE && 
-                   carsWest < eastWestGreenTime) {
-                CarClass car;
-                westQueue.dequeue(car);
-                carsWest++;
-                cout << "  Car #" << car.getId() 
-                     << " advances west-bound" << endl;
-            }
+    for (int i = 0; i < NUM_DIRECTIONS; i++) {
+        maxQueueLengths[i] = warmupDetector.getMaxQueueSinceWarmup(i);
+    }
+    // Delays aren't kept per car, so they are counted from here instead
+    totalDelayTics = 0;
+    numDelayedCars = 0;
+    // Convergence is only judged on the steady state from here on
+    if (convergenceMonitor.getIsEnabled()) {
+        convergenceMonitor.restartAt(currentTime, getTotalAdvanced());
+    }
+    if (isLogging) {
+        narrate(TRACE_WARMUP_ENDED, warmupDetector.getWarmupEndTime());
+    }
+}
 
-            cout << "East-bound cars advanced on green: " 
-                 << carsEast
-                 << " Remaining queue: " << eastQueue.getNumElems() << endl;
-            cout << "West-bound cars advanced on green: " 
-                 << carsWest
-                 << " Remaining queue: " << westQueue.getNumElems() << endl;
-
-            numTotalAdvancedEast += carsEast;
-            numTotalAdvancedWest += carsWest;
-
-            currentLight = LIGHT_YELLOW_EW;
-            scheduleLightChange();
-            break;
-        }
-        // Handle events for light change
-        case EVENT_CHANGE_YELLOW_NS: {
-            cout << "Advancing cars on north-south green" << endl;
-
-            int carsNorth = 0, carsSouth = 0;
-            while (northQueue.getNumElems() > NO_QUEUE && 
-                   carsNorth < northSouthGreenTime) {
-                CarClass car;
-                northQueue.dequeue(car);
-                carsNorth++;
-                cout << "  Car #" << car.getId() 
-                     << " advances north-bound" << endl;
-            }
-            while (southQueue.getNumElems() > NO_QUEUE && 
-                   carsSouth < northSouthGreenTime) {
-                CarClass car;
-                southQueue.dequeue(car);
-                carsSouth++;
-                cout << "  Car #" << car.getId() 
-                     << " advances south-bound" << endl;
-            }
+int IntersectionSimulationClass::getTotalQueueLength() const {
+    int totalLength = 0;
+
+    for (int i = 0; i < NUM_LANE_QUEUES; i++) {
+        totalLength += laneQueues[i].getNumElems();
+    }
+    return totalLength;
+}
+
+int IntersectionSimulationClass::getTotalAdvanced() const {
+    int totalAdvanced = 0;
+
+    for (int i = 0; i < NUM_LANE_QUEUES; i++) {
+        totalAdvanced += numTotalAdvanced[i];
+    }
+    return totalAdvanced;
+}
+
+int IntersectionSimulationClass::getApproachQueueLength(
+    const int dirIdx) const {
+    const RingQueueClass< CarClass > *approachLanes =
+        &laneQueues[dirIdx * NUM_LANES];
+    return approachLanes[LANE_THROUGH].getNumElems() +
+           approachLanes[LANE_LEFT].getNumElems() +
+           approachLanes[LANE_RIGHT].getNumElems();
+}
+
+void IntersectionSimulationClass::setLogStream(ostream *outStream) {
+    flushLog();
+    logTarget = (outStream == NULL) ? NULL : outStream->rdbuf();
+    applyLogTarget();
+}
+
+void IntersectionSimulationClass::setIsLogAsync(const bool inIsLogAsync) {
+    flushLog();
+    isLogAsync = inIsLogAsync;
+    applyLogTarget();
+}
+
+void IntersectionSimulationClass::setIsTraceDeferred(
+    const bool inIsTraceDeferred) {
+    isTraceDeferred = inIsTraceDeferred;
+    applyLogTarget();
+}
+
+void IntersectionSimulationClass::applyLogTarget() {
+    isLogging = (logTarget != NULL || isTraceDeferred);
+    if (isLogAsync && logTarget != NULL &&
+        asyncLogBuffer.setTarget(logTarget)) {
+        eventLog.rdbuf(&asyncLogBuffer);
+        return;
+    }
+    // Without a writer thread, the narration is written as it is made
+    asyncLogBuffer.setTarget(NULL);
+    eventLog.rdbuf(logTarget);
+}
+
+void IntersectionSimulationClass::sampleTimeSeries(const int eventTime) {
+    int queueLengths[NUM_DIRECTIONS];
 
-            cout << "North-bound cars advanced on green: " 
-                 << carsNorth
-                 << " Remaining queue: " << northQueue.getNumElems() << endl;
-            cout << "South-bound cars advanced on green: " 
-                 << carsSouth
-                 << " Remaining queue: " << southQueue.getNumElems() << endl;
+    for (int i = 0; i < NUM_DIRECTIONS; i++) {
+        queueLengths[i] = getApproachQueueLength(i);
+    }
+    timeSeriesSampler.addSamplesBefore(eventTime, currentLight, queueLengths);
+}
+
+void IntersectionSimulationClass::finishRun() {
+    int queueLengths[NUM_DIRECTIONS];
+
+    flushLog();
+    traceRecorder.finishRun();
+    if (!timeSeriesSampler.getIsEnabled()) {
+        return;
+    }
+    for (int i = 0; i < NUM_DIRECTIONS; i++) {
+        queueLengths[i] = getApproachQueueLength(i);
+    }
+    // A converged run ends at the time it converged
+    timeSeriesSampler.finishRun(convergenceMonitor.getIsConverged() ?
+                                currentTime : timeToStopSim,
+                                currentLight, queueLengths);
+}
 
-            numTotalAdvancedNorth += carsNorth;
-            numTotalAdvancedSouth += carsSouth;
+int IntersectionSimulationClass::getLaneSignal(const int laneQueueIdx,
+                                               const int light) const {
+    const int dirIdx = laneQueueIdx / NUM_LANES;
+    const int laneIdx = laneQueueIdx % NUM_LANES;
+    const bool isEastWest = (dirIdx == DIRECTION_EAST ||
+                             dirIdx == DIRECTION_WEST);
+    const int greenLight = isEastWest ? LIGHT_GREEN_EW : LIGHT_GREEN_NS;
+    const int leftGreenLight = isEastWest ? LIGHT_GREEN_LEFT_EW :
+                                            LIGHT_GREEN_LEFT_NS;
 
-            currentLight = LIGHT_YELLOW_NS;
-            scheduleLightChange();
-            break;
+    // Each yellow state immediately follows its green state
+    if (light == greenLight) {
+        return (laneIdx == LANE_LEFT) ? LANE_SIGNAL_PERMITTED :
+                                        LANE_SIGNAL_GREEN;
+    }
+    else if (light == greenLight + 1) {
+        return LANE_SIGNAL_YELLOW;
+    }
+    else if (light == leftGreenLight && laneIdx == LANE_LEFT) {
+        return LANE_SIGNAL_GREEN;
+    }
+    else if (light == leftGreenLight + 1 && laneIdx == LANE_LEFT) {
+        return LANE_SIGNAL_YELLOW;
+    }
+    return LANE_SIGNAL_RED;
+}
+
+int IntersectionSimulationClass::getLightForChangeEvent(
+    const int eventType) const {
+    for (int light = LIGHT_GREEN_EW; light <= LIGHT_YELLOW_LEFT_NS; light++) {
+        if (LIGHT_CHANGE_EVENTS[light] == eventType) {
+            return light;
         }
-        // Handle events for light change
-        case EVENT_CHANGE_GREEN_NS: {
-            cout << "Advancing cars on east-west yellow" << endl;
+    }
+    return LIGHT_UNKNOWN;
+}
 
-            int carsEast = 0, carsWest = 0;
+int IntersectionSimulationClass::getNextLight(const int light) const {
+    if (light == LIGHT_GREEN_EW) {
+        return LIGHT_YELLOW_EW;
+    }
+    else if (light == LIGHT_YELLOW_EW) {
+        return hasProtectedLefts ? LIGHT_GREEN_LEFT_NS : LIGHT_GREEN_NS;
+    }
+    else if (light == LIGHT_GREEN_NS) {
+        return LIGHT_YELLOW_NS;
+    }
+    else if (light == LIGHT_YELLOW_NS) {
+        return hasProtectedLefts ? LIGHT_GREEN_LEFT_EW : LIGHT_GREEN_EW;
+    }
+    else if (light == LIGHT_GREEN_LEFT_EW) {
+        return LIGHT_YELLOW_LEFT_EW;
+    }
+    else if (light == LIGHT_YELLOW_LEFT_EW) {
+        return LIGHT_GREEN_EW;
+    }
+    else if (light == LIGHT_GREEN_LEFT_NS) {
+        return LIGHT_YELLOW_LEFT_NS;
+    }
+    return LIGHT_GREEN_NS;
+}
+
+int IntersectionSimulationClass::getLightDuration(const int light) const {
+    if (light == LIGHT_GREEN_EW) {
+        return eastWestGreenTime;
+    }
+    else if (light == LIGHT_YELLOW_EW) {
+        return eastWestYellowTime;
+    }
+    else if (light == LIGHT_GREEN_NS) {
+        return northSouthGreenTime;
+    }
+    else if (light == LIGHT_YELLOW_NS) {
+        return northSouthYellowTime;
+    }
+    else if (light == LIGHT_GREEN_LEFT_EW || light == LIGHT_GREEN_LEFT_NS) {
+        return leftTurnGreenTime;
+    }
+    return leftTurnYellowTime;
+}
 
-            if (eastQueue.getNumElems() == NO_QUEUE) {
-                cout << "  No east-bound cars waiting to advance on yellow" 
-                     << endl;
+template <class PolicyT>
+void IntersectionSimulationClass::handleArrival(const int dirIdx) {
+    // Cars already waiting upstream go first, so a new car joins them
+    if (storageCapacities[dirIdx] > 0 &&
+        (numHeldCars[dirIdx] > 0 ||
+         getApproachQueueLength(dirIdx) >= storageCapacities[dirIdx])) {
+        if (storageBehaviors[dirIdx] == STORAGE_DIVERT) {
+            numDivertedCars[dirIdx]++;
+            if (PolicyT::HAS_LOGGING && isLogging) {
+                narrate(TRACE_CAR_DIVERTED, currentTime, dirIdx);
             }
-            while (eastQueue.getNumElems() > NO_QUEUE && 
-                   carsEast < eastWestYellowTime) {
-                int yellowAdvanceChance = getUniform(INCLUSIVE_MIN, 
-                INCLUSIVE_MAX);
-                if (yellowAdvanceChance > percentCarsAdvanceOnYellow && 
-                STOP_AT_YELLOW) {
-                    cout << "  Next east-bound car will NOT advance on yellow" 
-                         << endl;
-                    break;
-                }
-                CarClass car;
-                eastQueue.dequeue(car);
-                carsEast++;
-                cout << "  Car #" << car.getId() << " advances east-bound" 
-                     << endl;
+        }
+        else {
+            setNumHeldCars(dirIdx, numHeldCars[dirIdx] + 1);
+            numEverHeldCars[dirIdx]++;
+            maxHeldCars[dirIdx] = max(maxHeldCars[dirIdx],
+                                      numHeldCars[dirIdx]);
+            if (PolicyT::HAS_LOGGING && isLogging) {
+                narrate(TRACE_CAR_HELD, currentTime, dirIdx,
+                        numHeldCars[dirIdx]);
             }
+        }
+        scheduleArrival<PolicyT>(dirIdx);
+        return;
+    }
 
-            if (westQueue.getNumElems() == NO_QUEUE) {
-                cout << "  No west-bound cars waiting to advance on yellow" 
-                     << endl;
-            }
-            while (westQueue.getNumElems() > NO_QUEUE && 
-                   carsWest < eastWestYellowTime) {
-                int yellowAdvanceChance = getUniform(INCLUSIVE_MIN, 
-                INCLUSIVE_MAX);
-                if (yellowAdvanceChance > percentCarsAdvanceOnYellow && 
+    const int laneQueueIdx = queueCar<PolicyT>(dirIdx, false);
+    scheduleArrival<PolicyT>(dirIdx);
+    if (PolicyT::HAS_SATURATION_FLOW && isSaturationFlow) {
+        scheduleDeparture<PolicyT>(laneQueueIdx);
+    }
+}
+
+template <class PolicyT>
+int IntersectionSimulationClass::queueCar(const int dirIdx,
+                                          const bool isFromUpstream) {
+    int laneIdx = LANE_THROUGH;
+
+    // Only draw a turning movement for directions that have any, so runs
+    // without turning use the random number stream exactly as before
+    if (leftTurnPercents[dirIdx] + rightTurnPercents[dirIdx] > 0) {
+        int turnChance = turnStreams[dirIdx].getUniform(INCLUSIVE_MIN,
+                                                        INCLUSIVE_MAX);
+        if (turnChance <= leftTurnPercents[dirIdx]) {
+            laneIdx = LANE_LEFT;
+        }
+        else if (turnChance <= leftTurnPercents[dirIdx] +
+                               rightTurnPercents[dirIdx]) {
+            laneIdx = LANE_RIGHT;
+        }
+    }
+
+    const int laneQueueIdx = dirIdx * NUM_LANES + laneIdx;
+    CarClass carArrival(DIRECTION_NAMES[dirIdx], currentTime);
+    laneQueues[laneQueueIdx].enqueue(carArrival);
+    int approachLength = getApproachQueueLength(dirIdx);
+    if (PolicyT::HAS_LOGGING && isLogging) {
+        narrate(isFromUpstream ? TRACE_CAR_ENTERS : TRACE_CAR_ARRIVES,
+                currentTime, carArrival.getId(), laneQueueIdx, approachLength);
+    }
+
+    if (PolicyT::HAS_MONITORS && warmupDetector.getIsEnabled() &&
+        !warmupDetector.getIsDetected()) {
+        warmupDetector.addQueueLength(dirIdx, approachLength);
+    }
+
+    lastArrivalTimes[dirIdx] = currentTime;
+    maxQueueLengths[dirIdx] = max(maxQueueLengths[dirIdx], approachLength);
+    return laneQueueIdx;
+}
+
+void IntersectionSimulationClass::setNumHeldCars(const int dirIdx,
+                                                 const int newNumHeld) {
+    heldCarTics[dirIdx] += (double)numHeldCars[dirIdx] *
+                           (currentTime - heldChangeTimes[dirIdx]);
+    heldChangeTimes[dirIdx] = currentTime;
+    numHeldCars[dirIdx] = newNumHeld;
+}
+
+template <class PolicyT>
+void IntersectionSimulationClass::admitHeldCars(const int dirIdx) {
+    while (numHeldCars[dirIdx] > 0 &&
+           getApproachQueueLength(dirIdx) < storageCapacities[dirIdx]) {
+        setNumHeldCars(dirIdx, numHeldCars[dirIdx] - 1);
+        const int laneQueueIdx = queueCar<PolicyT>(dirIdx, true);
+        if (PolicyT::HAS_SATURATION_FLOW && isSaturationFlow) {
+            scheduleDeparture<PolicyT>(laneQueueIdx);
+        }
+    }
+}
+
+template <class PolicyT>
+int IntersectionSimulationClass::advanceLane(const int laneQueueIdx,
+                                             const int maxCars,
+                                             const bool isYellow) {
+    const int dirIdx = laneQueueIdx / NUM_LANES;
+    RingQueueClass< CarClass > &laneQueue = laneQueues[laneQueueIdx];
+    int numCars = 0;
+
+    while (laneQueue.getNumElems() > NO_QUEUE && numCars < maxCars) {
+        if (isYellow) {
+            int yellowAdvanceChance = yellowStreams[dirIdx].getUniform(
+                INCLUSIVE_MIN, INCLUSIVE_MAX);
+            if (yellowAdvanceChance > percentCarsAdvanceOnYellow &&
                 STOP_AT_YELLOW) {
-                    cout << "  Next west-bound car will NOT advance on yellow" 
-                         << endl;
-                    break;
+                if (PolicyT::HAS_LOGGING && isLogging) {
+                    narrate(TRACE_NO_YELLOW_ADVANCE, laneQueueIdx);
                 }
-                CarClass car;
-                westQueue.dequeue(car);
-                carsWest++;
-                cout << "  Car #" << car.getId() << " advances west-bound" 
-                     << endl;
+                break;
             }
+        }
+        CarClass car;
+        laneQueue.dequeue(car);
+        numCars++;
+        totalDelayTics += currentTime - car.getArrivalTime();
+        if (PolicyT::HAS_LOGGING && isLogging) {
+            narrate(TRACE_CAR_ADVANCES, car.getId(), laneQueueIdx);
+        }
+    }
+    numTotalAdvanced[laneQueueIdx] += numCars;
+    numDelayedCars += numCars;
+    return numCars;
+}
 
-            cout << "East-bound cars advanced on yellow: " 
-                 << carsEast
-                 << " Remaining queue: " << eastQueue.getNumElems() << endl;
-            cout << "West-bound cars advanced on yellow: " 
-                 << carsWest
-                 << " Remaining queue: " << westQueue.getNumElems() << endl;
+template <class PolicyT>
+void IntersectionSimulationClass::advanceCarsOnPhaseEnd() {
+    const bool isEastWest = (currentLight == LIGHT_GREEN_EW ||
+                             currentLight == LIGHT_YELLOW_EW ||
+                             currentLight == LIGHT_GREEN_LEFT_EW ||
+                             currentLight == LIGHT_YELLOW_LEFT_EW);
+    const int servedDirs[2] = {
+        isEastWest ? DIRECTION_EAST : DIRECTION_NORTH,
+        isEastWest ? DIRECTION_WEST : DIRECTION_SOUTH };
+    // Yellow states always immediately follow their green states
+    const bool isYellow = (currentLight % 2 == 0);
+    const int phaseDuration = currentTime - phaseStartTime;
+    int opposingThroughCars[2];
+    int numAdvanced[2];
 
-            numTotalAdvancedEast += carsEast;
-            numTotalAdvancedWest += carsWest;
+    if (PolicyT::HAS_LOGGING && isLogging) {
+        narrate(TRACE_ADVANCING, currentLight);
+    }
 
-            currentLight = LIGHT_GREEN_NS;
-            scheduleLightChange();
-            break;
-        }
-        // Handle events for light change
-        case EVENT_CHANGE_GREEN_EW: {
-            cout << "Advancing cars on north-south yellow" << endl;
+    // Permitted lefts only get through once the oncoming through queue
+    // has cleared, so note how long that takes before anything moves
+    for (int k = 0; k < 2; k++) {
+        opposingThroughCars[k] = min(phaseDuration, laneQueues[
+            servedDirs[1 - k] * NUM_LANES + LANE_THROUGH].getNumElems());
+    }
 
-            int carsNorth = 0, carsSouth = 0;
+    for (int k = 0; k < 2; k++) {
+        const int dirIdx = servedDirs[k];
+        int numWaiting = 0;
 
-            if (northQueue.getNumElems() == NO_QUEUE) {
-                cout << "  No north-bound cars waiting to advance on yellow" 
-                     << endl;
+        numAdvanced[k] = 0;
+        for (int laneIdx = 0; laneIdx < NUM_LANES; laneIdx++) {
+            int laneQueueIdx = dirIdx * NUM_LANES + laneIdx;
+            if (getLaneSignal(laneQueueIdx, currentLight) != LANE_SIGNAL_RED) {
+                numWaiting += laneQueues[laneQueueIdx].getNumElems();
             }
-            while (northQueue.getNumElems() > NO_QUEUE && 
-                   carsNorth < northSouthYellowTime) {
-                int yellowAdvanceChance = getUniform(INCLUSIVE_MIN, 
-                INCLUSIVE_MAX);
-                if (yellowAdvanceChance > percentCarsAdvanceOnYellow && 
-                STOP_AT_YELLOW) {
-                    cout << "  Next north-bound car will NOT advance on yellow"
-                         << endl;
-                    break;
-                }
-                CarClass car;
-                northQueue.dequeue(car);
-                carsNorth++;
-                cout << "  Car #" << car.getId() 
-                     << " advances north-bound" << endl;
+        }
+        if (PolicyT::HAS_LOGGING && isLogging && isYellow &&
+            numWaiting == NO_QUEUE) {
+            narrate(TRACE_NONE_ON_YELLOW, dirIdx);
+        }
+
+        for (int laneIdx = 0; laneIdx < NUM_LANES; laneIdx++) {
+            int laneQueueIdx = dirIdx * NUM_LANES + laneIdx;
+            int laneSignal = getLaneSignal(laneQueueIdx, currentLight);
+            if (laneSignal == LANE_SIGNAL_RED) {
+                continue;
+            }
+            int maxCars = phaseDuration;
+            if (laneSignal == LANE_SIGNAL_PERMITTED) {
+                maxCars = phaseDuration - opposingThroughCars[k];
             }
+            numAdvanced[k] += advanceLane<PolicyT>(
+                laneQueueIdx, maxCars, laneSignal == LANE_SIGNAL_YELLOW);
+        }
+    }
 
-            if (southQueue.getNumElems() == NO_QUEUE) {
-                cout << "  No south-bound cars waiting to advance on yellow" 
-                     << endl;
+    for (int k = 0; k < 2 && PolicyT::HAS_LOGGING && isLogging; k++) {
+        narrate(TRACE_NUM_ADVANCED, servedDirs[k], currentLight,
+                numAdvanced[k], getApproachQueueLength(servedDirs[k]));
+    }
+
+    // The room just made lets cars waiting upstream in, from now on
+    for (int k = 0; k < 2; k++) {
+        admitHeldCars<PolicyT>(servedDirs[k]);
+    }
+}
+
+template <class PolicyT>
+void IntersectionSimulationClass::changeLight(const int newLight) {
+    currentLight = newLight;
+    phaseStartTime = currentTime;
+
+    // Start the lanes that just got a green light moving; departures
+    // already pending on yellow simply carry on
+    if (PolicyT::HAS_SATURATION_FLOW && isSaturationFlow) {
+        for (int i = 0; i < NUM_LANE_QUEUES; i++) {
+            int laneSignal = getLaneSignal(i, currentLight);
+            if (laneSignal == LANE_SIGNAL_GREEN ||
+                laneSignal == LANE_SIGNAL_PERMITTED) {
+                isStoppedOnYellow[i] = false;
+                scheduleDeparture<PolicyT>(i);
             }
-            while (southQueue.getNumElems() > NO_QUEUE && 
-                   carsSouth < northSouthYellowTime) {
-                int yellowAdvanceChance = getUniform(INCLUSIVE_MIN, 
-                INCLUSIVE_MAX);
-                if (yellowAdvanceChance > percentCarsAdvanceOnYellow && 
-                STOP_AT_YELLOW) {
-                    cout << "  Next south-bound car will NOT advance on yellow" 
-                         << endl;
-                    break;
-                }
-                CarClass car;
-                southQueue.dequeue(car);
-                carsSouth++;
-                cout << "  Car #" << car.getId() << " advances south-bound" 
-                     << endl;
+        }
+    }
+    scheduleLightChange<PolicyT>();
+}
+
+template <class PolicyT>
+void IntersectionSimulationClass::scheduleDeparture(const int laneQueueIdx) {
+    int laneSignal = getLaneSignal(laneQueueIdx, currentLight);
+
+    if (isDeparturePending[laneQueueIdx] ||
+        laneQueues[laneQueueIdx].getNumElems() == NO_QUEUE ||
+        laneSignal == LANE_SIGNAL_RED ||
+        (laneSignal == LANE_SIGNAL_YELLOW &&
+         isStoppedOnYellow[laneQueueIdx])) {
+        return;
+    }
+
+    int eventTime = max(currentTime, phaseStartTime + startupLostTime) +
+                    saturationHeadway;
+    if (laneSignal == LANE_SIGNAL_YELLOW) {
+        // Cars moving through the yellow are already past the lost time
+        eventTime = currentTime + saturationHeadway;
+    }
+    EventClass departEvent(eventTime, EVENT_DEPART_FIRST + laneQueueIdx);
+    eventList.insertValue(departEvent);
+    isDeparturePending[laneQueueIdx] = true;
+
+    if (PolicyT::HAS_LOGGING && isLogging) {
+        narrate(TRACE_SCHEDULED, currentTime, departEvent.getType(),
+                departEvent.getTimeOccurs());
+    }
+}
+
+template <class PolicyT>
+void IntersectionSimulationClass::handleDeparture(const int laneQueueIdx) {
+    const int dirIdx = laneQueueIdx / NUM_LANES;
+    RingQueueClass< CarClass > &laneQueue = laneQueues[laneQueueIdx];
+    int laneSignal = getLaneSignal(laneQueueIdx, currentLight);
+
+    isDeparturePending[laneQueueIdx] = false;
+
+    // The light may have turned red since this departure was scheduled
+    if (laneSignal == LANE_SIGNAL_RED) {
+        if (PolicyT::HAS_LOGGING && isLogging) {
+            narrate(TRACE_RED_NO_DEPARTURE, laneQueueIdx);
+        }
+        return;
+    }
+    if (laneSignal == LANE_SIGNAL_PERMITTED &&
+        laneQueues[(dirIdx ^ 1) * NUM_LANES + LANE_THROUGH].getNumElems() >
+        NO_QUEUE) {
+        // Opposite directions differ only in the lowest bit of their index
+        if (PolicyT::HAS_LOGGING && isLogging) {
+            narrate(TRACE_CAR_YIELDS, laneQueueIdx);
+        }
+        scheduleDeparture<PolicyT>(laneQueueIdx);
+        return;
+    }
+    if (laneSignal == LANE_SIGNAL_YELLOW) {
+        int yellowAdvanceChance = yellowStreams[dirIdx].getUniform(
+            INCLUSIVE_MIN, INCLUSIVE_MAX);
+        if (yellowAdvanceChance > percentCarsAdvanceOnYellow &&
+            STOP_AT_YELLOW) {
+            if (PolicyT::HAS_LOGGING && isLogging) {
+                narrate(TRACE_NO_YELLOW_DEPARTURE, laneQueueIdx);
             }
+            isStoppedOnYellow[laneQueueIdx] = true;
+            return;
+        }
+    }
 
-            cout << "North-bound cars advanced on yellow: " 
-                 << carsNorth
-                 << " Remaining queue: " << northQueue.getNumElems() << endl;
-            cout << "South-bound cars advanced on yellow: " 
-                 << carsSouth
-                 << " Remaining queue: " << southQueue.getNumElems() << endl;
+    CarClass car;
+    laneQueue.dequeue(car);
+    numTotalAdvanced[laneQueueIdx]++;
+    totalDelayTics += currentTime - car.getArrivalTime();
+    numDelayedCars++;
+    if (PolicyT::HAS_LOGGING && isLogging) {
+        narrate(TRACE_CAR_DEPARTS, currentTime, car.getId(), laneQueueIdx,
+                getApproachQueueLength(dirIdx));
+    }
 
-            numTotalAdvancedNorth += carsNorth;
-            numTotalAdvancedSouth += carsSouth;
+    scheduleDeparture<PolicyT>(laneQueueIdx);
+    admitHeldCars<PolicyT>(dirIdx);
+}
 
-            currentLight = LIGHT_GREEN_EW;
-            scheduleLightChange();
-            break;
+// Handle next event
+bool IntersectionSimulationClass::handleNextEvent() {
+    EventClass currentEvent;
+
+    // Retrieve the next event
+    if (!eventList.removeFront(currentEvent)) {
+        if (isLogging) {
+            narrate(TRACE_NO_EVENTS);
         }
-        default:
-            cout << "Unknown event type encountered." << endl;
-            break;
+        finishRun();
+        return false;
     }
+
+    // Check if the event occurs after the simulation end time
+    if (currentEvent.getTimeOccurs() > timeToStopSim) {
+        currentTime = currentEvent.getTimeOccurs();
+        if (isLogging) {
+            narrate(TRACE_AFTER_END, currentEvent.getType(),
+                    currentEvent.getTimeOccurs());
+        }
+        finishRun();
+        return false;
+    }
+    (this->*getKernel().handleEvent)(currentEvent);
     return true;
 }
 
+template <class PolicyT>
+void IntersectionSimulationClass::handleEvent(const EventClass &currentEvent) {
+    if (PolicyT::HAS_MONITORS &&
+        timeSeriesSampler.getIsDue(currentEvent.getTimeOccurs())) {
+        sampleTimeSeries(currentEvent.getTimeOccurs());
+    }
+
+    if (PolicyT::HAS_MONITORS && warmupDetector.getIsEnabled() &&
+        !warmupDetector.getIsDetected() &&
+        warmupDetector.addEvent(currentEvent.getTimeOccurs(),
+                                getTotalQueueLength()) &&
+        warmupDetector.addObservation(numTotalAdvanced)) {
+        currentTime = currentEvent.getTimeOccurs();
+        truncateWarmup();
+    }
+
+    // Once the statistics up to this event are precise enough, the run
+    // ends here, as if the end time had been reached.  With warm-up
+    // detection, convergence is only watched from the end of the warm-up.
+    if (PolicyT::HAS_MONITORS && convergenceMonitor.getIsEnabled() &&
+        (!warmupDetector.getIsEnabled() || warmupDetector.getIsDetected()) &&
+        convergenceMonitor.addEvent(currentEvent.getTimeOccurs(),
+                                    getTotalQueueLength()) &&
+        convergenceMonitor.checkConvergence(getTotalAdvanced())) {
+        currentTime = currentEvent.getTimeOccurs();
+        eventList.clear();
+        if (PolicyT::HAS_LOGGING && isLogging) {
+            narrate(TRACE_CONVERGED, currentTime);
+        }
+        return;
+    }
+
+    // Advance the simulation time
+    currentTime = currentEvent.getTimeOccurs();
+    numEventsHandled++;
+    if (PolicyT::HAS_LOGGING && isLogging) {
+        narrate(TRACE_HANDLING, currentEvent.getType(),
+                currentEvent.getTimeOccurs());
+    }
+
+    // At a controller decision point, either stay green a while longer or
+    // end the green phase now, exactly as a scheduled light change would
+    int eventType = currentEvent.getType();
+    if (PolicyT::HAS_CONTROLLER && eventType == EVENT_CHECK_GREEN) {
+        int extension = consultSignalController(false);
+        if (extension > 0) {
+            EventClass checkEvent(currentTime + extension, EVENT_CHECK_GREEN);
+            eventList.insertValue(checkEvent);
+            if (PolicyT::HAS_LOGGING && isLogging) {
+                narrate(TRACE_GREEN_EXTENDED, currentTime, checkEvent.getType(),
+                        checkEvent.getTimeOccurs());
+            }
+            return;
+        }
+        eventType = LIGHT_CHANGE_EVENTS[getNextLight(currentLight)];
+    }
+
+    if (eventType >= EVENT_ARRIVE_EAST && eventType <= EVENT_ARRIVE_SOUTH) {
+        // Arrival event types are in the same order as the directions
+        handleArrival<PolicyT>(eventType - EVENT_ARRIVE_EAST);
+    }
+    else if (PolicyT::HAS_SATURATION_FLOW &&
+             eventType >= EVENT_DEPART_FIRST &&
+             eventType <= EVENT_DEPART_LAST) {
+        handleDeparture<PolicyT>(eventType - EVENT_DEPART_FIRST);
+    }
+    else if (getLightForChangeEvent(eventType) != LIGHT_UNKNOWN) {
+        // Without departure events, the cars that got through during the
+        // phase that is ending all advance now
+        if (!(PolicyT::HAS_SATURATION_FLOW && isSaturationFlow)) {
+            advanceCarsOnPhaseEnd<PolicyT>();
+        }
+        changeLight<PolicyT>(getLightForChangeEvent(eventType));
+    }
+    else if (PolicyT::HAS_LOGGING && isLogging) {
+        narrate(TRACE_UNKNOWN_EVENT);
+    }
+}
+
+template <class PolicyT>
+int IntersectionSimulationClass::runKernel(const EventClass &lastEvent,
+                                           const int maxEvents) {
+    EventClass currentEvent;
+    int numHandled = 0;
+
+    while (numHandled < maxEvents &&
+           eventList.removeFrontIfNotAfter(lastEvent, currentEvent)) {
+        handleEvent<PolicyT>(currentEvent);
+        numHandled++;
+    }
+    return numHandled;
+}
+
+template <class PolicyT>
+IntersectionSimulationClass::KernelStruct
+IntersectionSimulationClass::makeKernel() {
+    KernelStruct kernel;
+
+    kernel.runEvents = &IntersectionSimulationClass::runKernel<PolicyT>;
+    kernel.handleEvent = &IntersectionSimulationClass::handleEvent<PolicyT>;
+    kernel.scheduleArrival =
+        &IntersectionSimulationClass::scheduleArrival<PolicyT>;
+    kernel.scheduleLightChange =
+        &IntersectionSimulationClass::scheduleLightChange<PolicyT>;
+    return kernel;
+}
+
+// In KERNEL_INDEX order: logging, saturation flow, monitors, controller
+const IntersectionSimulationClass::KernelStruct
+IntersectionSimulationClass::KERNELS[NUM_SIMULATION_KERNELS] = {
+    makeKernel< SimulationPolicyStruct< false, false, false, false > >(),
+    makeKernel< SimulationPolicyStruct< false, false, false, true > >(),
+    makeKernel< SimulationPolicyStruct< false, false, true, false > >(),
+    makeKernel< SimulationPolicyStruct< false, false, true, true > >(),
+    makeKernel< SimulationPolicyStruct< false, true, false, false > >(),
+    makeKernel< SimulationPolicyStruct< false, true, false, true > >(),
+    makeKernel< SimulationPolicyStruct< false, true, true, false > >(),
+    makeKernel< SimulationPolicyStruct< false, true, true, true > >(),
+    makeKernel< SimulationPolicyStruct< true, false, false, false > >(),
+    makeKernel< SimulationPolicyStruct< true, false, false, true > >(),
+    makeKernel< SimulationPolicyStruct< true, false, true, false > >(),
+    makeKernel< SimulationPolicyStruct< true, false, true, true > >(),
+    makeKernel< SimulationPolicyStruct< true, true, false, false > >(),
+    makeKernel< SimulationPolicyStruct< true, true, false, true > >(),
+    makeKernel< SimulationPolicyStruct< true, true, true, false > >(),
+    makeKernel< GenericPolicyStruct >() };
+
+const IntersectionSimulationClass::KernelStruct&
+IntersectionSimulationClass::getKernel() const {
+    if (!isKernelSpecialized) {
+        return KERNELS[GenericPolicyStruct::KERNEL_INDEX];
+    }
+    const bool hasMonitors = warmupDetector.getIsEnabled() ||
+                             convergenceMonitor.getIsEnabled() ||
+                             timeSeriesSampler.getIsEnabled();
+    return KERNELS[SimulationPolicyStruct< true, false, false, false >::
+                       KERNEL_INDEX * isLogging +
+                   SimulationPolicyStruct< false, true, false, false >::
+                       KERNEL_INDEX * isSaturationFlow +
+                   SimulationPolicyStruct< false, false, true, false >::
+                       KERNEL_INDEX * hasMonitors +
+                   SimulationPolicyStruct< false, false, false, true >::
+                       KERNEL_INDEX * (signalController != NULL)];
+}
+
 void IntersectionSimulationClass::printStatistics(
      ) const
 {
+  bool hasTurningMovements = false;
+
   cout << "===== Begin Simulation Statistics =====" << endl;
-  cout << "  Longest east-bound queue: " << maxEastQueueLength << endl;
-  cout << "  Longest west-bound queue: " << maxWestQueueLength << endl;
-  cout << "  Longest north-bound queue: " << maxNorthQueueLength << endl;
-  cout << "  Longest south-bound queue: " << maxSouthQueueLength << endl;
-  cout << "  Total cars advanced east-bound: " <<
-          numTotalAdvancedEast << endl;
-  cout << "  Total cars advanced west-bound: " <<
-          numTotalAdvancedWest << endl;
-  cout << "  Total cars advanced north-bound: " <<
-          numTotalAdvancedNorth << endl;
-  cout << "  Total cars advanced south-bound: " <<
-          numTotalAdvancedSouth << endl;
+  for (int i = 0; i < NUM_DIRECTIONS; i++)
+  {
+    cout << "  Longest " << DIRECTION_BOUND_LABELS[i] << " queue: " <<
+            maxQueueLengths[i] << endl;
+    hasTurningMovements = hasTurningMovements ||
+                          (leftTurnPercents[i] + rightTurnPercents[i] > 0);
+  }
+  for (int i = 0; i < NUM_DIRECTIONS; i++)
+  {
+    cout << "  Total cars advanced " << DIRECTION_BOUND_LABELS[i] << ": " <<
+            numTotalAdvanced[i * NUM_LANES + LANE_THROUGH] +
+            numTotalAdvanced[i * NUM_LANES + LANE_LEFT] +
+            numTotalAdvanced[i * NUM_LANES + LANE_RIGHT] << endl;
+  }
+  if (hasTurningMovements)
+  {
+    for (int i = 0; i < NUM_DIRECTIONS; i++)
+    {
+      cout << "  Cars advanced " << DIRECTION_BOUND_LABELS[i] << " by lane -";
+      for (int laneIdx = 0; laneIdx < NUM_LANES; laneIdx++)
+      {
+        cout << " " << LANE_NAMES[laneIdx] << ": " <<
+                numTotalAdvanced[i * NUM_LANES + laneIdx];
+      }
+      cout << endl;
+    }
+  }
+  for (int i = 0; i < NUM_DIRECTIONS; i++)
+  {
+    if (storageCapacities[i] > 0 && storageBehaviors[i] == STORAGE_DIVERT)
+    {
+      cout << "  Cars diverted " << DIRECTION_BOUND_LABELS[i] <<
+              " (storage full): " << numDivertedCars[i] << endl;
+    }
+    else if (storageCapacities[i] > 0)
+    {
+      double totalHeldTics = heldCarTics[i] + (double)numHeldCars[i] *
+                             (currentTime - heldChangeTimes[i]);
+      cout << "  Cars held upstream " << DIRECTION_BOUND_LABELS[i] <<
+              " (storage full): " << numEverHeldCars[i] <<
+              " Most at once: " << maxHeldCars[i] <<
+              " Average wait (tics): " <<
+              (numEverHeldCars[i] > 0 ?
+               totalHeldTics / numEverHeldCars[i] : 0) << endl;
+    }
+  }
+  if (warmupDetector.getIsEnabled())
+  {
+    if (warmupDetector.getIsDetected())
+    {
+      cout << "  Warm-up ended at time " <<
+              warmupDetector.getWarmupEndTime() << " (first " <<
+              warmupDetector.getNumTruncated() << " of " <<
+              warmupDetector.getNumBatches() << " batches), statistics " <<
+              "above exclude it" << endl;
+    }
+    else
+    {
+      cout << "  Warm-up end not found, statistics above include it" <<
+              endl;
+    }
+  }
+  if (convergenceMonitor.getIsEnabled())
+  {
+    if (convergenceMonitor.getIsConverged())
+    {
+      cout << "  Converged at time " << currentTime << " after " <<
+              convergenceMonitor.getNumBatches() << " batches" << endl;
+    }
+    else
+    {
+      cout << "  Did not converge, " << convergenceMonitor.getNumBatches() <<
+              " batches" << endl;
+    }
+    cout << "  Throughput (cars/tic): " <<
+            convergenceMonitor.getMean(CONVERGENCE_THROUGHPUT) << " +/- " <<
+            convergenceMonitor.getHalfWidth(CONVERGENCE_THROUGHPUT) << endl;
+    cout << "  Mean queue length: " <<
+            convergenceMonitor.getMean(CONVERGENCE_QUEUE_LENGTH) << " +/- " <<
+            convergenceMonitor.getHalfWidth(CONVERGENCE_QUEUE_LENGTH) << endl;
+  }
+  if (signalController != NULL)
+  {
+    cout << "  Signal controller decisions: " << numControllerDecisions <<
+            " Average decision cost (ns): " <<
+            (numControllerDecisions > 0 ?
+             controllerDecisionNanos / numControllerDecisions : 0) << endl;
+  }
   cout << "===== End Simulation Statistics =====" << endl;
 }
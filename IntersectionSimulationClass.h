@@ -2,13 +2,64 @@
 #define _INTERSECTIONSIMULATIONCLASS_H_
 
 #include <string>
+#include <fstream>
+#include <iostream>
 //Note: not "using namespace std" in header files, so will have to
 //      prepend all items from the std namespace with "std::" here
 #include "SortedListClass.h"
 #include "EventClass.h"
 
-#include "FIFOQueueClass.h"
+#include "RingQueueClass.h"
 #include "CarClass.h"
+#include "ArrivalTraceClass.h"
+#include "RateProfileClass.h"
+#include "ArrivalSamplerClass.h"
+#include "SignalControllerClass.h"
+#include "SimulationStructs.h"
+#include "ConvergenceMonitorClass.h"
+#include "WarmupDetectorClass.h"
+#include "TimeSeriesSamplerClass.h"
+#include "AsyncLogBufferClass.h"
+#include "TraceRecorderClass.h"
+#include "RandomStreamClass.h"
+#include "SimulationPolicyStruct.h"
+
+//Everything about a run in progress that changes as it runs, saved by
+//saveState so the run can be carried on from that point any number of
+//times.  The parameters are not included, as they never change mid-run.
+struct SimulationSnapshotStruct
+{
+  bool isStarted;
+  int currentTime;
+  int currentLight;
+  int phaseStartTime;
+  int lastArrivalTimes[NUM_DIRECTIONS];
+  bool isDeparturePending[NUM_LANE_QUEUES];
+  bool isStoppedOnYellow[NUM_LANE_QUEUES];
+  SortedListClass< EventClass > eventList;
+  RingQueueClass< CarClass > laneQueues[NUM_LANE_QUEUES];
+  int numHeldCars[NUM_DIRECTIONS];
+  int heldChangeTimes[NUM_DIRECTIONS];
+  RateProfileClass arrivalProfiles[NUM_DIRECTIONS];
+  RandomStreamClass arrivalStreams[NUM_DIRECTIONS];
+  RandomStreamClass turnStreams[NUM_DIRECTIONS];
+  RandomStreamClass yellowStreams[NUM_DIRECTIONS];
+  ConvergenceMonitorClass convergenceMonitor;
+  WarmupDetectorClass warmupDetector;
+  int maxQueueLengths[NUM_DIRECTIONS];
+  int numTotalAdvanced[NUM_LANE_QUEUES];
+  int numDivertedCars[NUM_DIRECTIONS];
+  int numEverHeldCars[NUM_DIRECTIONS];
+  int maxHeldCars[NUM_DIRECTIONS];
+  double heldCarTics[NUM_DIRECTIONS];
+  double totalDelayTics;
+  int numDelayedCars;
+  int numEventsHandled;
+  int numControllerDecisions;
+  double controllerDecisionNanos;
+  int64_t numSharedDraws; //Draws from the shared rand() generator
+  int nextCarId;
+};
 
 //Programmer: Andrew Morgan
 //Date: November 2020
@@ -57,6 +108,10 @@ class IntersectionSimulationClass
     double southArrivalMean;
     double southArrivalStdDev;
 
+    SignalControllerClass *signalController; //Decides green times from the
+                                             //queues, or NULL to use the
+                                             //fixed green times above
+
     int percentCarsAdvanceOnYellow; //Percentage of cars that, when
                                     //reaching the traffic light in a
                                        //yellow state advance through the
@@ -65,48 +120,403 @@ class IntersectionSimulationClass
                                        //75% of the vehicles will advance on
                                        //yellow, and 25% will not.
 
+    ArrivalSamplerClass *arrivalSamplers[NUM_DIRECTIONS]; //Per-direction
+                                                          //distribution
+                                                          //that replaces
+                                                          //the normal one
+                                                          //above, or NULL
+
+    ArrivalTraceClass arrivalTrace; //When open, arrivals are replayed from
+                                    //this recorded trace rather than drawn
+                                    //from the distributions above.
+    RateProfileClass arrivalProfiles[NUM_DIRECTIONS]; //Time-varying rate
+                                                      //multiplier applied
+                                                      //to each direction's
+                                                      //arrivals
+
+    bool isSaturationFlow; //When true, cars depart one saturation headway
+                           //apart via departure events, rather than one
+                           //per tic all at once when the light changes
+    int saturationHeadway; //Tics between consecutive departures
+    int startupLostTime; //Tics lost at the start of green before the
+                         //first car starts to move
+
+    int leftTurnPercents[NUM_DIRECTIONS]; //Percentage of each direction's
+                                          //cars that turn left
+    int rightTurnPercents[NUM_DIRECTIONS]; //Percentage that turn right
+    bool hasProtectedLefts; //When true, each green is preceded by a
+                            //protected left turn arrow phase
+    int leftTurnGreenTime; //Tics the protected left arrow is green
+    int leftTurnYellowTime; //Tics the protected left arrow is yellow
+
+    int storageCapacities[NUM_DIRECTIONS]; //Cars each approach has room
+                                           //for, all lanes together, or
+                                           //0 for unlimited room
+    int storageBehaviors[NUM_DIRECTIONS]; //STORAGE_* constant saying what
+                                          //cars arriving at a full
+                                          //approach do
+
+    bool isUsingSubstreams; //When true, each purpose below draws from its
+                            //own substream rather than the shared rand()
+                            //generator
+    bool isAntithetic; //When true, every random draw is mirrored
+    RandomStreamClass arrivalStreams[NUM_DIRECTIONS]; //Draws for each
+                                                      //direction's gaps
+                                                      //between arrivals
+    RandomStreamClass turnStreams[NUM_DIRECTIONS]; //Draws for each
+                                                   //direction's turning
+                                                   //movements
+    RandomStreamClass yellowStreams[NUM_DIRECTIONS]; //Draws for each
+                                                     //direction's drivers
+                                                     //deciding whether to
+                                                     //go on yellow
+
+    ConvergenceMonitorClass convergenceMonitor; //When set up, ends the run
+                                                //as soon as its throughput
+                                                //and queue length are
+                                                //measured precisely enough
+    WarmupDetectorClass warmupDetector; //When set up, resets the
+                                        //statistics to the end of the
+                                        //start-up transient once found
+    TimeSeriesSamplerClass timeSeriesSampler; //When set up, records the
+                                              //queue lengths and light
+                                              //at regular times
+
     //Simulation execution attributes
+    std::streambuf *logTarget; //Buffer of the stream given to
+                               //setLogStream (cout's by default), or NULL
+    bool isLogAsync; //Whether the narration is written to logTarget by
+                     //a background thread rather than as it is made
+    AsyncLogBufferClass asyncLogBuffer; //Holds the narration for the
+                                        //background thread, when async
+    std::ostream eventLog; //Where events are narrated as they are handled;
+                           //shares logTarget, or asyncLogBuffer when
+                           //async, or has none and discards everything
+    bool isTraceDeferred; //Whether the narration is recorded in
+                          //traceRecorder instead of written to eventLog
+    TraceRecorderClass traceRecorder; //Holds the narration as records,
+                                      //when deferred
+    bool isLogging; //Whether eventLog has a buffer or the narration is
+                    //deferred; every narration is skipped when neither
+    bool isKernelSpecialized; //Whether events are handled by the kernel
+                              //compiled for exactly the features in use,
+                              //rather than the generic one
+    bool isStarted; //Whether the seed events have been scheduled
     int currentTime; //The current time for the simulation
     int currentLight; //The state of the traffic light at the current sim time
+    int phaseStartTime; //Time at which the current light state began
+    int lastArrivalTimes[NUM_DIRECTIONS]; //Time of each direction's most
+                                          //recent arrival
+    bool isDeparturePending[NUM_LANE_QUEUES]; //Whether a departure event
+                                              //is scheduled for each lane
+                                              //(never more than one)
+    bool isStoppedOnYellow[NUM_LANE_QUEUES]; //Whether a car in each lane
+                                             //has stopped for this yellow
     SortedListClass< EventClass > eventList; //The time-sorted list of events
                                              //currently scheduled to occur
-    FIFOQueueClass< CarClass > eastQueue; //Queue of cars waiting to advance
-                                          //through intersection east-bound
-    FIFOQueueClass< CarClass > westQueue; //West-bound queue of cars
-    FIFOQueueClass< CarClass > northQueue; //North-bound queue of cars
-    FIFOQueueClass< CarClass > southQueue; //South-bound queue of cars
+    RingQueueClass< CarClass > laneQueues[NUM_LANE_QUEUES]; //Queues of cars
+                                             //waiting to advance through
+                                             //the intersection, one per
+                                             //lane of each approach, kept
+                                             //side by side and indexed by
+                                             //dirIdx * NUM_LANES + laneIdx
+    int numHeldCars[NUM_DIRECTIONS]; //Cars waiting upstream of each
+                                     //approach for room in its storage
+    int heldChangeTimes[NUM_DIRECTIONS]; //Time each count of held cars
+                                         //last changed
 
     //Statistics-Related attributes
-    int maxEastQueueLength;
-    int maxWestQueueLength;
-    int maxNorthQueueLength;
-    int maxSouthQueueLength;
-    int numTotalAdvancedEast;
-    int numTotalAdvancedWest;
-    int numTotalAdvancedNorth;
-    int numTotalAdvancedSouth;
+    int maxQueueLengths[NUM_DIRECTIONS]; //Longest queue, all lanes of an
+                                         //approach together
+    int numTotalAdvanced[NUM_LANE_QUEUES]; //Cars advanced from each lane
+    int numDivertedCars[NUM_DIRECTIONS]; //Cars lost to each full approach
+    int numEverHeldCars[NUM_DIRECTIONS]; //Cars that had to wait upstream
+    int maxHeldCars[NUM_DIRECTIONS]; //Most cars waiting upstream at once
+    double heldCarTics[NUM_DIRECTIONS]; //Total tics cars waited upstream,
+                                        //up to the last change of count
+    double totalDelayTics; //Total tics advanced cars spent in their lane
+                           //queues, since the start or the warm-up end
+    int numDelayedCars; //Cars whose delay is in totalDelayTics
+    int numEventsHandled; //Events handled since the last restart
+    int numControllerDecisions; //Number of times the signal controller
+                                //was consulted
+    double controllerDecisionNanos; //Total wall time spent in the signal
+                                    //controller's decisions
+
+    //Reads the optional "keyword value(s)" lines that may follow the
+    //required parameters, until the end of the file.  Returns false
+    //(after printing an error) if any line is unrecognized or invalid.
+    bool readOptionalParameters(
+         std::ifstream &paramF
+         );
+
+    //Returns the DIRECTION_* index for a direction name, or -1 if the
+    //name is not one of the four known directions.
+    int getDirectionIndex(
+         const std::string &travelDir
+         ) const;
+
+    //Consults the signal controller about the current green phase, either
+    //as it starts or at a decision point, timing the call.  Returns the
+    //controller's answer: tics until the next decision point, or 0 to
+    //end the phase.
+    int consultSignalController(
+         const bool isPhaseStart
+         );
+
+    //Seeds the random number generator, and every purpose's substream
+    //when they are in use, from the random seed.
+    void seedRandomStreams(
+         );
+
+    //Resets the statistics to what they would have been had they been
+    //collected only from the end of the warm-up the detector just found.
+    void truncateWarmup(
+         );
+
+    //Returns the total number of cars waiting in every lane.
+    int getTotalQueueLength(
+         ) const;
+
+    //Returns the total number of cars advanced from every lane.
+    int getTotalAdvanced(
+         ) const;
+
+    //Hands the current state to the time series sampler for the samples
+    //due before the given event time.
+    void sampleTimeSeries(
+         const int eventTime
+         );
+
+    //Completes the time series of a run that has ended, and writes out
+    //any narration still held for the background thread.
+    void finishRun(
+         );
+
+    //Points eventLog at logTarget, directly or through asyncLogBuffer.
+    void applyLogTarget(
+         );
+
+    //Narrates one line in the given TRACE_* format: recorded as it is
+    //when the narration is deferred, otherwise formatted and written to
+    //eventLog straight away.
+    void narrate(
+         const int formatId,
+         const int arg0 = 0,
+         const int arg1 = 0,
+         const int arg2 = 0,
+         const int arg3 = 0
+         )
+    {
+      if (isTraceDeferred)
+      {
+        traceRecorder.add(formatId, arg0, arg1, arg2, arg3);
+        return;
+      }
+      TraceRecordStruct record = { formatId, { arg0, arg1, arg2, arg3 } };
+      TraceRecorderClass::renderRecord(eventLog, record);
+      //Each line is flushed as it is narrated, as endl would
+      eventLog.flush();
+    }
+
+    //Returns what the cars in a lane may do under the given light state,
+    //as one of the LANE_SIGNAL_* constants.
+    int getLaneSignal(
+         const int laneQueueIdx,
+         const int light
+         ) const;
+
+    //Returns the light state a light change event changes the light to,
+    //or LIGHT_UNKNOWN if the event is not a light change.
+    int getLightForChangeEvent(
+         const int eventType
+         ) const;
+
+    //Returns the light state that follows the given one in the cycle.
+    int getNextLight(
+         const int light
+         ) const;
+
+    //Returns how long the given light state lasts with fixed timing.
+    int getLightDuration(
+         const int light
+         ) const;
+
+    //Handles a car arriving from a direction: queues it, unless the
+    //approach's storage is full, and schedules the next arrival from
+    //that direction.
+    template < class PolicyT >
+    void handleArrival(
+         const int dirIdx
+         );
+
+    //Picks the lane of a car entering an approach, either as it arrives
+    //or (isFromUpstream) after waiting upstream, and queues it.  Returns
+    //the index of the lane queue it joined.
+    template < class PolicyT >
+    int queueCar(
+         const int dirIdx,
+         const bool isFromUpstream
+         );
+
+    //Changes the number of cars waiting upstream of an approach,
+    //accounting for the time they have waited.
+    void setNumHeldCars(
+         const int dirIdx,
+         const int newNumHeld
+         );
+
+    //Lets cars waiting upstream of an approach into it while it has room.
+    template < class PolicyT >
+    void admitHeldCars(
+         const int dirIdx
+         );
+
+    //Advances up to maxCars cars from the front of a lane, one at a time,
+    //and returns the number advanced.  On yellow, each car first decides
+    //whether to advance, and the first car that stops ends the loop.
+    template < class PolicyT >
+    int advanceLane(
+         const int laneQueueIdx,
+         const int maxCars,
+         const bool isYellow
+         );
+
+    //Advances the cars that got through during the light state that is
+    //just ending, all at once, one car per tic per lane.  Used when the
+    //saturation flow model is off.
+    template < class PolicyT >
+    void advanceCarsOnPhaseEnd(
+         );
+
+    //Changes the light, records the start of the new phase, starts any
+    //departures it allows, and schedules the next light change.
+    template < class PolicyT >
+    void changeLight(
+         const int newLight
+         );
+
+    //Provides the time of the next scheduled event, without handling it,
+    //via outTime.  Returns false if no events are scheduled.
+    bool getNextEventTime(
+         int &outTime
+         ) const;
+
+    //Schedules an arrival event from the direction with the given
+    //DIRECTION_* index.
+    template < class PolicyT >
+    void scheduleArrival(
+         const int dirIdx
+         );
+
+    //Handles one event already taken off the event list: advances the
+    //time to it and does whatever its type calls for.
+    template < class PolicyT >
+    void handleEvent(
+         const EventClass &currentEvent
+         );
+
+    //Saturation flow model: schedules the next departure from a lane,
+    //one headway after both the current time and the end of the start-up
+    //lost time, unless a departure is already pending or no car can go.
+    template < class PolicyT >
+    void scheduleDeparture(
+         const int laneQueueIdx
+         );
+
+    //Saturation flow model: handles a departure event, letting the car
+    //at the front of the lane through if the light still allows it.
+    template < class PolicyT >
+    void handleDeparture(
+         const int laneQueueIdx
+         );
+
+    //Schedules the light change (or controller decision point) that ends
+    //the current light state.
+    template < class PolicyT >
+    void scheduleLightChange(
+         );
+
+    //Handles up to maxEvents events, stopping early at the first one
+    //after lastEvent's time, and returns the number handled.  This is the
+    //loop that runUntil and runEvents run, specialized on the policy.
+    template < class PolicyT >
+    int runKernel(
+         const EventClass &lastEvent,
+         const int maxEvents
+         );
+
+    //The entry points into the event handling specialized on one policy,
+    //for the public methods to call through.
+    struct KernelStruct
+    {
+      int (IntersectionSimulationClass::*runEvents)(const EventClass &,
+                                                    const int);
+      void (IntersectionSimulationClass::*handleEvent)(const EventClass &);
+      void (IntersectionSimulationClass::*scheduleArrival)(const int);
+      void (IntersectionSimulationClass::*scheduleLightChange)();
+    };
+
+    //Every policy's kernel, indexed by its KERNEL_INDEX.
+    static const KernelStruct KERNELS[NUM_SIMULATION_KERNELS];
+
+    //Returns the entry points of the given policy's kernel.
+    template < class PolicyT >
+    static KernelStruct makeKernel(
+         );
+
+    //Returns the kernel specialized on exactly the features this
+    //simulation uses, or the generic kernel if specializing is off.
+    const KernelStruct& getKernel(
+         ) const;
   public:
     //Explicit default ctor - sets the state of the sim to be NOT yet
     //setup properly.
-    IntersectionSimulationClass()
+    IntersectionSimulationClass(
+         ) : logTarget(std::cout.rdbuf()), eventLog(std::cout.rdbuf())
     {
       isSetupProperly = false;
       //no need to initialize other params here, since the isSetupProperly
       //boolean is used to indicate the other params can't be trusted yet.
 
-      //Set up the initial state of the simulation itself..
-      currentTime = 0;
-      currentLight = LIGHT_GREEN_EW;
+      signalController = NULL;
+      isSaturationFlow = false;
+      saturationHeadway = 1;
+      startupLostTime = 0;
+      hasProtectedLefts = false;
+      isUsingSubstreams = false;
+      isAntithetic = false;
+      leftTurnGreenTime = 0;
+      leftTurnYellowTime = 0;
+
+      for (int i = 0; i < NUM_DIRECTIONS; i++)
+      {
+        arrivalSamplers[i] = NULL;
+        leftTurnPercents[i] = 0;
+        rightTurnPercents[i] = 0;
+        storageCapacities[i] = 0;
+        storageBehaviors[i] = STORAGE_BLOCK;
+      }
 
-      //Initialize stats
-      maxEastQueueLength = 0;
-      maxWestQueueLength = 0;
-      maxNorthQueueLength = 0;
-      maxSouthQueueLength = 0;
-      numTotalAdvancedEast = 0;
-      numTotalAdvancedWest = 0;
-      numTotalAdvancedNorth = 0;
-      numTotalAdvancedSouth = 0;
+      isLogging = true;
+      isLogAsync = false;
+      isTraceDeferred = false;
+      isKernelSpecialized = true;
+
+      //Set up the initial state of the simulation itself, and its stats
+      restart();
+    }
+
+    //Frees any arrival samplers and signal controller that were created
+    //from the parameter file.
+    ~IntersectionSimulationClass(
+         )
+    {
+      for (int i = 0; i < NUM_DIRECTIONS; i++)
+      {
+        delete arrivalSamplers[i];
+      }
+      delete signalController;
     }
 
     //Returns true if this simulation is ready to be executed, false otherwise.
@@ -129,12 +539,63 @@ class IntersectionSimulationClass
     void printParameters(
          ) const;
 
+    //Sets the required simulation control parameters from a struct, as an
+    //alternative to readParametersFromFile that neither reads nor prints
+    //anything, and restarts the simulation.  Optional settings from an
+    //earlier parameter file are kept.  Returns false, leaving the
+    //simulation NOT setup properly, if any parameter is invalid.
+    bool setParameters(
+         const SimulationParamsStruct &inParams
+         );
+
+    //Chooses where random draws come from, and restarts the simulation:
+    //the shared rand() generator, or (inIsUsingSubstreams) a separate
+    //substream per purpose and direction, so runs with the same seed but
+    //different timings share their arrivals and drivers' decisions.  With
+    //inIsAntithetic, every draw is mirrored, giving the antithetic twin
+    //of the run with the same seed.
+    void setRandomStreams(
+         const bool inIsUsingSubstreams,
+         const bool inIsAntithetic
+         );
+
+    //Copies the required simulation control parameters into outParams.
+    void getParameters(
+         SimulationParamsStruct &outParams
+         ) const;
+
+    //Returns true if any optional parameter line other than randomStreams
+    //changed the simulation from the basic fixed-timing model of the
+    //required parameters, so a run depends on more than those and the
+    //random stream settings.
+    bool getUsesOptionalModelParameters(
+         ) const;
+
+    //Returns true if any optional parameter line changed the simulation
+    //from the basic fixed-timing model of the required parameters.
+    bool getUsesOptionalParameters(
+         ) const
+    {
+      return getUsesOptionalModelParameters() || isUsingSubstreams ||
+             isAntithetic;
+    }
+
+    //Returns true if a run writes files of its own (timeSeries or
+    //traceRecords lines), which simulations running side by side would
+    //all write over one another.
+    bool getWritesRunFiles(
+         ) const
+    {
+      return timeSeriesSampler.getIsEnabled() || isTraceDeferred;
+    }
+
     //Computes and returns the amount of time the light is red in the
     //east-west direction.
     int getEastWestRedTime(
          ) const
     {
-      return northSouthGreenTime + northSouthYellowTime;
+      return northSouthGreenTime + northSouthYellowTime +
+             getLeftTurnPhaseTimes();
     }
 
     //Computes and returns the amount of time the light is red in the
@@ -142,19 +603,154 @@ class IntersectionSimulationClass
     int getNorthSouthRedTime(
          ) const
     {
-      return eastWestGreenTime + eastWestYellowTime;
+      return eastWestGreenTime + eastWestYellowTime +
+             getLeftTurnPhaseTimes();
+    }
+
+    //Computes and returns the time per cycle taken up by the protected
+    //left turn phases of both directions, during which through traffic
+    //is stopped in every direction.
+    int getLeftTurnPhaseTimes(
+         ) const
+    {
+      if (!hasProtectedLefts)
+      {
+        return 0;
+      }
+      return 2 * (leftTurnGreenTime + leftTurnYellowTime);
+    }
+
+    //Sends the narration of events to the given stream, or discards it
+    //if outStream is NULL, which makes running silently nearly free.
+    //Parameter and statistics printing still goes to cout.  Narration
+    //held for the background thread is written out first.
+    void setLogStream(
+         std::ostream *outStream
+         );
+
+    //Chooses whether the narration is written to the log stream by a
+    //background thread, a buffer at a time, so a narrated run doesn't
+    //wait on the terminal or disk after every line.  The narration is
+    //complete once a run ends, or after flushLog; until then, nothing
+    //else should be written to the same stream.
+    void setIsLogAsync(
+         const bool inIsLogAsync
+         );
+
+    //Chooses whether the narration is recorded as compact trace records
+    //instead of being written to the log stream, leaving the formatting
+    //to when the records are rendered (see getTraceRecorder).  The
+    //records of the run so far are kept until the next restart.
+    void setIsTraceDeferred(
+         const bool inIsTraceDeferred
+         );
+
+    //Returns the narration recorded since the last restart, when it is
+    //deferred and not written to a trace file, for rendering on demand.
+    const TraceRecorderClass& getTraceRecorder(
+         ) const
+    {
+      return traceRecorder;
+    }
+
+    //Writes out any narration held for the background thread, waiting
+    //until it reaches the log stream.
+    void flushLog(
+         )
+    {
+      if (isLogAsync)
+      {
+        asyncLogBuffer.drain();
+      }
+    }
+
+    //Chooses whether events are handled by a kernel compiled for exactly
+    //the features in use (the default), or by the generic kernel that
+    //checks for every feature at run time.  The results are the same
+    //either way; only the speed differs.
+    void setIsKernelSpecialized(
+         const bool inIsKernelSpecialized
+         )
+    {
+      isKernelSpecialized = inIsKernelSpecialized;
+    }
+
+    //Puts the simulation back at time 0 with no events scheduled, empty
+    //queues and cleared statistics, keeping the parameters.  If they are
+    //set up properly, the random number generator is reseeded, so the
+    //same run can be repeated.
+    void restart(
+         );
+
+    //Returns the current time of the simulation.
+    int getCurrentTime(
+         ) const
+    {
+      return currentTime;
+    }
+
+    //Returns the light's LIGHT_* state.
+    int getCurrentLight(
+         ) const
+    {
+      return currentLight;
+    }
+
+    //Returns the total number of cars waiting in all lanes of an approach.
+    int getApproachQueueLength(
+         const int dirIdx
+         ) const;
+
+    //Returns a lane queue (direction times NUM_LANES plus the LANE_*
+    //lane) of the run in progress.
+    const RingQueueClass< CarClass >& getLaneQueue(
+         const int laneQueueIdx
+         ) const
+    {
+      return laneQueues[laneQueueIdx];
+    }
+
+    //Provides the next scheduled event, without handling it, via
+    //outEvent.  Returns false if no events are scheduled.
+    bool getNextEvent(
+         EventClass &outEvent
+         ) const
+    {
+      return eventList.getElemAtIndex(0, outEvent);
+    }
+
+    //Returns the number of events handled since the last restart.
+    int getNumEventsHandled(
+         ) const
+    {
+      return numEventsHandled;
+    }
+
+    //Returns the mean number of tics the cars advanced so far waited in
+    //their lane queues (from arriving, or entering from upstream, to
+    //advancing), or 0 if none has advanced.  With warm-up detection, only
+    //cars advanced after the warm-up was detected count.
+    double getMeanDelay(
+         ) const
+    {
+      return (numDelayedCars == 0) ? 0.0 : totalDelayTics / numDelayedCars;
     }
 
     //Schedules the first car arrival in each direction to "seed" the
-    //event driven simulation.
+    //event driven simulation, writing out the narration of it.
     void scheduleSeedEvents(
          )
     {
-      scheduleArrival(EAST_DIRECTION);
-      scheduleArrival(WEST_DIRECTION);
-      scheduleArrival(NORTH_DIRECTION);
-      scheduleArrival(SOUTH_DIRECTION);
-      scheduleLightChange();
+      const KernelStruct &kernel = getKernel();
+
+      isStarted = true;
+      (this->*kernel.scheduleArrival)(DIRECTION_EAST);
+      (this->*kernel.scheduleArrival)(DIRECTION_WEST);
+      (this->*kernel.scheduleArrival)(DIRECTION_NORTH);
+      (this->*kernel.scheduleArrival)(DIRECTION_SOUTH);
+      (this->*kernel.scheduleLightChange)();
+      //The seeding is narrated in full before the caller carries on
+      flushLog();
     }
 
     //Schedules an arrival event in the specified direction.
@@ -172,6 +768,103 @@ class IntersectionSimulationClass
     bool handleNextEvent(
          );
 
+    //Handles every event scheduled at or before the given time (or the
+    //simulation end time, if earlier), scheduling the seed events first
+    //if that hasn't been done.  Returns false once no events remain
+    //before the simulation end time, true if the run can continue.
+    //Unlike a handleNextEvent loop, each event costs only one combined
+    //peek-and-remove against the time limit, so with the log stream set
+    //to NULL this is the fastest way to run.
+    bool runUntil(
+         const int stopTime
+         );
+
+    //Handles up to numEvents events, scheduling the seed events first if
+    //that hasn't been done, and stopping early at the simulation end
+    //time, with the same tight loop as runUntil.  Returns the number of
+    //events handled.
+    int runEvents(
+         const int numEvents
+         );
+
+    //The original name of runEvents, kept for existing callers.
+    int step(
+         const int numEvents
+         )
+    {
+      return runEvents(numEvents);
+    }
+
+    //Handles events, with the same tight loop as runUntil, until the
+    //longest queue of the approach with the given DIRECTION_* index (or
+    //of any approach, given -1) has reached queueLength cars, or the
+    //simulation end time.  Returns true if the queue length was reached.
+    bool runUntilQueueLength(
+         const int dirIdx,
+         const int queueLength
+         );
+
+    //Returns true if the state of a run can be saved and restored, which
+    //is not the case while arrivals are replayed from a trace.
+    bool getCanSaveState(
+         ) const
+    {
+      return !arrivalTrace.getIsOpen();
+    }
+
+    //Copies the state of the run in progress into outState.  The state
+    //includes where every random stream is (the shared rand() generator
+    //as a count of its draws) and the next car id, so restoring it
+    //repeats the same future, narration and all, unless the streams are
+    //reseeded.
+    void saveState(
+         SimulationSnapshotStruct &outState
+         ) const;
+
+    //Copies the state of the run in progress into outState as saveState
+    //does, except for the lane queues, which are left as they were, for
+    //a caller that keeps the cars some other way (from getLaneQueue).
+    //Copying long queues is most of the cost of saving a state.
+    void saveStateWithoutQueues(
+         SimulationSnapshotStruct &outState
+         ) const;
+
+    //Puts the run back in a state saved by saveState, with these same
+    //parameters.  The event narration and its stream are unaffected.
+    //Without substreams, the shared rand() generator is moved back to
+    //where it was, which takes a draw for each of its draws since the
+    //seed (or since the current point, when moving forward).
+    void restoreState(
+         const SimulationSnapshotStruct &inState
+         );
+
+    //Returns true if each purpose draws from its own substream.
+    bool getIsUsingSubstreams(
+         ) const
+    {
+      return isUsingSubstreams;
+    }
+
+    //Returns true if every random draw is mirrored.
+    bool getIsAntithetic(
+         ) const
+    {
+      return isAntithetic;
+    }
+
+    //Reseeds every purpose's substream as the given trajectory's, so runs
+    //carried on from one saved state each get their own future.
+    //Trajectory 0 is the one restart seeds.  Does nothing unless
+    //substreams are in use.
+    void reseedSubstreams(
+         const int trajectoryNum
+         );
+
+    //Copies the statistics computed so far into outStats.
+    void getStatistics(
+         SimulationStatsStruct &outStats
+         ) const;
+
     //Prints the computed statistics from the simulation.
     void printStatistics(
          ) const;
@@ -0,0 +1,127 @@
+// James Zhu
+// October 2026
+// Implementation of the RandomStreamClass, a source of random draws that
+// either shares the rand() generator or has a substream of its own.
+
+#include <cstdlib>
+#include <stdint.h>
+using namespace std;
+
+#include "RandomStreamClass.h"
+#include "random.h"
+
+// Same construction as getPositiveNormal in random.cpp
+const int NUM_NORMAL_UNIFORMS = 12;
+const int NORMAL_UNIFORM_MAX = 1000;
+
+// Increment of the splitmix64 generator (the golden ratio times 2^64)
+const uint64_t SPLITMIX_GAMMA = ((uint64_t)0x9E3779B9u << 32) | 0x7F4A7C15u;
+const uint64_t SPLITMIX_MULT_1 = ((uint64_t)0xBF58476Du << 32) | 0x1CE4E5B9u;
+const uint64_t SPLITMIX_MULT_2 = ((uint64_t)0x94D049BBu << 32) | 0x133111EBu;
+
+// The splitmix64 output function, a strong 64-bit mixer
+static uint64_t mix64(uint64_t value) {
+    value = (value ^ (value >> 30)) * SPLITMIX_MULT_1;
+    value = (value ^ (value >> 27)) * SPLITMIX_MULT_2;
+    return value ^ (value >> 31);
+}
+
+__thread int64_t RandomStreamClass::numSharedDraws = 0;
+__thread int RandomStreamClass::sharedSeedVal = 0;
+
+RandomStreamClass::RandomStreamClass()
+ : isSubstream(false), isAntithetic(false), state(0) {}
+
+void RandomStreamClass::useSharedGenerator() {
+    isSubstream = false;
+}
+
+void RandomStreamClass::seedSubstream(const int seedVal,
+                                      const int streamId) {
+    // Mixing keeps substreams of nearby seeds and ids far apart in the
+    // generator's single long sequence
+    state = mix64(((uint64_t)(uint32_t)seedVal << 32) | (uint32_t)streamId);
+    isSubstream = true;
+}
+
+uint32_t RandomStreamClass::nextBits() {
+    state += SPLITMIX_GAMMA;
+    return (uint32_t)(mix64(state) >> 32);
+}
+
+int RandomStreamClass::drawBelow(const int numValues) {
+    if (isSubstream) {
+        return (int)(((uint64_t)nextBits() * (uint32_t)numValues) >> 32);
+    }
+    numSharedDraws++;
+    return rand() % numValues;
+}
+
+int RandomStreamClass::getUniform(const int minVal, const int maxVal) {
+    const int numValues = (maxVal + 1) - minVal;
+    int draw = drawBelow(numValues);
+
+    if (isAntithetic) {
+        draw = numValues - 1 - draw;
+    }
+    return draw + minVal;
+}
+
+double RandomStreamClass::getPositiveNormalReal(const double meanVal,
+                                                const double stdDev) {
+    if (!isSubstream && !isAntithetic) {
+        numSharedDraws += NUM_NORMAL_UNIFORMS;
+        return ::getPositiveNormalReal(meanVal, stdDev);
+    }
+
+    double sum = 0;
+    for (int i = 0; i < NUM_NORMAL_UNIFORMS; i++) {
+        int uni = drawBelow(NORMAL_UNIFORM_MAX + 1);
+        if (isAntithetic) {
+            uni = NORMAL_UNIFORM_MAX - uni;
+        }
+        sum += uni;
+    }
+    sum = sum / NORMAL_UNIFORM_MAX;
+    double newNormal = meanVal +
+                       stdDev * (sum - NUM_NORMAL_UNIFORMS * 0.5);
+
+    // Flipped positive, just like getPositiveNormal
+    if (newNormal < 0) {
+        newNormal *= -1;
+    }
+    return newNormal;
+}
+
+double RandomStreamClass::getUniformReal() {
+    if (isSubstream) {
+        uint32_t bits = nextBits();
+        if (isAntithetic) {
+            bits = 0xFFFFFFFFu - bits;
+        }
+        return (bits + 0.5) / 4294967296.0;
+    }
+
+    numSharedDraws++;
+    int draw = rand();
+    if (isAntithetic) {
+        draw = RAND_MAX - draw;
+    }
+    return (draw + 0.5) / ((double)RAND_MAX + 1.0);
+}
+
+void RandomStreamClass::seedSharedGenerator(const int seedVal) {
+    setSeed(seedVal);
+    sharedSeedVal = seedVal;
+    numSharedDraws = 0;
+}
+
+void RandomStreamClass::seekSharedGenerator(const int seedVal,
+                                            const int64_t numDraws) {
+    if (seedVal != sharedSeedVal || numDraws < numSharedDraws) {
+        seedSharedGenerator(seedVal);
+    }
+    for (; numSharedDraws < numDraws; numSharedDraws++) {
+        rand();
+    }
+}
@@ -0,0 +1,128 @@
+#ifndef _RANDOMSTREAMCLASS_H_
+#define _RANDOMSTREAMCLASS_H_
+
+#include <stdint.h>
+
+//Programmer: James Zhu
+//Date: October 2026
+//Purpose: One source of random draws for one purpose in the simulation
+//         (say, the arrivals of one direction), offering the same draws
+//         as random.h.  By default a stream just forwards to the shared
+//         rand() generator, so every stream interleaves its draws with
+//         the others exactly as before.
+//
+//         A stream can instead be seeded as its own substream, with a
+//         private 64-bit generator (splitmix64) whose seed is mixed from
+//         the run's seed and the stream's id.  Then a purpose's k-th draw
+//         is the same however the other purposes' draws fall around it,
+//         so two runs compared with the same seed see the same arrivals
+//         and the same drivers' yellow decisions (common random numbers).
+//
+//         Either way, a stream can be made antithetic: every underlying
+//         uniform u is replaced by 1 - u (an integer x in [min, max] by
+//         min + max - x), so a run paired with its antithetic twin has
+//         negatively correlated noise and their average varies less.
+class RandomStreamClass
+{
+  private:
+    bool isSubstream; //Whether draws come from the private generator
+                      //below rather than the shared rand() generator
+    bool isAntithetic; //Whether every uniform is mirrored
+    uint64_t state; //State of the private generator
+
+    static __thread int64_t numSharedDraws; //rand() values drawn through
+                                            //streams on this thread since
+                                            //the shared generator was
+                                            //last seeded
+    static __thread int sharedSeedVal; //Seed it was last given
+
+    //Returns the next 32 random bits of the private generator.
+    uint32_t nextBits(
+         );
+
+    //Returns an integer uniform over [0, numValues), before any mirroring.
+    int drawBelow(
+         const int numValues
+         );
+
+  public:
+    //Creates a stream that forwards to the shared rand() generator.
+    RandomStreamClass(
+         );
+
+    //Makes this stream forward to the shared rand() generator.
+    void useSharedGenerator(
+         );
+
+    //Makes this stream its own substream, seeded from the run's seed and
+    //a stream id that is different for every purpose.
+    void seedSubstream(
+         const int seedVal,
+         const int streamId
+         );
+
+    //Sets whether every draw is mirrored.
+    void setIsAntithetic(
+         const bool inIsAntithetic
+         )
+    {
+      isAntithetic = inIsAntithetic;
+    }
+
+    //Returns true if this stream has its own generator.
+    bool getIsSubstream(
+         ) const
+    {
+      return isSubstream;
+    }
+
+    //As getUniform in random.h.
+    int getUniform(
+         const int minVal,
+         const int maxVal
+         );
+
+    //As getPositiveNormal in random.h.
+    int getPositiveNormal(
+         const double meanVal,
+         const double stdDev
+         )
+    {
+      return (int)getPositiveNormalReal(meanVal, stdDev);
+    }
+
+    //As getPositiveNormalReal in random.h.
+    double getPositiveNormalReal(
+         const double meanVal,
+         const double stdDev
+         );
+
+    //As getUniformReal in random.h.
+    double getUniformReal(
+         );
+
+    //Seeds the shared rand() generator, as setSeed in random.h does, and
+    //starts counting the values drawn from it through streams.
+    static void seedSharedGenerator(
+         const int seedVal
+         );
+
+    //Returns the number of rand() values drawn through streams since the
+    //shared generator was last seeded.
+    static int64_t getNumSharedDraws(
+         )
+    {
+      return numSharedDraws;
+    }
+
+    //Puts the shared rand() generator where it was after numDraws draws
+    //since being seeded with seedVal, so the draws that follow repeat.
+    //Moving forward from the current draw with the same seed only draws
+    //the difference; anything else reseeds and draws all numDraws.
+    static void seekSharedGenerator(
+         const int seedVal,
+         const int64_t numDraws
+         );
+};
+
+#endif // _RANDOMSTREAMCLASS_H_
@@ -0,0 +1,160 @@
+// James Zhu
+// October 2026
+// Implementation of the RareEventSplitterClass, which estimates rare
+// queue-length probabilities by multilevel splitting.
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+using namespace std;
+
+#include "RareEventSplitterClass.h"
+
+RareEventSplitterClass::RareEventSplitterClass() : runsPerLevel(0) {}
+
+bool RareEventSplitterClass::setup(const vector< int > &inLevels,
+                                   const int inRunsPerLevel) {
+    bool isValid = (!inLevels.empty() && inRunsPerLevel > 0);
+
+    for (int i = 0; isValid && i < (int)inLevels.size(); i++) {
+        if (inLevels[i] <= 0 || (i > 0 && inLevels[i] <= inLevels[i - 1])) {
+            isValid = false;
+        }
+    }
+    levelHits.clear();
+    if (!isValid) {
+        levels.clear();
+        runsPerLevel = 0;
+        return false;
+    }
+    levels = inLevels;
+    runsPerLevel = inRunsPerLevel;
+    return true;
+}
+
+bool RareEventSplitterClass::setupEvenLevels(const int targetLength,
+                                             const int numLevels,
+                                             const int inRunsPerLevel) {
+    vector< int > evenLevels;
+
+    if (numLevels <= 0 || numLevels > targetLength) {
+        return setup(evenLevels, 0);
+    }
+    for (int i = 1; i <= numLevels; i++) {
+        // Rounded to the nearest car; distinct since the spacing is >= 1
+        evenLevels.push_back((int)((double)targetLength * i / numLevels +
+                                   0.5));
+    }
+    return setup(evenLevels, inRunsPerLevel);
+}
+
+bool RareEventSplitterClass::run(IntersectionSimulationClass &simObj,
+                                 const int dirIdx) {
+    vector< SimulationSnapshotStruct > startStates;
+    vector< SimulationSnapshotStruct > hitStates;
+    int trajectoryNum = 0;
+
+    levelHits.clear();
+    if (levels.empty() || !simObj.getIsSetupProperly() ||
+        !simObj.getCanSaveState() || !simObj.getIsUsingSubstreams()) {
+        return false;
+    }
+
+    for (int levelIdx = 0; levelIdx < (int)levels.size(); levelIdx++) {
+        int numHits = 0;
+
+        hitStates.clear();
+        hitStates.reserve(runsPerLevel);
+        for (int i = 0; i < runsPerLevel; i++) {
+            // The first stage starts every run from time 0; later ones
+            // share the saved states out as evenly as possible
+            if (levelIdx == 0) {
+                simObj.restart();
+            }
+            else {
+                simObj.restoreState(startStates[i % startStates.size()]);
+            }
+            trajectoryNum++;
+            simObj.reseedSubstreams(trajectoryNum);
+
+            if (simObj.runUntilQueueLength(dirIdx, levels[levelIdx])) {
+                numHits++;
+                hitStates.push_back(SimulationSnapshotStruct());
+                simObj.saveState(hitStates.back());
+            }
+        }
+        levelHits.push_back(numHits);
+        if (numHits == 0) {
+            break;
+        }
+        startStates.swap(hitStates);
+    }
+    return true;
+}
+
+double RareEventSplitterClass::getLevelProbability(
+    const int levelIdx) const {
+    return (double)levelHits[levelIdx] / runsPerLevel;
+}
+
+double RareEventSplitterClass::getProbability() const {
+    double probability = 1;
+
+    if (levelHits.empty()) {
+        return 0;
+    }
+    for (int i = 0; i < (int)levelHits.size(); i++) {
+        probability *= getLevelProbability(i);
+    }
+    return probability;
+}
+
+double RareEventSplitterClass::getRelativeError() const {
+    double relativeVariance = 0;
+
+    if (getProbability() <= 0) {
+        return 0;
+    }
+    // Relative variances of independent factors add, to first order
+    for (int i = 0; i < (int)levelHits.size(); i++) {
+        double levelProbability = getLevelProbability(i);
+        relativeVariance += (1 - levelProbability) /
+                            (runsPerLevel * levelProbability);
+    }
+    return sqrt(relativeVariance);
+}
+
+double RareEventSplitterClass::getEquivalentPlainRuns() const {
+    double probability = getProbability();
+    double relativeError = getRelativeError();
+
+    if (probability <= 0) {
+        return 0;
+    }
+    // A plain estimate from n runs has relative variance (1 - p) / (n p)
+    if (relativeError <= 0) {
+        return 1 / probability;
+    }
+    return (1 - probability) /
+           (probability * relativeError * relativeError);
+}
+
+void RareEventSplitterClass::print(ostream &outStream) const {
+    for (int i = 0; i < (int)levelHits.size(); i++) {
+        outStream << "Level " << i + 1 << ": queue length " << levels[i] <<
+                     ", reached by " << levelHits[i] << " of " <<
+                     runsPerLevel << " runs (" << getLevelProbability(i) <<
+                     ")" << endl;
+    }
+    if (getProbability() <= 0) {
+        outStream << "No run reached level " << levelHits.size() <<
+                     ", so the probability is estimated as 0" << endl;
+        return;
+    }
+    outStream << "Probability of reaching queue length " << levels.back() <<
+                 ": " << getProbability() << " (relative error " <<
+                 getRelativeError() << ")" << endl;
+    outStream << "Runs used: " << getNumRuns() << ", plain runs needed "
+                 "for the same precision: " << getEquivalentPlainRuns() <<
+                 endl;
+}
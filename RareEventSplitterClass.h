@@ -0,0 +1,119 @@
+#ifndef _RAREEVENTSPLITTERCLASS_H_
+#define _RAREEVENTSPLITTERCLASS_H_
+
+#include <iostream>
+#include <vector>
+
+#include "IntersectionSimulationClass.h"
+
+//Programmer: James Zhu
+//Date: October 2026
+//Purpose: Estimates the probability that a queue ever reaches a length
+//         so rare that plain runs almost never see it (say, the storage
+//         of the approach, when reaching it means spillback), by fixed-
+//         effort multilevel splitting.  The target length is reached in
+//         stages through increasing intermediate levels.  Each stage
+//         carries on runsPerLevel runs from the states saved when the
+//         previous stage's runs first reached its level, picked in turn,
+//         and every run gets substreams of its own so runs started from
+//         the same state go their own ways.  The probability of reaching
+//         the target is the product of the fractions of runs reaching
+//         each level, each of which is far from rare.
+//
+//         A stage's runs each end at the simulation end time if they
+//         don't reach the level, so the estimate is of the probability
+//         of reaching the target length before then.
+class RareEventSplitterClass
+{
+  private:
+    std::vector< int > levels; //Queue lengths of the stages, increasing,
+                               //the last being the target length
+    int runsPerLevel; //Runs carried on in each stage
+    std::vector< int > levelHits; //Runs of each stage done so far that
+                                  //reached its level
+
+  public:
+    //Creates a splitter with no levels.
+    RareEventSplitterClass(
+         );
+
+    //Sets the levels, which must be increasing positive queue lengths,
+    //and the runs per stage, which must be positive.  Returns false if
+    //either is invalid, leaving the splitter without levels.
+    bool setup(
+         const std::vector< int > &inLevels,
+         const int inRunsPerLevel
+         );
+
+    //Sets numLevels levels spaced evenly up to targetLength, and the runs
+    //per stage.  Returns false if they can't be set, as setup does.
+    bool setupEvenLevels(
+         const int targetLength,
+         const int numLevels,
+         const int inRunsPerLevel
+         );
+
+    //Estimates the probability that the longest queue of the approach
+    //with the given DIRECTION_* index (or of any approach, given -1)
+    //reaches the target length.  The simulation must be set up properly,
+    //able to save its state and using substreams.  Returns false, having
+    //run nothing, if not.  Stops early if a stage has no hits, as the
+    //estimate is then 0.
+    bool run(
+         IntersectionSimulationClass &simObj,
+         const int dirIdx
+         );
+
+    //Returns the number of levels.
+    int getNumLevels(
+         ) const
+    {
+      return (int)levels.size();
+    }
+
+    //Returns the number of stages run by the last run, up to the number
+    //of levels.
+    int getNumLevelsRun(
+         ) const
+    {
+      return (int)levelHits.size();
+    }
+
+    //Returns the total number of runs carried on by the last run.
+    int getNumRuns(
+         ) const
+    {
+      return getNumLevelsRun() * runsPerLevel;
+    }
+
+    //Returns the fraction of the given stage's runs that reached its
+    //level, an estimate of the probability of reaching it from the
+    //level before.
+    double getLevelProbability(
+         const int levelIdx
+         ) const;
+
+    //Returns the estimated probability of reaching the target length.
+    double getProbability(
+         ) const;
+
+    //Returns the estimated relative standard error of the probability,
+    //treating the stages as independent, which ignores the correlation
+    //of runs sharing a start state and so is somewhat optimistic.
+    double getRelativeError(
+         ) const;
+
+    //Returns how many independent plain runs would be needed to estimate
+    //the same probability with the same relative error, or 0 if the
+    //estimate is 0.
+    double getEquivalentPlainRuns(
+         ) const;
+
+    //Prints every level, its hits and its conditional probability, then
+    //the estimate, its relative error and the effort it saved.
+    void print(
+         std::ostream &outStream
+         ) const;
+};
+
+#endif // _RAREEVENTSPLITTERCLASS_H_
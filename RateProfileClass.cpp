@@ -0,0 +1,136 @@
+// James Zhu
+// October 2026
+// Implementation of the RateProfileClass, which maps arrival gaps drawn
+// in operational time back onto simulation time.
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <climits>
+using namespace std;
+
+#include "RateProfileClass.h"
+
+RateProfileClass::RateProfileClass()
+ : isActive(false), period(0), lastOperationalTime(0),
+   cursorPeriodNum(0), cursorSegment(0), isPastLastTime(false) {}
+
+bool RateProfileClass::setSegments(const int inPeriod,
+                                   const vector< double > &inStarts,
+                                   const vector< double > &inMults) {
+    bool anyPositive = false;
+
+    isActive = false;
+    if (inPeriod < 0 || inStarts.empty() ||
+        inStarts.size() != inMults.size() || inStarts[0] != 0) {
+        return false;
+    }
+    for (unsigned int i = 0; i < inStarts.size(); i++) {
+        if (inMults[i] < 0 ||
+            (i > 0 && inStarts[i] <= inStarts[i - 1]) ||
+            (inPeriod > 0 && inStarts[i] >= inPeriod)) {
+            return false;
+        }
+        anyPositive = anyPositive || (inMults[i] > 0);
+    }
+    if (!anyPositive) {
+        return false;
+    }
+
+    period = inPeriod;
+    segmentStarts = inStarts;
+    segmentMults = inMults;
+
+    // Precompute M(t) at each segment start, and at the end of the period
+    cumulativeRates.assign(inStarts.size() + 1, 0.0);
+    for (unsigned int i = 1; i < inStarts.size(); i++) {
+        cumulativeRates[i] = cumulativeRates[i - 1] +
+            inMults[i - 1] * (inStarts[i] - inStarts[i - 1]);
+    }
+    if (period > 0) {
+        cumulativeRates[inStarts.size()] =
+            cumulativeRates[inStarts.size() - 1] +
+            inMults[inStarts.size() - 1] * (period - inStarts.back());
+    }
+
+    lastOperationalTime = 0;
+    cursorPeriodNum = 0;
+    cursorSegment = 0;
+    isPastLastTime = false;
+    isActive = true;
+    return true;
+}
+
+void RateProfileClass::restart() {
+    lastOperationalTime = 0;
+    cursorPeriodNum = 0;
+    cursorSegment = 0;
+    isPastLastTime = false;
+}
+
+bool RateProfileClass::advanceArrival(const double gap, int &outTime) {
+    const int numSegments = segmentStarts.size();
+    double periodNum = 0;
+    double withinPeriod = 0;
+
+    lastOperationalTime += gap;
+    if (!isActive) {
+        // A later time would wrap around to a time in the past
+        if (lastOperationalTime > INT_MAX) {
+            isPastLastTime = true;
+            return false;
+        }
+        outTime = (int)lastOperationalTime;
+        return true;
+    }
+
+    // Split operational time into whole periods plus a remainder.  This is
+    // a division rather than a scan, so huge gaps still cost O(1).
+    if (period > 0) {
+        periodNum = floor(lastOperationalTime / cumulativeRates[numSegments]);
+        withinPeriod = lastOperationalTime -
+                       periodNum * cumulativeRates[numSegments];
+    }
+    else {
+        withinPeriod = lastOperationalTime;
+    }
+
+    // Operational time never decreases, so the segment can only be at or
+    // after the cursor unless a new period has started.
+    if (periodNum != cursorPeriodNum) {
+        cursorPeriodNum = periodNum;
+        cursorSegment = 0;
+    }
+    while (cursorSegment + 1 < numSegments &&
+           cumulativeRates[cursorSegment + 1] <= withinPeriod) {
+        cursorSegment++;
+    }
+
+    // Zero-rate segments have no operational length, so the loop above
+    // skips them.  Only a zero-rate final segment of a non-periodic
+    // profile can still be selected, and that means no more arrivals.
+    if (segmentMults[cursorSegment] <= 0) {
+        return false;
+    }
+
+    double realTime = periodNum * period + segmentStarts[cursorSegment] +
+        (withinPeriod - cumulativeRates[cursorSegment]) /
+        segmentMults[cursorSegment];
+    if (realTime > INT_MAX) {
+        isPastLastTime = true;
+        return false;
+    }
+    outTime = (int)realTime;
+    return true;
+}
+
+void RateProfileClass::print(ostream &outStream) const {
+    if (!isActive) {
+        outStream << "constant";
+        return;
+    }
+    outStream << "period: " << period << " segments:";
+    for (unsigned int i = 0; i < segmentStarts.size(); i++) {
+        outStream << " [" << segmentStarts[i] << "] x" << segmentMults[i];
+    }
+}
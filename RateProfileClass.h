@@ -0,0 +1,93 @@
+#ifndef _RATEPROFILECLASS_H_
+#define _RATEPROFILECLASS_H_
+
+#include <iostream>
+#include <vector>
+
+//Programmer: James Zhu
+//Date: October 2026
+//Purpose: A piecewise-constant, optionally periodic, arrival rate profile
+//         for one direction of the intersection.  Each segment gives a
+//         multiplier on the base arrival rate (1.0 is the rate implied by
+//         the direction's arrival distribution, 2.0 is twice as many cars,
+//         0.0 is none).
+//
+//         Arrivals are generated by time-change inversion: interarrival
+//         gaps are still drawn from the direction's distribution, but are
+//         measured in "operational time" M(t), the integral of the
+//         multiplier.  The cumulative integral is precomputed at every
+//         segment boundary, and since simulation time only moves forward
+//         a cursor into that table makes each inversion O(1) amortized.
+//         No draws are ever rejected, so a run with a profile consumes
+//         exactly as many random numbers per arrival as a stationary one.
+class RateProfileClass
+{
+  private:
+    bool isActive; //False means the identity profile (constant rate)
+    int period; //Length of one repetition of the profile, or 0 if the
+                //last segment simply extends forever
+    std::vector< double > segmentStarts; //Start time of each segment,
+                                         //within one period
+    std::vector< double > segmentMults; //Rate multiplier of each segment
+    std::vector< double > cumulativeRates; //M(t) at each segment start,
+                                           //plus M(period) at the end
+    double lastOperationalTime; //M(t) at the most recent arrival
+    double cursorPeriodNum; //Period the cursor below refers to
+    int cursorSegment; //Segment containing the most recent arrival
+    bool isPastLastTime; //Whether an arrival fell after the last time an
+                         //int can hold, ending arrivals
+
+  public:
+    //Creates an inactive (constant rate) profile.
+    RateProfileClass(
+         );
+
+    //Sets up the profile from parallel arrays of segment start times
+    //and multipliers.  The first start must be 0, starts must strictly
+    //increase (and be less than the period when periodic), multipliers
+    //must be non-negative, and at least one must be positive.  Returns
+    //false, leaving the profile inactive, if any of this is violated.
+    bool setSegments(
+         const int inPeriod,
+         const std::vector< double > &inStarts,
+         const std::vector< double > &inMults
+         );
+
+    //Returns true if this profile changes the arrival rate over time.
+    bool getIsActive(
+         ) const
+    {
+      return isActive;
+    }
+
+    //Advances this direction's operational clock by the given gap (as
+    //drawn from the arrival distribution) and provides the simulation
+    //time of the resulting arrival via outTime.  Returns false if the
+    //rate drops to zero for good, or the arrival would be after INT_MAX
+    //(see getIsPastLastTime), and no further arrival will occur.
+    //An inactive profile just accumulates the gaps, so fractional gaps
+    //are not lost to truncation.
+    bool advanceArrival(
+         const double gap,
+         int &outTime
+         );
+
+    //Returns true if arrivals ended because the last one advanceArrival
+    //worked out was after INT_MAX, rather than because the rate is zero.
+    bool getIsPastLastTime(
+         ) const
+    {
+      return isPastLastTime;
+    }
+
+    //Moves the operational clock back to time 0, to start a new run.
+    void restart(
+         );
+
+    //Prints the segments of this profile on a single line.
+    void print(
+         std::ostream &outStream
+         ) const;
+};
+
+#endif // _RATEPROFILECLASS_H_
@@ -0,0 +1,121 @@
+// James Zhu
+// October 2026
+// Implementation of the ReplicationRunnerClass, which runs replications
+// on several threads and reduces their statistics in a fixed order.
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+using namespace std;
+
+#include <pthread.h>
+
+#include "ReplicationRunnerClass.h"
+
+ReplicationRunnerClass::ReplicationRunnerClass()
+ : numReplications(0), nextLeafIdx(0) {
+    pthread_mutex_init(&leafMutex, NULL);
+}
+
+ReplicationRunnerClass::~ReplicationRunnerClass() {
+    pthread_mutex_destroy(&leafMutex);
+}
+
+bool ReplicationRunnerClass::setup(const string &paramFname,
+                                   const int numThreads) {
+    if (!simPool.setup(paramFname, numThreads)) {
+        return false;
+    }
+    simPool.getSimulation(0).getParameters(baseParams);
+    return true;
+}
+
+bool ReplicationRunnerClass::run(const int inNumReplications) {
+    const int numThreads = getNumThreads();
+    vector< pthread_t > threads(numThreads);
+    vector< WorkerStruct > workers(numThreads);
+    int numStarted = 0;
+
+    totalStats = ReplicationStatsClass();
+    if (numThreads == 0 || inNumReplications <= 0) {
+        return false;
+    }
+    numReplications = inNumReplications;
+    leafStats.assign((numReplications + REPLICATION_LEAF_SIZE - 1) /
+                     REPLICATION_LEAF_SIZE, ReplicationStatsClass());
+    nextLeafIdx = 0;
+
+    for (int i = 0; i < numThreads; i++) {
+        workers[i].runner = this;
+        workers[i].simObj = &simPool.getSimulation(i);
+        if (pthread_create(&threads[i], NULL, runWorker, &workers[i]) != 0) {
+            break;
+        }
+        numStarted++;
+    }
+    for (int i = 0; i < numStarted; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    if (numStarted < numThreads) {
+        return false;
+    }
+
+    totalStats = mergeLeaves(0, (int)leafStats.size());
+    leafStats.clear();
+    return true;
+}
+
+void* ReplicationRunnerClass::runWorker(void *workerPtr) {
+    WorkerStruct *worker = (WorkerStruct *)workerPtr;
+
+    for (int leafIdx = worker->runner->takeLeaf(); leafIdx >= 0;
+         leafIdx = worker->runner->takeLeaf()) {
+        worker->runner->runLeaf(*worker->simObj, leafIdx);
+    }
+    return NULL;
+}
+
+int ReplicationRunnerClass::takeLeaf() {
+    int leafIdx = -1;
+
+    pthread_mutex_lock(&leafMutex);
+    if (nextLeafIdx < (int)leafStats.size()) {
+        leafIdx = nextLeafIdx;
+        nextLeafIdx++;
+    }
+    pthread_mutex_unlock(&leafMutex);
+    return leafIdx;
+}
+
+void ReplicationRunnerClass::runLeaf(IntersectionSimulationClass &simObj,
+                                     const int leafIdx) {
+    const int firstRep = leafIdx * REPLICATION_LEAF_SIZE;
+    const int endRep = min(firstRep + REPLICATION_LEAF_SIZE,
+                           numReplications);
+    SimulationParamsStruct params = baseParams;
+    SimulationStatsStruct stats;
+    ReplicationStatsClass summary;
+
+    for (int rep = firstRep; rep < endRep; rep++) {
+        params.randomSeedVal = baseParams.randomSeedVal + rep;
+        simObj.setParameters(params);
+        simObj.runUntil(params.timeToStopSim);
+        simObj.getStatistics(stats);
+        summary.addRun(stats);
+    }
+    // Each leaf is written by the one thread that took it, and read only
+    // after every thread has been joined
+    leafStats[leafIdx] = summary;
+}
+
+ReplicationStatsClass ReplicationRunnerClass::mergeLeaves(
+    const int firstLeaf, const int endLeaf) const {
+    if (endLeaf - firstLeaf == 1) {
+        return leafStats[firstLeaf];
+    }
+    const int midLeaf = firstLeaf + (endLeaf - firstLeaf) / 2;
+    ReplicationStatsClass summary = mergeLeaves(firstLeaf, midLeaf);
+    summary.merge(mergeLeaves(midLeaf, endLeaf));
+    return summary;
+}
@@ -0,0 +1,121 @@
+#ifndef _REPLICATIONRUNNERCLASS_H_
+#define _REPLICATIONRUNNERCLASS_H_
+
+#include <string>
+#include <vector>
+#include <pthread.h>
+
+#include "IntersectionSimulationClass.h"
+#include "ReplicationStatsClass.h"
+#include "SimulationPoolClass.h"
+
+//Consecutive replications summarized together before any merging.  The
+//reduction tree is shaped by this and the number of replications only,
+//never by the number of threads.
+const int REPLICATION_LEAF_SIZE = 16;
+
+//Programmer: James Zhu
+//Date: October 2026
+//Purpose: Runs many replications of one parameter file on several
+//         threads and summarizes their statistics, with the summary
+//         exactly the same, bit for bit, whatever the number of threads.
+//
+//         Replication r runs the file's parameters with the random seed
+//         increased by r, and every purpose draws from its own
+//         substream, so each replication's statistics depend on its seed
+//         alone and not on which thread runs it or what ran before.
+//         Replications are grouped into leaves of REPLICATION_LEAF_SIZE
+//         in order; threads take whole leaves, summarizing each one's
+//         replications in order.  The leaf summaries are then merged
+//         pairwise in a fixed balanced tree over the leaf numbers, so the
+//         floating-point operations and their order are always the same.
+class ReplicationRunnerClass
+{
+  private:
+    SimulationPoolClass simPool; //One simulation per thread
+    SimulationParamsStruct baseParams; //Parameters of replication 0
+
+    int numReplications; //Replications of the run in progress
+    std::vector< ReplicationStatsClass > leafStats; //Summary of each leaf
+    int nextLeafIdx; //Next leaf a thread will take
+    pthread_mutex_t leafMutex; //Guards nextLeafIdx
+    ReplicationStatsClass totalStats; //Summary of every replication
+
+    //What one thread is given to work with
+    struct WorkerStruct
+    {
+      ReplicationRunnerClass *runner;
+      IntersectionSimulationClass *simObj;
+    };
+
+    //Thread body: runs leaves with the given simulation until none is
+    //left.  The argument is a WorkerStruct.
+    static void* runWorker(
+         void *workerPtr
+         );
+
+    //Returns the next leaf to run, or -1 if none is left.
+    int takeLeaf(
+         );
+
+    //Runs every replication of a leaf in order, summarizing them.
+    void runLeaf(
+         IntersectionSimulationClass &simObj,
+         const int leafIdx
+         );
+
+    //Returns the summary of leaves [firstLeaf, endLeaf), merging the two
+    //halves of the range recursively.
+    ReplicationStatsClass mergeLeaves(
+         const int firstLeaf,
+         const int endLeaf
+         ) const;
+
+    //Copying would share the simulations; not allowed.
+    ReplicationRunnerClass(
+         const ReplicationRunnerClass &other
+         );
+    ReplicationRunnerClass& operator=(
+         const ReplicationRunnerClass &other
+         );
+
+  public:
+    //Creates a runner without simulations.
+    ReplicationRunnerClass(
+         );
+
+    ~ReplicationRunnerClass(
+         );
+
+    //Reads the parameter file into one simulation per thread (see
+    //SimulationPoolClass).  Returns false, keeping no simulations, if the
+    //number of threads isn't positive, the file doesn't set the
+    //simulation up properly or its runs write files.
+    bool setup(
+         const std::string &paramFname,
+         const int numThreads
+         );
+
+    //Returns the number of threads replications are run on.
+    int getNumThreads(
+         ) const
+    {
+      return simPool.getNumSimulations();
+    }
+
+    //Runs the given number of replications and summarizes them.  Returns
+    //false if it isn't set up, the number isn't positive or a thread
+    //can't be started.
+    bool run(
+         const int inNumReplications
+         );
+
+    //Returns the summary of the last run's replications.
+    const ReplicationStatsClass& getStats(
+         ) const
+    {
+      return totalStats;
+    }
+};
+
+#endif // _REPLICATIONRUNNERCLASS_H_
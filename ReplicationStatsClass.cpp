@@ -0,0 +1,157 @@
+// James Zhu
+// October 2026
+// Implementation of the mergeable summaries of replication statistics.
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <stdint.h>
+using namespace std;
+
+#include "ReplicationStatsClass.h"
+
+// Upper quantiles of the longest queues printed along with the median
+const int NUM_PRINTED_QUANTILES = 3;
+const double PRINTED_QUANTILES[NUM_PRINTED_QUANTILES] = { 0.5, 0.9, 0.99 };
+// Significant digits printed, enough to tell summaries apart that differ
+// only by the order they were merged in
+const int PRINTED_PRECISION = 12;
+
+RunningStatsClass::RunningStatsClass()
+ : count(0), mean(0), sumSquaredDevs(0), minVal(0), maxVal(0) {}
+
+void RunningStatsClass::add(const double value) {
+    count++;
+    const double delta = value - mean;
+    mean += delta / count;
+    sumSquaredDevs += delta * (value - mean);
+    if (count == 1 || value < minVal) {
+        minVal = value;
+    }
+    if (count == 1 || value > maxVal) {
+        maxVal = value;
+    }
+}
+
+void RunningStatsClass::merge(const RunningStatsClass &other) {
+    if (other.count == 0) {
+        return;
+    }
+    if (count == 0) {
+        *this = other;
+        return;
+    }
+    const double totalCount = (double)(count + other.count);
+    const double delta = other.mean - mean;
+    mean += delta * other.count / totalCount;
+    sumSquaredDevs += other.sumSquaredDevs +
+                      delta * delta * count * other.count / totalCount;
+    minVal = min(minVal, other.minVal);
+    maxVal = max(maxVal, other.maxVal);
+    count += other.count;
+}
+
+double RunningStatsClass::getVariance() const {
+    return (count < 2) ? 0 : sumSquaredDevs / (count - 1);
+}
+
+double RunningStatsClass::getStdError() const {
+    return (count < 2) ? 0 : sqrt(getVariance() / count);
+}
+
+CountHistogramClass::CountHistogramClass() : count(0) {}
+
+void CountHistogramClass::add(const int value) {
+    const int bin = max(value, 0);
+    if (bin >= (int)valueCounts.size()) {
+        valueCounts.resize(bin + 1, 0);
+    }
+    valueCounts[bin]++;
+    count++;
+}
+
+void CountHistogramClass::merge(const CountHistogramClass &other) {
+    if (other.valueCounts.size() > valueCounts.size()) {
+        valueCounts.resize(other.valueCounts.size(), 0);
+    }
+    for (int i = 0; i < (int)other.valueCounts.size(); i++) {
+        valueCounts[i] += other.valueCounts[i];
+    }
+    count += other.count;
+}
+
+int CountHistogramClass::getQuantile(const double fraction) const {
+    // Smallest count of occurrences the answer must cover, at least one
+    const int64_t needed = max((int64_t)ceil(fraction * count), (int64_t)1);
+    int64_t covered = 0;
+
+    for (int i = 0; i < (int)valueCounts.size(); i++) {
+        covered += valueCounts[i];
+        if (covered >= needed) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+void ReplicationStatsClass::addRun(const SimulationStatsStruct &stats) {
+    int totalAdvanced = 0;
+
+    for (int d = 0; d < NUM_DIRECTIONS; d++) {
+        metricStats[REPLICATION_MAX_QUEUE_FIRST + d].add(
+            stats.maxQueueLengths[d]);
+        metricStats[REPLICATION_ADVANCED_FIRST + d].add(
+            stats.numTotalAdvanced[d]);
+        maxQueueHistograms[d].add(stats.maxQueueLengths[d]);
+        totalAdvanced += stats.numTotalAdvanced[d];
+    }
+    metricStats[REPLICATION_TOTAL_ADVANCED].add(totalAdvanced);
+}
+
+void ReplicationStatsClass::merge(const ReplicationStatsClass &other) {
+    for (int i = 0; i < NUM_REPLICATION_METRICS; i++) {
+        metricStats[i].merge(other.metricStats[i]);
+    }
+    for (int d = 0; d < NUM_DIRECTIONS; d++) {
+        maxQueueHistograms[d].merge(other.maxQueueHistograms[d]);
+    }
+}
+
+string ReplicationStatsClass::getMetricName(const int metricIdx) {
+    if (metricIdx == REPLICATION_TOTAL_ADVANCED) {
+        return "Total cars advanced";
+    }
+    if (metricIdx >= REPLICATION_ADVANCED_FIRST) {
+        return "Cars advanced " +
+               DIRECTION_BOUND_LABELS[metricIdx - REPLICATION_ADVANCED_FIRST];
+    }
+    return "Longest queue " +
+           DIRECTION_BOUND_LABELS[metricIdx - REPLICATION_MAX_QUEUE_FIRST];
+}
+
+void ReplicationStatsClass::print(ostream &outStream) const {
+    const streamsize oldPrecision = outStream.precision(PRINTED_PRECISION);
+
+    outStream << "Replications: " << getNumRuns() << endl;
+    for (int i = 0; i < NUM_REPLICATION_METRICS; i++) {
+        const RunningStatsClass &stats = metricStats[i];
+        outStream << getMetricName(i) << ": mean " << stats.getMean() <<
+                     " std dev " << sqrt(stats.getVariance()) <<
+                     " std error " << stats.getStdError() <<
+                     " min " << stats.getMin() <<
+                     " max " << stats.getMax() << endl;
+    }
+    for (int d = 0; d < NUM_DIRECTIONS; d++) {
+        outStream << "Longest queue " << DIRECTION_BOUND_LABELS[d] <<
+                     " quantiles:";
+        for (int q = 0; q < NUM_PRINTED_QUANTILES; q++) {
+            outStream << " " << PRINTED_QUANTILES[q] * 100 << "% " <<
+                         maxQueueHistograms[d].getQuantile(
+                             PRINTED_QUANTILES[q]);
+        }
+        outStream << endl;
+    }
+    outStream.precision(oldPrecision);
+}
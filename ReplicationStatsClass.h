@@ -0,0 +1,189 @@
+#ifndef _REPLICATIONSTATSCLASS_H_
+#define _REPLICATIONSTATSCLASS_H_
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#include "constants.h"
+#include "SimulationStructs.h"
+
+//The statistics of a run summarized over replications: each direction's
+//longest queue, then each direction's cars advanced, then the total
+//cars advanced
+const int REPLICATION_MAX_QUEUE_FIRST = 0;
+const int REPLICATION_ADVANCED_FIRST = NUM_DIRECTIONS;
+const int REPLICATION_TOTAL_ADVANCED = 2 * NUM_DIRECTIONS;
+const int NUM_REPLICATION_METRICS = 2 * NUM_DIRECTIONS + 1;
+
+//Programmer: James Zhu
+//Date: October 2026
+//Purpose: The count, mean, variance, minimum and maximum of a stream of
+//         values, updated one value at a time by Welford's method.  Two
+//         summaries of separate streams merge (Chan et al.) into the
+//         summary of both.  Floating-point merges depend on the order
+//         they are done in, so summaries that must come out the same
+//         every time have to be merged in a fixed order.
+class RunningStatsClass
+{
+  private:
+    int64_t count; //Values added
+    double mean; //Mean of the values
+    double sumSquaredDevs; //Sum of squared deviations from the mean
+    double minVal; //Smallest value, when count > 0
+    double maxVal; //Largest value, when count > 0
+
+  public:
+    //Creates an empty summary.
+    RunningStatsClass(
+         );
+
+    //Adds one value.
+    void add(
+         const double value
+         );
+
+    //Adds every value summarized by another summary.
+    void merge(
+         const RunningStatsClass &other
+         );
+
+    //Returns the number of values added.
+    int64_t getCount(
+         ) const
+    {
+      return count;
+    }
+
+    //Returns the mean, or 0 if empty.
+    double getMean(
+         ) const
+    {
+      return mean;
+    }
+
+    //Returns the sample variance, or 0 with fewer than two values.
+    double getVariance(
+         ) const;
+
+    //Returns the standard error of the mean, or 0 with fewer than two
+    //values.
+    double getStdError(
+         ) const;
+
+    //Returns the smallest and largest values, meaningful only if not
+    //empty.
+    double getMin(
+         ) const
+    {
+      return minVal;
+    }
+
+    double getMax(
+         ) const
+    {
+      return maxVal;
+    }
+};
+
+//Programmer: James Zhu
+//Date: October 2026
+//Purpose: How many times each non-negative integer value occurred.
+//         Counts are integers, so merging is exact and its order never
+//         matters.  Used for small values such as queue lengths, as the
+//         counts are kept for every value up to the largest seen.
+class CountHistogramClass
+{
+  private:
+    std::vector< int64_t > valueCounts; //Occurrences of each value
+    int64_t count; //Values added
+
+  public:
+    //Creates an empty histogram.
+    CountHistogramClass(
+         );
+
+    //Adds one occurrence of a value, treating negatives as 0.
+    void add(
+         const int value
+         );
+
+    //Adds every occurrence counted by another histogram.
+    void merge(
+         const CountHistogramClass &other
+         );
+
+    //Returns the number of values added.
+    int64_t getCount(
+         ) const
+    {
+      return count;
+    }
+
+    //Returns the smallest value at least the given fraction (0 to 1) of
+    //the occurrences are at or below, or 0 if empty.
+    int getQuantile(
+         const double fraction
+         ) const;
+};
+
+//Programmer: James Zhu
+//Date: October 2026
+//Purpose: The statistics of any number of simulation runs, summarized
+//         per NUM_REPLICATION_METRICS metric, along with a histogram of
+//         each direction's longest queue.  Summaries of separate sets of
+//         runs merge into the summary of all of them.
+class ReplicationStatsClass
+{
+  private:
+    RunningStatsClass metricStats[NUM_REPLICATION_METRICS];
+    CountHistogramClass maxQueueHistograms[NUM_DIRECTIONS];
+
+  public:
+    //Adds the statistics of one run.
+    void addRun(
+         const SimulationStatsStruct &stats
+         );
+
+    //Adds every run summarized by another summary.
+    void merge(
+         const ReplicationStatsClass &other
+         );
+
+    //Returns the number of runs summarized.
+    int64_t getNumRuns(
+         ) const
+    {
+      return metricStats[0].getCount();
+    }
+
+    //Returns the summary of one of the REPLICATION_* metrics.
+    const RunningStatsClass& getMetricStats(
+         const int metricIdx
+         ) const
+    {
+      return metricStats[metricIdx];
+    }
+
+    //Returns the histogram of the longest queue of a direction.
+    const CountHistogramClass& getMaxQueueHistogram(
+         const int dirIdx
+         ) const
+    {
+      return maxQueueHistograms[dirIdx];
+    }
+
+    //Returns the printable name of one of the REPLICATION_* metrics.
+    static std::string getMetricName(
+         const int metricIdx
+         );
+
+    //Prints every metric's summary, one per line, with the median and
+    //upper quantiles of each longest queue.
+    void print(
+         std::ostream &outStream
+         ) const;
+};
+
+#endif // _REPLICATIONSTATSCLASS_H_
@@ -0,0 +1,302 @@
+// James Zhu
+// October 2026
+// Implementation of the ResultCacheClass, an on-disk hash table of run
+// statistics keyed by the runs' parameters.
+
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <cstdio>
+#include <cerrno>
+#include <stdint.h>
+using namespace std;
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/file.h>
+
+#include "ResultCacheClass.h"
+
+// The 64-bit FNV-1a offset basis and prime
+const uint64_t FNV_OFFSET_BASIS = ((uint64_t)0xCBF29CE4u << 32) |
+                                  0x84222325u;
+const uint64_t FNV_PRIME = ((uint64_t)0x00000100u << 32) | 0x000001B3u;
+
+// Returns the number of bytes a file with the given number of slots has
+static size_t getFileLength(const uint32_t numSlots) {
+    return sizeof(ResultCacheHeaderStruct) +
+           (size_t)numSlots * sizeof(ResultCacheSlotStruct);
+}
+
+ResultCacheClass::ResultCacheClass()
+ : fileDesc(-1), mappedData(NULL), mappedLength(0), numHits(0),
+   numMisses(0) {}
+
+ResultCacheClass::~ResultCacheClass() {
+    close();
+}
+
+bool ResultCacheClass::open(const string &inCacheFname) {
+    close();
+    fileDesc = ::open(inCacheFname.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fileDesc < 0) {
+        return false;
+    }
+    cacheFname = inCacheFname;
+    // Exclusive, so only one process creates the table of a new file
+    if (!lockTable(LOCK_EX)) {
+        return false;
+    }
+    unlockTable();
+    return true;
+}
+
+void ResultCacheClass::close() {
+    if (mappedData != NULL) {
+        munmap(mappedData, mappedLength);
+    }
+    if (fileDesc >= 0) {
+        ::close(fileDesc);
+    }
+    cacheFname.clear();
+    fileDesc = -1;
+    mappedData = NULL;
+    mappedLength = 0;
+    numHits = 0;
+    numMisses = 0;
+}
+
+bool ResultCacheClass::createTable(const uint32_t numSlots) {
+    const size_t length = getFileLength(numSlots);
+
+    // Extending the file fills it with zeros, i.e. empty slots
+    if (ftruncate(fileDesc, 0) != 0 || ftruncate(fileDesc, length) != 0) {
+        return false;
+    }
+    void *mapping = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED,
+                         fileDesc, 0);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+    mappedData = (char *)mapping;
+    mappedLength = length;
+    memcpy(getHeader()->magic, RESULT_CACHE_MAGIC, RESULT_CACHE_MAGIC_LENGTH);
+    getHeader()->numSlots = numSlots;
+    getHeader()->numEntries = 0;
+    return true;
+}
+
+bool ResultCacheClass::mapFile() {
+    struct stat fileStats;
+
+    if (fstat(fileDesc, &fileStats) != 0 ||
+        (size_t)fileStats.st_size < sizeof(ResultCacheHeaderStruct)) {
+        return false;
+    }
+    const size_t length = (size_t)fileStats.st_size;
+    void *mapping = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED,
+                         fileDesc, 0);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+    mappedData = (char *)mapping;
+    mappedLength = length;
+
+    const ResultCacheHeaderStruct *header = getHeader();
+    if (memcmp(header->magic, RESULT_CACHE_MAGIC,
+               RESULT_CACHE_MAGIC_LENGTH) != 0 ||
+        header->numSlots == 0 ||
+        (header->numSlots & (header->numSlots - 1)) != 0 ||
+        getFileLength(header->numSlots) != length) {
+        return false;
+    }
+    return true;
+}
+
+void ResultCacheClass::makeKey(const SimulationParamsStruct &params,
+                               const bool isUsingSubstreams,
+                               const bool isAntithetic,
+                               ResultCacheKeyStruct &outKey) {
+    // Zeroed first so the padding, if any, hashes the same every time
+    memset(&outKey, 0, sizeof(outKey));
+    outKey.simulatorVersion = SIMULATOR_VERSION;
+    outKey.streamFlags = (isUsingSubstreams ? 1 : 0) + (isAntithetic ? 2 : 0);
+    outKey.randomSeedVal = params.randomSeedVal;
+    outKey.timeToStopSim = params.timeToStopSim;
+    outKey.eastWestGreenTime = params.eastWestGreenTime;
+    outKey.eastWestYellowTime = params.eastWestYellowTime;
+    outKey.northSouthGreenTime = params.northSouthGreenTime;
+    outKey.northSouthYellowTime = params.northSouthYellowTime;
+    outKey.percentCarsAdvanceOnYellow = params.percentCarsAdvanceOnYellow;
+    for (int i = 0; i < NUM_DIRECTIONS; i++) {
+        // -0.0 and 0.0 run the same, so they get the same key
+        outKey.arrivalMeans[i] = (params.arrivalMeans[i] == 0) ? 0.0 :
+                                 params.arrivalMeans[i];
+        outKey.arrivalStdDevs[i] = (params.arrivalStdDevs[i] == 0) ? 0.0 :
+                                   params.arrivalStdDevs[i];
+    }
+}
+
+uint64_t ResultCacheClass::hashBytes(const void *data, const size_t length) {
+    const unsigned char *bytes = (const unsigned char *)data;
+    uint64_t keyHash = FNV_OFFSET_BASIS;
+
+    for (size_t i = 0; i < length; i++) {
+        keyHash = (keyHash ^ bytes[i]) * FNV_PRIME;
+    }
+    return (keyHash == 0) ? 1 : keyHash;
+}
+
+ResultCacheSlotStruct* ResultCacheClass::findSlot(
+         const ResultCacheKeyStruct &key, const uint64_t keyHash) const {
+    const uint32_t slotMask = getHeader()->numSlots - 1;
+    ResultCacheSlotStruct *slots = getSlots();
+    uint32_t slotIdx = (uint32_t)keyHash & slotMask;
+
+    // The table is never more than half full, so an empty slot is near
+    while (slots[slotIdx].keyHash != 0 &&
+           (slots[slotIdx].keyHash != keyHash ||
+            memcmp(&slots[slotIdx].key, &key, sizeof(key)) != 0)) {
+        slotIdx = (slotIdx + 1) & slotMask;
+    }
+    return &slots[slotIdx];
+}
+
+bool ResultCacheClass::growTable() {
+    const string tmpFname = cacheFname + ".tmp";
+    const uint32_t oldNumSlots = getHeader()->numSlots;
+    const ResultCacheSlotStruct *oldSlots = getSlots();
+    char *oldData = mappedData;
+    const size_t oldLength = mappedLength;
+    const int oldDesc = fileDesc;
+
+    // Built beside the old table and renamed over it, so the file is
+    // always one complete table or the other
+    fileDesc = ::open(tmpFname.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fileDesc >= 0 && flock(fileDesc, LOCK_EX | LOCK_NB) == 0 &&
+        createTable(oldNumSlots * 2)) {
+        for (uint32_t i = 0; i < oldNumSlots; i++) {
+            if (oldSlots[i].keyHash != 0) {
+                *findSlot(oldSlots[i].key, oldSlots[i].keyHash) = oldSlots[i];
+                getHeader()->numEntries++;
+            }
+        }
+        if (rename(tmpFname.c_str(), cacheFname.c_str()) == 0) {
+            munmap(oldData, oldLength);
+            ::close(oldDesc);
+            return true;
+        }
+    }
+
+    if (mappedData != oldData) {
+        munmap(mappedData, mappedLength);
+    }
+    if (fileDesc >= 0) {
+        ::close(fileDesc);
+        unlink(tmpFname.c_str());
+    }
+    fileDesc = oldDesc;
+    mappedData = oldData;
+    mappedLength = oldLength;
+    return false;
+}
+
+bool ResultCacheClass::lockTable(const int lockType) {
+    struct stat pathStats;
+    struct stat fileStats;
+
+    while (true) {
+        if (flock(fileDesc, lockType) != 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            close();
+            return false;
+        }
+        if (stat(cacheFname.c_str(), &pathStats) != 0 ||
+            fstat(fileDesc, &fileStats) != 0) {
+            close();
+            return false;
+        }
+        if (pathStats.st_dev == fileStats.st_dev &&
+            pathStats.st_ino == fileStats.st_ino) {
+            break;
+        }
+        // Another process grew the table into a new file
+        if (mappedData != NULL) {
+            munmap(mappedData, mappedLength);
+            mappedData = NULL;
+            mappedLength = 0;
+        }
+        ::close(fileDesc);
+        fileDesc = ::open(cacheFname.c_str(), O_RDWR);
+        if (fileDesc < 0) {
+            close();
+            return false;
+        }
+    }
+
+    if (mappedData == NULL &&
+        !((fileStats.st_size == 0 && lockType == LOCK_EX) ?
+          createTable(RESULT_CACHE_INITIAL_SLOTS) : mapFile())) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void ResultCacheClass::unlockTable() {
+    flock(fileDesc, LOCK_UN);
+}
+
+bool ResultCacheClass::lookup(const ResultCacheKeyStruct &key,
+                              SimulationStatsStruct &outStats,
+                              double &outMeanDelay) {
+    if (mappedData == NULL || !lockTable(LOCK_SH)) {
+        return false;
+    }
+    const ResultCacheSlotStruct *slot = findSlot(key, hashKey(key));
+    const bool isFound = (slot->keyHash != 0);
+    if (isFound) {
+        outStats = slot->stats;
+        outMeanDelay = slot->meanDelay;
+        numHits++;
+    }
+    else {
+        numMisses++;
+    }
+    unlockTable();
+    return isFound;
+}
+
+bool ResultCacheClass::store(const ResultCacheKeyStruct &key,
+                             const SimulationStatsStruct &stats,
+                             const double meanDelay) {
+    if (mappedData == NULL || !lockTable(LOCK_EX)) {
+        return false;
+    }
+    if ((getHeader()->numEntries + 1) * 2 > getHeader()->numSlots &&
+        !growTable()) {
+        unlockTable();
+        return false;
+    }
+    const uint64_t keyHash = hashKey(key);
+    ResultCacheSlotStruct *slot = findSlot(key, keyHash);
+    slot->stats = stats;
+    slot->meanDelay = meanDelay;
+    if (slot->keyHash == 0) {
+        slot->key = key;
+        slot->keyHash = keyHash;
+        getHeader()->numEntries++;
+    }
+    unlockTable();
+    return true;
+}
+
+void ResultCacheClass::print(ostream &outStream) const {
+    outStream << "Result cache: " << cacheFname << " Entries: " <<
+                 getNumEntries() << " Hits: " << numHits << " Misses: " <<
+                 numMisses;
+}
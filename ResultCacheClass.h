@@ -0,0 +1,232 @@
+#ifndef _RESULTCACHECLASS_H_
+#define _RESULTCACHECLASS_H_
+
+#include <iostream>
+#include <string>
+#include <cstddef>
+#include <stdint.h>
+
+#include "SimulationStructs.h"
+
+//Marks the start of a result cache file
+const char RESULT_CACHE_MAGIC[] = "SIMRC002";
+const int RESULT_CACHE_MAGIC_LENGTH = 8;
+
+//Slots in a new cache file.  Always a power of two; the table doubles
+//whenever it would become more than half full.
+const uint32_t RESULT_CACHE_INITIAL_SLOTS = 1024;
+
+//Everything a cached run's statistics depend on, laid out the same way
+//every time (unused bytes zeroed) so its bytes can be hashed and
+//compared.
+struct ResultCacheKeyStruct
+{
+  int32_t simulatorVersion; //SIMULATOR_VERSION the run was made with
+  int32_t streamFlags; //1 for substreams, plus 2 for antithetic draws
+  int32_t randomSeedVal;
+  int32_t timeToStopSim;
+  int32_t eastWestGreenTime;
+  int32_t eastWestYellowTime;
+  int32_t northSouthGreenTime;
+  int32_t northSouthYellowTime;
+  int32_t percentCarsAdvanceOnYellow;
+  int32_t unused; //Always 0
+  double arrivalMeans[NUM_DIRECTIONS];
+  double arrivalStdDevs[NUM_DIRECTIONS];
+};
+
+//One slot of the table in a cache file.
+struct ResultCacheSlotStruct
+{
+  uint64_t keyHash; //Hash of the key, or 0 if the slot is empty
+  ResultCacheKeyStruct key;
+  SimulationStatsStruct stats;
+  double meanDelay; //getMeanDelay at the end of the run
+};
+
+//Start of a cache file, followed by its slots.
+struct ResultCacheHeaderStruct
+{
+  char magic[RESULT_CACHE_MAGIC_LENGTH]; //RESULT_CACHE_MAGIC
+  uint32_t numSlots; //Power of two
+  uint32_t numEntries; //Slots in use
+};
+
+//Programmer: James Zhu
+//Date: October 2026
+//Purpose: Remembers the statistics of runs on disk, so a scenario that
+//         was run before, by any program using the same cache file,
+//         is answered without running it again.  Only runs of the nine
+//         required parameters (and the random stream settings, substreams
+//         and antithetic draws included) can be cached, as those are all
+//         such a run depends on.  Each run's mean car delay is kept with
+//         its statistics.
+//
+//         A run is found by the content of its parameters: a canonical
+//         key is built from them and SIMULATOR_VERSION, and its 64-bit
+//         FNV-1a hash picks the slot of an open-addressing hash table
+//         (linear probing) that makes up the whole file.  The file is
+//         memory-mapped, so a lookup touches one or two slots in place,
+//         and the full key is compared, so different parameters never
+//         share a result.  Statistics made by another simulator version
+//         are never returned.
+//
+//         Any number of processes can use the file at once.  Each lookup
+//         holds a shared lock on it and each store an exclusive one,
+//         waiting for the lock rather than failing.  A table that grows is
+//         built in a new file renamed over the old one, so after taking
+//         the lock a process checks it still has the file at the path, and
+//         reopens it if not.  A slot's hash is written last, so a slot is
+//         only in use once its key and statistics are complete.
+class ResultCacheClass
+{
+  private:
+    std::string cacheFname; //Open cache file, or empty
+    int fileDesc; //Descriptor of the open file, or -1
+    char *mappedData; //Start of the read-write mapping, or NULL until the
+                      //file is first locked
+    size_t mappedLength; //Number of bytes in the mapping
+    int numHits; //Lookups answered since opening
+    int numMisses; //Lookups not answered since opening
+
+    //Returns the header at the start of the mapping.
+    ResultCacheHeaderStruct* getHeader(
+         ) const
+    {
+      return (ResultCacheHeaderStruct *)mappedData;
+    }
+
+    //Returns the slots after the header.
+    ResultCacheSlotStruct* getSlots(
+         ) const
+    {
+      return (ResultCacheSlotStruct *)(mappedData +
+                                       sizeof(ResultCacheHeaderStruct));
+    }
+
+    //Sizes the open file for the given number of slots, all empty, and
+    //maps it.  Returns false if it can't.
+    bool createTable(
+         const uint32_t numSlots
+         );
+
+    //Maps the whole open file.  Returns false if it can't be mapped or
+    //isn't a complete cache file.
+    bool mapFile(
+         );
+
+    //Returns the slot holding the key, or the empty slot it would go
+    //in.
+    ResultCacheSlotStruct* findSlot(
+         const ResultCacheKeyStruct &key,
+         const uint64_t keyHash
+         ) const;
+
+    //Rebuilds the table with twice the slots.  Returns false, leaving it
+    //as it was, if it can't.
+    bool growTable(
+         );
+
+    //Waits for a LOCK_SH or LOCK_EX lock on the file at the path, first
+    //reopening it if another process has replaced the file, and maps it
+    //(creating the table in an empty file, under LOCK_EX).  Returns false,
+    //closing the cache, if it can't.
+    bool lockTable(
+         const int lockType
+         );
+
+    //Releases the lock lockTable took.
+    void unlockTable(
+         );
+
+    //Not copyable - the file and mapping belong to exactly one object.
+    ResultCacheClass(
+         const ResultCacheClass &rhs
+         );
+    ResultCacheClass& operator=(
+         const ResultCacheClass &rhs
+         );
+
+  public:
+    //Creates a cache with no file open.
+    ResultCacheClass(
+         );
+
+    //Unmaps and closes any open file.
+    ~ResultCacheClass(
+         );
+
+    //Opens the cache file, creating it if it doesn't exist (waiting for
+    //any process using it to let go).  Returns false if it can't be
+    //opened or isn't a cache file.  Any file already open is closed
+    //first.
+    bool open(
+         const std::string &inCacheFname
+         );
+
+    //Unmaps and closes the file, if one is open.
+    void close(
+         );
+
+    //Returns true if a cache file is open.
+    bool getIsOpen(
+         ) const
+    {
+      return mappedData != NULL;
+    }
+
+    //Fills in the canonical key of a run of the given parameters.
+    static void makeKey(
+         const SimulationParamsStruct &params,
+         const bool isUsingSubstreams,
+         const bool isAntithetic,
+         ResultCacheKeyStruct &outKey
+         );
+
+    //Returns the 64-bit FNV-1a hash of the given bytes (never 0, which
+    //marks an empty slot).
+    static uint64_t hashBytes(
+         const void *data,
+         const size_t length
+         );
+
+    //Returns the hash of a key's bytes.
+    static uint64_t hashKey(
+         const ResultCacheKeyStruct &key
+         )
+    {
+      return hashBytes(&key, sizeof(key));
+    }
+
+    //Provides the cached statistics and mean delay of a run via outStats
+    //and outMeanDelay.  Returns false if the run isn't cached.
+    bool lookup(
+         const ResultCacheKeyStruct &key,
+         SimulationStatsStruct &outStats,
+         double &outMeanDelay
+         );
+
+    //Caches the statistics and mean delay of a run, replacing any cached
+    //before.  Returns false if no file is open or the table can't grow.
+    bool store(
+         const ResultCacheKeyStruct &key,
+         const SimulationStatsStruct &stats,
+         const double meanDelay
+         );
+
+    //Returns the number of runs cached, as of this object's last lookup
+    //or store.
+    int getNumEntries(
+         ) const
+    {
+      return (mappedData == NULL) ? 0 : (int)getHeader()->numEntries;
+    }
+
+    //Prints the file, its number of entries and the hits and misses
+    //since it was opened on a single line.
+    void print(
+         std::ostream &outStream
+         ) const;
+};
+
+#endif // _RESULTCACHECLASS_H_
@@ -0,0 +1,83 @@
+#ifndef _RING_QUEUE_CLASS_H_
+#define _RING_QUEUE_CLASS_H_
+
+//Slots a growable queue starts with; it doubles whenever it fills up
+const int RING_QUEUE_INITIAL_CAPACITY = 8;
+
+//Programmer: James Zhu
+//Date: October 2026
+//Purpose: A FIFO queue kept in one preallocated array used as a ring,
+//         rather than one linked node per value, so enqueuing and
+//         dequeuing never allocate memory.  A queue either has a fixed
+//         capacity, allocated up front, at which it refuses new values,
+//         or grows by doubling when full (so values are still copied
+//         only O(1) times each, amortized).
+template <class T>
+class RingQueueClass
+{
+private:
+    T *slots; //The array of capacity slots the values are kept in
+    int capacity; //Number of slots
+    bool isFixedCapacity; //When true, the queue is full at capacity
+    //values rather than growing.
+    int headIdx; //Slot of the first value in the queue
+    int numElems; //Number of values in the queue, which occupy the slots
+    //from headIdx on, wrapping around to slot 0.
+
+    //Moves the values to a newly allocated array of newCapacity slots,
+    //starting at slot 0.
+    void reallocate(int newCapacity);
+public:
+    //Default Constructor. Will properly initialize a queue to
+    //be an empty, growable queue, to which values can be added.
+    RingQueueClass();
+    //Copy constructor. Makes a deep copy of the queue given (rhs),
+    //with the same capacity.
+    RingQueueClass(const RingQueueClass<T> &rhs);
+    //Assignment operator. Makes this queue a deep copy of the queue
+    //given (rhs), with the same capacity.
+    RingQueueClass<T>& operator=(const RingQueueClass<T> &rhs);
+    //Destructor. Frees the array of slots.
+    ~RingQueueClass();
+    //Empties the queue and preallocates inCapacity slots.  If
+    //inIsFixedCapacity, the queue will never hold more than that;
+    //otherwise it grows beyond it as needed.  A capacity below 1
+    //is taken as 1.
+    void setCapacity(int inCapacity, bool inIsFixedCapacity);
+    //Returns the number of slots currently allocated.
+    int getCapacity() const;
+    //Returns true if the queue has a fixed capacity, rather than growing.
+    bool getIsFixedCapacity() const;
+    //Returns true if the queue has a fixed capacity and is at it.
+    bool getIsFull() const;
+    //Inserts the value provided (newItem) at the back of the queue.
+    //Returns false, leaving the queue unchanged, if the queue is full.
+    bool enqueue(const T &newItem);
+    //Attempts to take the next item out of the queue. If the
+    //queue is empty, the function returns false and the state
+    //of the reference parameter (outItem) is undefined. If the
+    //queue is not empty, the function returns true and outItem
+    //becomes a copy of the next item in the queue, which is
+    //removed from the data structure.
+    bool dequeue(T &outItem);
+    //Prints out the contents of the queue. All printing is done
+    //on one line, using a single space to separate values, and a
+    //single newline character is printed at the end. Values will
+    //be printed such that the next value that would be dequeued
+    //is printed first.
+    void print() const;
+    //Returns the number of values contained in the queue, in constant
+    //time.
+    int getNumElems() const;
+    //Provides the value at the 0-based position given (index), 0 being
+    //the next value that would be dequeued. If the index is out of
+    //range, then outVal remains unchanged and false is returned.
+    //Otherwise, the function returns true, and outVal becomes a copy
+    //of the value at that position.
+    bool getElemAtIndex(const int index, T &outVal) const;
+    //Clears the queue to an empty state, keeping its slots allocated.
+    void clear();
+};
+
+#include "RingQueueClass.inl"
+#endif
@@ -0,0 +1,157 @@
+// James Zhu
+// October 2026
+// Implementation of the RingQueueClass template class. This class
+// represents a FIFO queue using an array as a ring buffer.
+
+#include <iostream>
+#include "RingQueueClass.h"
+
+// Constructor
+template <class T>
+RingQueueClass<T>::RingQueueClass()
+ : slots(new T[RING_QUEUE_INITIAL_CAPACITY]),
+   capacity(RING_QUEUE_INITIAL_CAPACITY), isFixedCapacity(false),
+   headIdx(0), numElems(0) {}
+
+// Copy constructor
+template <class T>
+RingQueueClass<T>::RingQueueClass(const RingQueueClass<T> &rhs)
+ : slots(new T[rhs.capacity]), capacity(rhs.capacity),
+   isFixedCapacity(rhs.isFixedCapacity), headIdx(0),
+   numElems(rhs.numElems) {
+    for (int i = 0; i < numElems; i++) {
+        slots[i] = rhs.slots[(rhs.headIdx + i) % rhs.capacity];
+    }
+}
+
+// Assignment operator
+template <class T>
+RingQueueClass<T>& RingQueueClass<T>::operator=(
+    const RingQueueClass<T> &rhs) {
+    if (this != &rhs) {
+        // Snapshots are restored over and over, so reuse the slots when
+        // they are already the right size
+        if (capacity != rhs.capacity) {
+            delete [] slots;
+            slots = new T[rhs.capacity];
+            capacity = rhs.capacity;
+        }
+        isFixedCapacity = rhs.isFixedCapacity;
+        headIdx = 0;
+        numElems = rhs.numElems;
+        for (int i = 0; i < numElems; i++) {
+            slots[i] = rhs.slots[(rhs.headIdx + i) % rhs.capacity];
+        }
+    }
+    return *this;
+}
+
+// Destructor
+template <class T>
+RingQueueClass<T>::~RingQueueClass() {
+    delete [] slots;
+}
+
+// Move the values into a new array
+template <class T>
+void RingQueueClass<T>::reallocate(int newCapacity) {
+    T *newSlots = new T[newCapacity];
+    for (int i = 0; i < numElems; i++) {
+        newSlots[i] = slots[(headIdx + i) % capacity];
+    }
+    delete [] slots;
+    slots = newSlots;
+    capacity = newCapacity;
+    headIdx = 0;
+}
+
+// Empty the queue and preallocate its slots
+template <class T>
+void RingQueueClass<T>::setCapacity(int inCapacity, bool inIsFixedCapacity) {
+    numElems = 0;
+    reallocate(inCapacity < 1 ? 1 : inCapacity);
+    isFixedCapacity = inIsFixedCapacity;
+}
+
+// Get the number of slots
+template <class T>
+int RingQueueClass<T>::getCapacity() const {
+    return capacity;
+}
+
+// Check whether the queue has a fixed capacity
+template <class T>
+bool RingQueueClass<T>::getIsFixedCapacity() const {
+    return isFixedCapacity;
+}
+
+// Check whether a fixed capacity queue is full
+template <class T>
+bool RingQueueClass<T>::getIsFull() const {
+    return isFixedCapacity && numElems == capacity;
+}
+
+// Enqueue an item
+template <class T>
+bool RingQueueClass<T>::enqueue(const T &newItem) {
+    if (numElems == capacity) {
+        if (isFixedCapacity) {
+            return false;
+        }
+        reallocate(2 * capacity);
+    }
+    int tailIdx = headIdx + numElems;
+    if (tailIdx >= capacity) {
+        tailIdx -= capacity;
+    }
+    slots[tailIdx] = newItem;
+    numElems++;
+    return true;
+}
+
+// Dequeue an item
+template <class T>
+bool RingQueueClass<T>::dequeue(T &outItem) {
+    if (numElems == 0) {
+        return false;
+    }
+    outItem = slots[headIdx];
+    headIdx++;
+    if (headIdx == capacity) {
+        headIdx = 0;
+    }
+    numElems--;
+    return true;
+}
+
+// Print the queue contents
+template <class T>
+void RingQueueClass<T>::print() const {
+    for (int i = 0; i < numElems; i++) {
+        std::cout << slots[(headIdx + i) % capacity] << " ";
+    }
+    std::cout << std::endl;
+}
+
+// Get the number of elements
+template <class T>
+int RingQueueClass<T>::getNumElems() const {
+    return numElems;
+}
+
+// Get the value at a position from the head
+template <class T>
+bool RingQueueClass<T>::getElemAtIndex(const int index, T &outVal) const {
+    if (index < 0 || index >= numElems) {
+        return false;
+    }
+    outVal = slots[(headIdx + index) % capacity];
+    return true;
+}
+
+// Clear the queue
+template <class T>
+void RingQueueClass<T>::clear() {
+    headIdx = 0;
+    numElems = 0;
+}
@@ -0,0 +1,248 @@
+// James Zhu
+// October 2026
+// Implementation of the ScenarioBatchClass, which parses a whole file of
+// scenarios in place out of a read-only memory mapping.
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <climits>
+#include <stdint.h>
+using namespace std;
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "ScenarioBatchClass.h"
+
+// Largest power of ten, and largest integer, a double holds exactly, so
+// dividing or multiplying one by the other is correctly rounded
+const int MAX_EXACT_POWER_OF_TEN = 22;
+const uint64_t MAX_EXACT_MANTISSA = (uint64_t)1 << 53;
+// Digits kept in the mantissa; later ones only shift the exponent
+const int MAX_MANTISSA_DIGITS = 18;
+
+static bool isDigit(const char ch) {
+    return ch >= '0' && ch <= '9';
+}
+
+static bool isFieldSeparator(const char ch) {
+    return ch == ',' || ch == ' ' || ch == '\t' || ch == '\r';
+}
+
+// Parses a decimal number (optional sign, digits, fraction and exponent)
+// starting at data[pos], moving pos past it.  Returns false, leaving pos
+// alone, if there is no number there.
+static bool parseNumber(const char *data, const size_t length, size_t &pos,
+                        double &outVal, bool &outIsInteger) {
+    size_t cur = pos;
+    bool isNegative = false;
+    uint64_t mantissa = 0;
+    int numDigits = 0;
+    int exponent = 0;
+
+    if (cur < length && (data[cur] == '-' || data[cur] == '+')) {
+        isNegative = (data[cur] == '-');
+        cur++;
+    }
+    outIsInteger = true;
+    while (cur < length && isDigit(data[cur])) {
+        if (numDigits < MAX_MANTISSA_DIGITS) {
+            mantissa = mantissa * 10 + (data[cur] - '0');
+        }
+        else {
+            exponent++;
+        }
+        numDigits++;
+        cur++;
+    }
+    if (cur < length && data[cur] == '.') {
+        outIsInteger = false;
+        cur++;
+        while (cur < length && isDigit(data[cur])) {
+            if (numDigits < MAX_MANTISSA_DIGITS) {
+                mantissa = mantissa * 10 + (data[cur] - '0');
+                exponent--;
+            }
+            numDigits++;
+            cur++;
+        }
+    }
+    if (numDigits == 0) {
+        return false;
+    }
+    if (cur < length && (data[cur] == 'e' || data[cur] == 'E')) {
+        size_t expPos = cur + 1;
+        bool isExpNegative = false;
+        int expVal = 0;
+        if (expPos < length && (data[expPos] == '-' || data[expPos] == '+')) {
+            isExpNegative = (data[expPos] == '-');
+            expPos++;
+        }
+        if (expPos < length && isDigit(data[expPos])) {
+            outIsInteger = false;
+            while (expPos < length && isDigit(data[expPos])) {
+                expVal = min(expVal * 10 + (data[expPos] - '0'), 9999);
+                expPos++;
+            }
+            exponent += isExpNegative ? -expVal : expVal;
+            cur = expPos;
+        }
+    }
+
+    double value = (double)mantissa;
+    if (exponent != 0) {
+        if (mantissa <= MAX_EXACT_MANTISSA &&
+            exponent >= -MAX_EXACT_POWER_OF_TEN &&
+            exponent <= MAX_EXACT_POWER_OF_TEN) {
+            double scale = 1;
+            for (int i = 0; i < abs(exponent); i++) {
+                scale *= 10;
+            }
+            value = (exponent < 0) ? value / scale : value * scale;
+        }
+        else {
+            value *= pow(10.0, exponent);
+        }
+    }
+    outVal = isNegative ? -value : value;
+    pos = cur;
+    return true;
+}
+
+bool ScenarioBatchClass::loadFile(const string &batchFname) {
+    struct stat fileStats;
+
+    scenarios.clear();
+    scenarioLineNums.clear();
+    rowErrors.clear();
+
+    int fileDesc = open(batchFname.c_str(), O_RDONLY);
+    if (fileDesc < 0) {
+        return false;
+    }
+    if (fstat(fileDesc, &fileStats) != 0) {
+        close(fileDesc);
+        return false;
+    }
+    const size_t length = (size_t)fileStats.st_size;
+    if (length == 0) {
+        close(fileDesc);
+        return true;
+    }
+    void *mapping = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fileDesc, 0);
+    close(fileDesc);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+    madvise(mapping, length, MADV_SEQUENTIAL);
+
+    // A row is rarely shorter than 30 bytes, so this avoids most regrowth
+    scenarios.reserve(length / 30 + 1);
+    scenarioLineNums.reserve(length / 30 + 1);
+
+    const char *data = (const char *)mapping;
+    size_t pos = 0;
+    int lineNum = 1;
+    while (pos < length) {
+        size_t first = pos;
+        while (first < length && (data[first] == ' ' || data[first] == '\t')) {
+            first++;
+        }
+        bool isSkipped = (first >= length || data[first] == '\n' ||
+                          data[first] == '\r' || data[first] == '#' ||
+                          (data[first] >= 'a' && data[first] <= 'z') ||
+                          (data[first] >= 'A' && data[first] <= 'Z'));
+        if (isSkipped) {
+            const void *lineEnd = memchr(data + first, '\n', length - first);
+            pos = (lineEnd == NULL) ? length :
+                  (size_t)((const char *)lineEnd - data) + 1;
+        }
+        else {
+            pos = parseRow(data, length, first, lineNum);
+        }
+        lineNum++;
+    }
+
+    munmap(mapping, length);
+    return true;
+}
+
+size_t ScenarioBatchClass::parseRow(const char *data, const size_t length,
+                                    size_t pos, const int lineNum) {
+    double fields[NUM_SCENARIO_FIELDS];
+    bool isIntegers[NUM_SCENARIO_FIELDS];
+    int numFields = 0;
+    const char *message = NULL;
+
+    // Numbers, each followed by separators, up to the end of the line
+    while (pos < length && data[pos] != '\n' && message == NULL) {
+        double value = 0;
+        bool isInteger = true;
+        if (!parseNumber(data, length, pos, value, isInteger) ||
+            (pos < length && data[pos] != '\n' &&
+             !isFieldSeparator(data[pos]))) {
+            message = "Value is not a number";
+        }
+        else if (numFields == NUM_SCENARIO_FIELDS) {
+            message = "Too many values in row";
+        }
+        else {
+            fields[numFields] = value;
+            isIntegers[numFields] = isInteger;
+            numFields++;
+        }
+        while (pos < length && isFieldSeparator(data[pos])) {
+            pos++;
+        }
+    }
+    if (message == NULL && numFields < NUM_SCENARIO_FIELDS) {
+        message = "Too few values in row";
+    }
+
+    // Every field but the arrival means and standard deviations is an int
+    for (int i = 0; i < NUM_SCENARIO_FIELDS && message == NULL; i++) {
+        bool isRealField = (i >= 6 && i < 14);
+        if (!isRealField && (!isIntegers[i] || fields[i] < INT_MIN ||
+                             fields[i] > INT_MAX)) {
+            message = "Value must be an integer";
+        }
+    }
+
+    if (message == NULL) {
+        SimulationParamsStruct params;
+        params.randomSeedVal = (int)fields[0];
+        params.timeToStopSim = (int)fields[1];
+        params.eastWestGreenTime = (int)fields[2];
+        params.eastWestYellowTime = (int)fields[3];
+        params.northSouthGreenTime = (int)fields[4];
+        params.northSouthYellowTime = (int)fields[5];
+        for (int d = 0; d < NUM_DIRECTIONS; d++) {
+            params.arrivalMeans[d] = fields[6 + 2 * d];
+            params.arrivalStdDevs[d] = fields[7 + 2 * d];
+        }
+        params.percentCarsAdvanceOnYellow = (int)fields[14];
+
+        message = getSimulationParamsError(params);
+        if (message == NULL) {
+            scenarios.push_back(params);
+            scenarioLineNums.push_back(lineNum);
+        }
+    }
+
+    if (message != NULL) {
+        ScenarioRowErrorStruct rowError;
+        rowError.lineNum = lineNum;
+        rowError.message = message;
+        rowErrors.push_back(rowError);
+    }
+
+    const void *lineEnd = memchr(data + pos, '\n', length - pos);
+    return (lineEnd == NULL) ? length :
+           (size_t)((const char *)lineEnd - data) + 1;
+}
@@ -0,0 +1,104 @@
+#ifndef _SCENARIOBATCHCLASS_H_
+#define _SCENARIOBATCHCLASS_H_
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+#include "SimulationStructs.h"
+
+//Number of values in one row of a scenario batch file
+const int NUM_SCENARIO_FIELDS = 15;
+
+//A row of a scenario batch file that could not be used, and why.
+struct ScenarioRowErrorStruct
+{
+  int lineNum; //Line of the file the row is on, starting at 1
+  const char *message; //What was wrong with the row
+};
+
+//Programmer: James Zhu
+//Date: October 2026
+//Purpose: Loads thousands of scenarios from one file into an array of
+//         SimulationParamsStruct, so batch tools don't have to read one
+//         parameter file (or start one process) per scenario.
+//
+//         Each scenario is one line holding the nine required parameters
+//         in parameter file order, as 15 numbers separated by commas
+//         and/or whitespace, so both CSV and whitespace-separated text
+//         work:
+//           seed, endTime, ewGreen, ewYellow, nsGreen, nsYellow,
+//           eastMean, eastStdDev, westMean, westStdDev,
+//           northMean, northStdDev, southMean, southStdDev, percentYellow
+//         Blank lines, and lines starting with '#' or a letter (comments
+//         and CSV headers), are skipped.
+//
+//         The file is memory-mapped and its numbers are parsed in place,
+//         without copying lines or going through iostreams.  Rows are
+//         validated with the same rules as readParametersFromFile, and a
+//         bad row is recorded as an error and left out rather than
+//         stopping the load.
+class ScenarioBatchClass
+{
+  private:
+    std::vector< SimulationParamsStruct > scenarios; //Rows loaded so far
+    std::vector< int > scenarioLineNums; //Line each scenario came from
+    std::vector< ScenarioRowErrorStruct > rowErrors; //Rows left out
+
+    //Parses and validates the row starting at data[pos], appending it
+    //to the scenarios or the errors.  Returns the offset of the start of
+    //the next line.
+    size_t parseRow(
+         const char *data,
+         const size_t length,
+         size_t pos,
+         const int lineNum
+         );
+
+  public:
+    //Loads the scenarios of a batch file, replacing any loaded before.
+    //Returns false if the file can't be opened or mapped; rows with
+    //errors don't make the load fail, so check getNumErrors as well.
+    bool loadFile(
+         const std::string &batchFname
+         );
+
+    //Returns the number of scenarios loaded.
+    int getNumScenarios(
+         ) const
+    {
+      return (int)scenarios.size();
+    }
+
+    //Returns the loaded scenarios as a contiguous array, or NULL if none.
+    const SimulationParamsStruct* getScenarios(
+         ) const
+    {
+      return scenarios.empty() ? NULL : &scenarios[0];
+    }
+
+    //Returns the line of the file that the given scenario came from.
+    int getScenarioLineNum(
+         const int scenarioIdx
+         ) const
+    {
+      return scenarioLineNums[scenarioIdx];
+    }
+
+    //Returns the number of rows left out because of errors.
+    int getNumErrors(
+         ) const
+    {
+      return (int)rowErrors.size();
+    }
+
+    //Returns the error of the given row left out.
+    const ScenarioRowErrorStruct& getError(
+         const int errorIdx
+         ) const
+    {
+      return rowErrors[errorIdx];
+    }
+};
+
+#endif // _SCENARIOBATCHCLASS_H_
@@ -0,0 +1,131 @@
+// James Zhu
+// October 2026
+// Implementation of the actuated and queue-balancing signal controllers.
+
+#include <iostream>
+#include <string>
+using namespace std;
+
+#include "SignalControllerClass.h"
+
+// Finds the directions served by a green light
+static void getGreenDirections(const int greenLight, int &firstDir,
+                               int &secondDir) {
+    if (greenLight == LIGHT_GREEN_EW) {
+        firstDir = DIRECTION_EAST;
+        secondDir = DIRECTION_WEST;
+    }
+    else {
+        firstDir = DIRECTION_NORTH;
+        secondDir = DIRECTION_SOUTH;
+    }
+}
+
+ActuatedControllerClass::ActuatedControllerClass(const int inMinGreen,
+                                                 const int inMaxGreen,
+                                                 const int inGapTime)
+ : minGreen(inMinGreen), maxGreen(inMaxGreen), gapTime(inGapTime) {}
+
+int ActuatedControllerClass::getGreenTime(
+    const int greenLight, const int queueLengths[NUM_DIRECTIONS]) {
+    return minGreen;
+}
+
+int ActuatedControllerClass::getGreenExtension(
+    const int greenLight, const int greenElapsed,
+    const int queueLengths[NUM_DIRECTIONS],
+    const int ticsSinceArrival[NUM_DIRECTIONS]) {
+    int firstDir = 0;
+    int secondDir = 0;
+
+    // Max-out
+    if (greenElapsed >= maxGreen) {
+        return 0;
+    }
+
+    getGreenDirections(greenLight, firstDir, secondDir);
+    bool isVehicleDetected =
+        queueLengths[firstDir] > 0 ||
+        queueLengths[secondDir] > 0 ||
+        ticsSinceArrival[firstDir] < gapTime ||
+        ticsSinceArrival[secondDir] < gapTime;
+
+    // Gap-out
+    if (!isVehicleDetected) {
+        return 0;
+    }
+    return min(gapTime, maxGreen - greenElapsed);
+}
+
+void ActuatedControllerClass::print(ostream &outStream) const {
+    outStream << "Actuated - Min Green: " << minGreen <<
+                 " Max Green: " << maxGreen << " Gap: " << gapTime;
+}
+
+QueueBalancingControllerClass::QueueBalancingControllerClass(
+    const int inCycleGreenTotal, const int inMinGreen, const int inMaxGreen)
+ : cycleGreenTotal(inCycleGreenTotal), minGreen(inMinGreen),
+   maxGreen(inMaxGreen) {}
+
+int QueueBalancingControllerClass::getGreenTime(
+    const int greenLight, const int queueLengths[NUM_DIRECTIONS]) {
+    int firstDir = 0;
+    int secondDir = 0;
+    int otherFirstDir = 0;
+    int otherSecondDir = 0;
+    int greenTime = cycleGreenTotal / 2;
+
+    getGreenDirections(greenLight, firstDir, secondDir);
+    getGreenDirections(
+        (greenLight == LIGHT_GREEN_EW) ? LIGHT_GREEN_NS : LIGHT_GREEN_EW,
+        otherFirstDir, otherSecondDir);
+    int phaseDemand = max(queueLengths[firstDir], queueLengths[secondDir]);
+    int otherDemand = max(queueLengths[otherFirstDir],
+                          queueLengths[otherSecondDir]);
+
+    if (phaseDemand + otherDemand > 0) {
+        greenTime = (cycleGreenTotal * phaseDemand +
+                     (phaseDemand + otherDemand) / 2) /
+                    (phaseDemand + otherDemand);
+    }
+    return max(minGreen, min(maxGreen, greenTime));
+}
+
+int QueueBalancingControllerClass::getGreenExtension(
+    const int greenLight, const int greenElapsed,
+    const int queueLengths[NUM_DIRECTIONS],
+    const int ticsSinceArrival[NUM_DIRECTIONS]) {
+    return 0;
+}
+
+void QueueBalancingControllerClass::print(ostream &outStream) const {
+    outStream << "Queue Balancing - Cycle Green: " << cycleGreenTotal <<
+                 " Min Green: " << minGreen << " Max Green: " << maxGreen;
+}
+
+SignalControllerClass* createSignalController(istream &inStream) {
+    string controllerName;
+    SignalControllerClass *controller = NULL;
+
+    inStream >> controllerName;
+    if (controllerName == "actuated") {
+        int minGreen, maxGreen, gapTime;
+        inStream >> minGreen >> maxGreen >> gapTime;
+        if (!inStream.fail() && minGreen > 0 && maxGreen >= minGreen &&
+            gapTime > 0) {
+            controller = new ActuatedControllerClass(minGreen, maxGreen,
+                                                     gapTime);
+        }
+    }
+    else if (controllerName == "balanced") {
+        int cycleGreenTotal, minGreen, maxGreen;
+        inStream >> cycleGreenTotal >> minGreen >> maxGreen;
+        if (!inStream.fail() && minGreen > 0 && maxGreen >= minGreen &&
+            cycleGreenTotal >= 2 * minGreen) {
+            controller = new QueueBalancingControllerClass(cycleGreenTotal,
+                                                           minGreen,
+                                                           maxGreen);
+        }
+    }
+    return controller;
+}
@@ -0,0 +1,125 @@
+#ifndef _SIGNALCONTROLLERCLASS_H_
+#define _SIGNALCONTROLLERCLASS_H_
+
+#include <iostream>
+
+#include "constants.h"
+
+//Programmer: James Zhu
+//Date: October 2026
+//Purpose: Signal controllers decide how long each green phase lasts.  The
+//         simulation asks the controller for a green time when a green
+//         phase starts, and then, at the end of that time, whether to
+//         extend the phase.  Controllers only see the current queue
+//         lengths and the time since each direction's last arrival, all
+//         of which are read in O(1), so every decision is constant-time
+//         no matter how congested the intersection is.
+//
+//         In every method, greenLight is LIGHT_GREEN_EW or LIGHT_GREEN_NS,
+//         and the arrays are indexed by the DIRECTION_* constants.
+class SignalControllerClass
+{
+  public:
+    virtual ~SignalControllerClass(
+         )
+    {
+    }
+
+    //Called as a green phase starts.  Returns the number of time tics
+    //until the first decision point (the end of green, unless extended).
+    virtual int getGreenTime(
+         const int greenLight,
+         const int queueLengths[NUM_DIRECTIONS]
+         ) = 0;
+
+    //Called at each decision point during green, greenElapsed tics after
+    //the phase started.  queueLengths only counts cars still waiting,
+    //not those the green time already given will advance.  Returns the
+    //number of additional tics to stay green, or 0 to end the phase now.
+    virtual int getGreenExtension(
+         const int greenLight,
+         const int greenElapsed,
+         const int queueLengths[NUM_DIRECTIONS],
+         const int ticsSinceArrival[NUM_DIRECTIONS]
+         ) = 0;
+
+    //Prints the controller type and its settings on a single line.
+    virtual void print(
+         std::ostream &outStream
+         ) const = 0;
+};
+
+//Actuated control: green lasts at least minGreen, then is extended in
+//steps of gapTime while vehicles are still detected on the green
+//approaches (cars still queued, or an arrival within the last gapTime
+//tics).  The phase "gaps out" when no vehicle is detected and "maxes
+//out" at maxGreen.
+class ActuatedControllerClass : public SignalControllerClass
+{
+  private:
+    int minGreen;
+    int maxGreen;
+    int gapTime;
+  public:
+    ActuatedControllerClass(
+         const int inMinGreen,
+         const int inMaxGreen,
+         const int inGapTime
+         );
+    int getGreenTime(
+         const int greenLight,
+         const int queueLengths[NUM_DIRECTIONS]
+         );
+    int getGreenExtension(
+         const int greenLight,
+         const int greenElapsed,
+         const int queueLengths[NUM_DIRECTIONS],
+         const int ticsSinceArrival[NUM_DIRECTIONS]
+         );
+    void print(
+         std::ostream &outStream
+         ) const;
+};
+
+//Queue-balancing adaptive control: the total green time of a cycle is
+//fixed, and each phase gets a share of it proportional to its longest
+//queue relative to the opposing phase's longest queue, clamped to
+//[minGreen, maxGreen].  Phases are never extended.
+class QueueBalancingControllerClass : public SignalControllerClass
+{
+  private:
+    int cycleGreenTotal;
+    int minGreen;
+    int maxGreen;
+  public:
+    QueueBalancingControllerClass(
+         const int inCycleGreenTotal,
+         const int inMinGreen,
+         const int inMaxGreen
+         );
+    int getGreenTime(
+         const int greenLight,
+         const int queueLengths[NUM_DIRECTIONS]
+         );
+    int getGreenExtension(
+         const int greenLight,
+         const int greenElapsed,
+         const int queueLengths[NUM_DIRECTIONS],
+         const int ticsSinceArrival[NUM_DIRECTIONS]
+         );
+    void print(
+         std::ostream &outStream
+         ) const;
+};
+
+//Reads a controller name followed by its settings from the stream and
+//returns a newly allocated controller, which the caller must delete.
+//Returns NULL if the name is unknown or the settings are invalid.
+//Accepted forms:
+//  actuated <minGreen> <maxGreen> <gapTime>
+//  balanced <cycleGreenTotal> <minGreen> <maxGreen>
+SignalControllerClass* createSignalController(
+     std::istream &inStream
+     );
+
+#endif // _SIGNALCONTROLLERCLASS_H_
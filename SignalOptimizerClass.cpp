@@ -0,0 +1,447 @@
+// James Zhu
+// October 2026
+// Implementation of the SignalOptimizerClass, which searches the light
+// timings with a separable CMA-ES, scoring candidates on several threads.
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <algorithm>
+using namespace std;
+
+#include <pthread.h>
+
+#include "SignalOptimizerClass.h"
+
+// Spread of the first generation, in scaled units (bounds 0 to 1)
+const double INITIAL_STEP_SIZE = 0.3;
+
+// M_PI isn't standard C++98
+const double TWO_PI = 6.283185307179586;
+
+// The objective names print uses, indexed by the OPTIMIZE_* values
+const char *OBJECTIVE_NAMES[] = { "Mean delay", "Max queue" };
+
+// Orders candidate indices by score, then index, so ties rank the same
+// every time
+struct CandidateOrderStruct
+{
+    const vector< double > *candidateScores;
+
+    bool operator()(const int lhs, const int rhs) const {
+        if ((*candidateScores)[lhs] != (*candidateScores)[rhs]) {
+            return (*candidateScores)[lhs] < (*candidateScores)[rhs];
+        }
+        return lhs < rhs;
+    }
+};
+
+// Prints a timing as "EW green/yellow NS green/yellow"
+static void printTimes(ostream &outStream, const vector< int > &times) {
+    outStream << "EW " << times[TIMING_EW_GREEN] << "/" <<
+                 times[TIMING_EW_YELLOW] << " NS " <<
+                 times[TIMING_NS_GREEN] << "/" << times[TIMING_NS_YELLOW];
+}
+
+SignalOptimizerClass::SignalOptimizerClass()
+ : objective(OPTIMIZE_DELAY), numReplications(0), stepSize(0),
+   numGenerations(0), bestScore(0), initialScore(0), nextRunIdx(0),
+   numCachedRuns(0) {
+    for (int i = 0; i < NUM_TIMINGS; i++) {
+        const bool isGreen = (i == TIMING_EW_GREEN || i == TIMING_NS_GREEN);
+        minTimes[i] = isGreen ? OPTIMIZER_MIN_GREEN_TIME :
+                                OPTIMIZER_MIN_YELLOW_TIME;
+        maxTimes[i] = isGreen ? OPTIMIZER_MAX_GREEN_TIME :
+                                OPTIMIZER_MAX_YELLOW_TIME;
+    }
+    pthread_mutex_init(&runMutex, NULL);
+}
+
+SignalOptimizerClass::~SignalOptimizerClass() {
+    pthread_mutex_destroy(&runMutex);
+}
+
+bool SignalOptimizerClass::setup(const string &paramFname,
+                                 const int numThreads,
+                                 const int inNumReplications,
+                                 const int inObjective) {
+    simPool.clear();
+    if (numThreads <= 0 || inNumReplications <= 0 ||
+        (inObjective != OPTIMIZE_DELAY && inObjective != OPTIMIZE_MAX_QUEUE)) {
+        return false;
+    }
+    if (!simPool.setup(paramFname, numThreads)) {
+        return false;
+    }
+    numReplications = inNumReplications;
+    objective = inObjective;
+    simPool.getSimulation(0).getParameters(baseParams);
+    return true;
+}
+
+bool SignalOptimizerClass::setupCache(const string &cacheFname) {
+    return resultCache.open(cacheFname);
+}
+
+bool SignalOptimizerClass::setBounds(const int timingIdx, const int minTime,
+                                     const int maxTime) {
+    if (timingIdx < 0 || timingIdx >= NUM_TIMINGS || minTime <= 0 ||
+        maxTime < minTime) {
+        return false;
+    }
+    minTimes[timingIdx] = minTime;
+    maxTimes[timingIdx] = maxTime;
+    return true;
+}
+
+void* SignalOptimizerClass::runWorker(void *workerPtr) {
+    WorkerStruct *worker = (WorkerStruct *)workerPtr;
+    SignalOptimizerClass *optimizer = worker->optimizer;
+
+    IntersectionSimulationClass &simObj = *worker->simObj;
+    SimulationParamsStruct params;
+
+    for (int runIdx = optimizer->takeRun(); runIdx >= 0;
+         runIdx = optimizer->takeRun()) {
+        optimizer->makeRunParams(
+            optimizer->pendingTimes[runIdx / optimizer->numReplications],
+            runIdx % optimizer->numReplications, params);
+        simObj.setParameters(params);
+        simObj.runUntil(params.timeToStopSim);
+        // Each run's results are written by the one thread that took it,
+        // and read only after every thread has been joined
+        simObj.getStatistics(optimizer->runStats[runIdx]);
+        optimizer->runDelays[runIdx] = simObj.getMeanDelay();
+    }
+    return NULL;
+}
+
+int SignalOptimizerClass::takeRun() {
+    int runIdx = -1;
+
+    pthread_mutex_lock(&runMutex);
+    if (nextRunIdx < (int)uncachedRuns.size()) {
+        runIdx = uncachedRuns[nextRunIdx];
+        nextRunIdx++;
+    }
+    pthread_mutex_unlock(&runMutex);
+    return runIdx;
+}
+
+void SignalOptimizerClass::makeRunParams(const vector< int > &times,
+                                         const int replicationNum,
+                                         SimulationParamsStruct &outParams)
+                                         const {
+    outParams = baseParams;
+    outParams.randomSeedVal = baseParams.randomSeedVal + replicationNum;
+    outParams.eastWestGreenTime = times[TIMING_EW_GREEN];
+    outParams.eastWestYellowTime = times[TIMING_EW_YELLOW];
+    outParams.northSouthGreenTime = times[TIMING_NS_GREEN];
+    outParams.northSouthYellowTime = times[TIMING_NS_YELLOW];
+}
+
+double SignalOptimizerClass::getObjective(const SimulationStatsStruct &stats,
+                                          const double meanDelay) const {
+    if (objective == OPTIMIZE_DELAY) {
+        return meanDelay;
+    }
+    return *max_element(stats.maxQueueLengths,
+                        stats.maxQueueLengths + NUM_DIRECTIONS);
+}
+
+bool SignalOptimizerClass::getIsCaching() {
+    return resultCache.getIsOpen() &&
+           !simPool.getSimulation(0).getUsesOptionalModelParameters();
+}
+
+bool SignalOptimizerClass::scoreTimings(const vector< vector< int > > &timings,
+                                        vector< double > &outScores) {
+    const int numThreads = getNumThreads();
+    const bool isCaching = getIsCaching();
+    IntersectionSimulationClass &firstSim = simPool.getSimulation(0);
+    vector< pthread_t > threads(numThreads);
+    vector< WorkerStruct > workers(numThreads);
+    int numStarted = 0;
+    SimulationParamsStruct params;
+    ResultCacheKeyStruct key;
+
+    // A timing always scores the same, so only new ones are run (once
+    // each, even if sampled twice)
+    pendingTimes.clear();
+    for (int i = 0; i < (int)timings.size(); i++) {
+        if (scores.find(timings[i]) == scores.end() &&
+            find(pendingTimes.begin(), pendingTimes.end(), timings[i]) ==
+            pendingTimes.end()) {
+            pendingTimes.push_back(timings[i]);
+        }
+    }
+    const int numRuns = (int)pendingTimes.size() * numReplications;
+    runStats.assign(numRuns, SimulationStatsStruct());
+    runDelays.assign(numRuns, 0.0);
+    uncachedRuns.clear();
+    nextRunIdx = 0;
+
+    // Runs made before, by this search or any other, are looked up first
+    for (int runIdx = 0; runIdx < numRuns; runIdx++) {
+        makeRunParams(pendingTimes[runIdx / numReplications],
+                      runIdx % numReplications, params);
+        ResultCacheClass::makeKey(params, firstSim.getIsUsingSubstreams(),
+                                  firstSim.getIsAntithetic(), key);
+        if (isCaching &&
+            resultCache.lookup(key, runStats[runIdx], runDelays[runIdx])) {
+            numCachedRuns++;
+        }
+        else {
+            uncachedRuns.push_back(runIdx);
+        }
+    }
+
+    if (!uncachedRuns.empty()) {
+        for (int i = 0; i < numThreads; i++) {
+            workers[i].optimizer = this;
+            workers[i].simObj = &simPool.getSimulation(i);
+            if (pthread_create(&threads[i], NULL, runWorker,
+                               &workers[i]) != 0) {
+                break;
+            }
+            numStarted++;
+        }
+        for (int i = 0; i < numStarted; i++) {
+            pthread_join(threads[i], NULL);
+        }
+        if (numStarted < numThreads) {
+            return false;
+        }
+    }
+
+    for (int i = 0; isCaching && i < (int)uncachedRuns.size(); i++) {
+        const int runIdx = uncachedRuns[i];
+        makeRunParams(pendingTimes[runIdx / numReplications],
+                      runIdx % numReplications, params);
+        ResultCacheClass::makeKey(params, firstSim.getIsUsingSubstreams(),
+                                  firstSim.getIsAntithetic(), key);
+        resultCache.store(key, runStats[runIdx], runDelays[runIdx]);
+    }
+
+    for (int i = 0; i < (int)pendingTimes.size(); i++) {
+        double scoreSum = 0;
+        for (int rep = 0; rep < numReplications; rep++) {
+            const int runIdx = i * numReplications + rep;
+            scoreSum += getObjective(runStats[runIdx], runDelays[runIdx]);
+        }
+        const double score = scoreSum / numReplications;
+        scores[pendingTimes[i]] = score;
+        if (bestTimes.empty() || score < bestScore) {
+            bestTimes = pendingTimes[i];
+            bestScore = score;
+        }
+    }
+
+    outScores.resize(timings.size());
+    for (int i = 0; i < (int)timings.size(); i++) {
+        outScores[i] = scores[timings[i]];
+    }
+    return true;
+}
+
+void SignalOptimizerClass::unscale(const double scaledPoint[NUM_TIMINGS],
+                                   vector< int > &outTimes) const {
+    outTimes.resize(NUM_TIMINGS);
+    for (int i = 0; i < NUM_TIMINGS; i++) {
+        outTimes[i] = minTimes[i] + (int)floor(
+            scaledPoint[i] * (maxTimes[i] - minTimes[i]) + 0.5);
+    }
+}
+
+double SignalOptimizerClass::drawNormal() {
+    // Box-Muller; the stream's uniforms are never exactly 0 or 1
+    const double radius = sqrt(-2.0 * log(sampleStream.getUniformReal()));
+    return radius * cos(TWO_PI * sampleStream.getUniformReal());
+}
+
+double SignalOptimizerClass::getMaxSpread() const {
+    double maxSpread = 0;
+
+    for (int i = 0; i < NUM_TIMINGS; i++) {
+        maxSpread = max(maxSpread, stepSize * sqrt(diagCovariance[i]) *
+                                   (maxTimes[i] - minTimes[i]));
+    }
+    return maxSpread;
+}
+
+bool SignalOptimizerClass::run(const int maxGenerations,
+                               ostream *progressStream) {
+    // Weights of the best half of the candidates, largest for the best
+    const int numParents = OPTIMIZER_POPULATION_SIZE / 2;
+    vector< double > weights(numParents);
+    double weightSum = 0;
+    double weightSquaresSum = 0;
+    for (int k = 0; k < numParents; k++) {
+        weights[k] = log(numParents + 0.5) - log(k + 1.0);
+        weightSum += weights[k];
+    }
+    for (int k = 0; k < numParents; k++) {
+        weights[k] /= weightSum;
+        weightSquaresSum += weights[k] * weights[k];
+    }
+
+    // The standard learning rates, the covariance ones raised by
+    // (n + 2) / 3 as only its diagonal is learned
+    const double numDims = NUM_TIMINGS;
+    const double effectiveParents = 1.0 / weightSquaresSum;
+    const double pathRate = (4.0 + effectiveParents / numDims) /
+                            (numDims + 4.0 + 2.0 * effectiveParents / numDims);
+    const double stepPathRate = (effectiveParents + 2.0) /
+                                (numDims + effectiveParents + 5.0);
+    const double stepDamping = 1.0 + stepPathRate + 2.0 * max(0.0,
+        sqrt((effectiveParents - 1.0) / (numDims + 1.0)) - 1.0);
+    const double rankOneRate = (numDims + 2.0) / 3.0 * 2.0 /
+        ((numDims + 1.3) * (numDims + 1.3) + effectiveParents);
+    const double rankParentsRate = min(1.0 - rankOneRate,
+        (numDims + 2.0) / 3.0 * 2.0 *
+        (effectiveParents - 2.0 + 1.0 / effectiveParents) /
+        ((numDims + 2.0) * (numDims + 2.0) + effectiveParents));
+    const double expectedNormLength = sqrt(numDims) *
+        (1.0 - 1.0 / (4.0 * numDims) + 1.0 / (21.0 * numDims * numDims));
+
+    vector< vector< int > > timings(1);
+    vector< double > candidateScores;
+    double candidates[OPTIMIZER_POPULATION_SIZE][NUM_TIMINGS];
+    double steps[OPTIMIZER_POPULATION_SIZE][NUM_TIMINGS];
+    vector< int > order(OPTIMIZER_POPULATION_SIZE);
+
+    scores.clear();
+    bestTimes.clear();
+    numGenerations = 0;
+    numCachedRuns = 0;
+    if (getNumThreads() == 0 || maxGenerations <= 0) {
+        return false;
+    }
+
+    // The file's own timings, as a baseline and the search's start
+    timings[0].resize(NUM_TIMINGS);
+    timings[0][TIMING_EW_GREEN] = baseParams.eastWestGreenTime;
+    timings[0][TIMING_EW_YELLOW] = baseParams.eastWestYellowTime;
+    timings[0][TIMING_NS_GREEN] = baseParams.northSouthGreenTime;
+    timings[0][TIMING_NS_YELLOW] = baseParams.northSouthYellowTime;
+    if (!scoreTimings(timings, candidateScores)) {
+        return false;
+    }
+    initialScore = candidateScores[0];
+
+    for (int i = 0; i < NUM_TIMINGS; i++) {
+        const int clampedTime = min(max(timings[0][i], minTimes[i]),
+                                    maxTimes[i]);
+        searchMean[i] = (maxTimes[i] == minTimes[i]) ? 0.0 :
+                        (double)(clampedTime - minTimes[i]) /
+                        (maxTimes[i] - minTimes[i]);
+        diagCovariance[i] = 1.0;
+        covariancePath[i] = 0.0;
+        stepSizePath[i] = 0.0;
+    }
+    stepSize = INITIAL_STEP_SIZE;
+    sampleStream.seedSubstream(OPTIMIZER_SAMPLE_SEED,
+                               OPTIMIZER_SAMPLE_STREAM_ID);
+
+    timings.resize(OPTIMIZER_POPULATION_SIZE);
+    while (numGenerations < maxGenerations &&
+           getMaxSpread() >= OPTIMIZER_MIN_SPREAD) {
+        // Sample, clamping to the bounds; the step taken is the clamped
+        // one, so the update learns from where candidates really were
+        for (int k = 0; k < OPTIMIZER_POPULATION_SIZE; k++) {
+            for (int i = 0; i < NUM_TIMINGS; i++) {
+                const double point = searchMean[i] + stepSize *
+                    sqrt(diagCovariance[i]) * drawNormal();
+                candidates[k][i] = min(max(point, 0.0), 1.0);
+                steps[k][i] = (candidates[k][i] - searchMean[i]) / stepSize;
+            }
+            unscale(candidates[k], timings[k]);
+        }
+        if (!scoreTimings(timings, candidateScores)) {
+            return false;
+        }
+        numGenerations++;
+
+        CandidateOrderStruct byScore;
+        byScore.candidateScores = &candidateScores;
+        for (int k = 0; k < OPTIMIZER_POPULATION_SIZE; k++) {
+            order[k] = k;
+        }
+        sort(order.begin(), order.end(), byScore);
+
+        // Move the mean to the weighted best half, and follow where it
+        // has been going
+        double stepPathSquares = 0;
+        double meanSteps[NUM_TIMINGS];
+        for (int i = 0; i < NUM_TIMINGS; i++) {
+            meanSteps[i] = 0;
+            for (int k = 0; k < numParents; k++) {
+                meanSteps[i] += weights[k] * steps[order[k]][i];
+            }
+            searchMean[i] += stepSize * meanSteps[i];
+            stepSizePath[i] = (1.0 - stepPathRate) * stepSizePath[i] +
+                sqrt(stepPathRate * (2.0 - stepPathRate) * effectiveParents) *
+                meanSteps[i] / sqrt(diagCovariance[i]);
+            stepPathSquares += stepSizePath[i] * stepSizePath[i];
+        }
+        const double stepPathLength = sqrt(stepPathSquares);
+
+        // Stop the covariance path growing while the step size catches up
+        const bool isPathStalled = stepPathLength /
+            sqrt(1.0 - pow(1.0 - stepPathRate, 2.0 * numGenerations)) /
+            expectedNormLength >= 1.4 + 2.0 / (numDims + 1.0);
+        for (int i = 0; i < NUM_TIMINGS; i++) {
+            covariancePath[i] = (1.0 - pathRate) * covariancePath[i] +
+                (isPathStalled ? 0.0 : sqrt(pathRate * (2.0 - pathRate) *
+                                            effectiveParents) * meanSteps[i]);
+            double parentsSquares = 0;
+            for (int k = 0; k < numParents; k++) {
+                parentsSquares += weights[k] * steps[order[k]][i] *
+                                  steps[order[k]][i];
+            }
+            diagCovariance[i] =
+                (1.0 - rankOneRate - rankParentsRate) * diagCovariance[i] +
+                rankOneRate * (covariancePath[i] * covariancePath[i] +
+                               (isPathStalled ? pathRate * (2.0 - pathRate) *
+                                                diagCovariance[i] : 0.0)) +
+                rankParentsRate * parentsSquares;
+        }
+        stepSize *= exp((stepPathRate / stepDamping) *
+                        (stepPathLength / expectedNormLength - 1.0));
+
+        if (progressStream != NULL) {
+            *progressStream << "Generation: " << numGenerations << " Best: ";
+            printTimes(*progressStream, bestTimes);
+            *progressStream << " " << OBJECTIVE_NAMES[objective] << ": " <<
+                               bestScore << " Spread: " << getMaxSpread() <<
+                               " Timings run: " << getNumScored() << endl;
+        }
+    }
+    return true;
+}
+
+void SignalOptimizerClass::print(ostream &outStream) const {
+    vector< int > initialTimes(NUM_TIMINGS);
+
+    initialTimes[TIMING_EW_GREEN] = baseParams.eastWestGreenTime;
+    initialTimes[TIMING_EW_YELLOW] = baseParams.eastWestYellowTime;
+    initialTimes[TIMING_NS_GREEN] = baseParams.northSouthGreenTime;
+    initialTimes[TIMING_NS_YELLOW] = baseParams.northSouthYellowTime;
+    outStream << "File timings: ";
+    printTimes(outStream, initialTimes);
+    outStream << " " << OBJECTIVE_NAMES[objective] << ": " << initialScore <<
+                 endl;
+    outStream << "Best timings: ";
+    printTimes(outStream, bestTimes);
+    outStream << " " << OBJECTIVE_NAMES[objective] << ": " << bestScore <<
+                 endl;
+    outStream << "Generations: " << numGenerations << " Timings run: " <<
+                 getNumScored() << " Replications each: " <<
+                 numReplications;
+    if (resultCache.getIsOpen()) {
+        outStream << " Runs cached: " << numCachedRuns;
+    }
+    outStream << endl;
+}
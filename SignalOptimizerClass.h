@@ -0,0 +1,287 @@
+#ifndef _SIGNALOPTIMIZERCLASS_H_
+#define _SIGNALOPTIMIZERCLASS_H_
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <pthread.h>
+
+#include "IntersectionSimulationClass.h"
+#include "SimulationPoolClass.h"
+#include "RandomStreamClass.h"
+#include "SimulationStructs.h"
+#include "ResultCacheClass.h"
+
+//The light timings searched, in the order they are kept in
+const int TIMING_EW_GREEN = 0;
+const int TIMING_EW_YELLOW = 1;
+const int TIMING_NS_GREEN = 2;
+const int TIMING_NS_YELLOW = 3;
+const int NUM_TIMINGS = 4;
+
+//What the optimizer minimizes, averaged over the replications
+const int OPTIMIZE_DELAY = 0; //Mean tics cars wait in their queues
+const int OPTIMIZE_MAX_QUEUE = 1; //Longest queue of any approach
+
+//Range each timing is searched over unless setBounds says otherwise
+const int OPTIMIZER_MIN_GREEN_TIME = 1;
+const int OPTIMIZER_MAX_GREEN_TIME = 120;
+const int OPTIMIZER_MIN_YELLOW_TIME = 1;
+const int OPTIMIZER_MAX_YELLOW_TIME = 10;
+
+//Candidate timings sampled every generation (4 + 3 ln 4, the usual
+//population for a 4-dimensional search)
+const int OPTIMIZER_POPULATION_SIZE = 8;
+
+//The search ends once no timing's sampling spread is above this many
+//tics, as every candidate would then round to the same timings
+const double OPTIMIZER_MIN_SPREAD = 0.2;
+
+//Seed and stream id of the optimizer's own draws, so its search is the
+//same every time
+const int OPTIMIZER_SAMPLE_SEED = 20261018;
+const int OPTIMIZER_SAMPLE_STREAM_ID = 1000;
+
+//Programmer: James Zhu
+//Date: October 2026
+//Purpose: Searches the east-west and north-south green and yellow times
+//         of a parameter file for the ones that minimize the mean car
+//         delay or the longest queue, running the simulation in process
+//         on several threads.
+//
+//         The search is a CMA-ES evolution strategy with a diagonal
+//         covariance (separable CMA-ES): each generation samples
+//         OPTIMIZER_POPULATION_SIZE timings around the current mean,
+//         scaled to the bounds, and moves the mean, step size and
+//         per-timing spread towards the best half of them.  It needs no
+//         gradients, so the noisy, integer-valued objective is fine.
+//
+//         Every candidate is judged on the same replications (the file's
+//         seed increased by 0, 1, ...) with substreams on, so all of them
+//         see the same arrivals and drivers (common random numbers), and
+//         differences between them are down to the timings.  So a timing
+//         always scores the same, and each distinct one is only ever run
+//         once.  A generation's runs (candidate and replication pairs)
+//         are shared out over the threads, and each candidate's score is
+//         averaged in replication order, so the search is exactly the
+//         same whatever the number of threads.
+//
+//         With a result cache set up, runs made before (by any search or
+//         sweep using the same cache) are answered from it instead, as
+//         long as the file uses only the required parameters (and the
+//         random stream settings).  A cached run gives the same
+//         statistics as running it, so the search is still the same.
+class SignalOptimizerClass
+{
+  private:
+    SimulationPoolClass simPool; //One simulation per thread
+    ResultCacheClass resultCache; //Results of earlier runs, if open
+    SimulationParamsStruct baseParams; //As read from the file
+    int objective; //OPTIMIZE_* value minimized
+    int numReplications; //Runs each candidate is judged on
+    int minTimes[NUM_TIMINGS]; //Smallest value of each timing searched
+    int maxTimes[NUM_TIMINGS]; //Largest value of each timing searched
+
+    //State of the search, each timing scaled so its bounds are 0 and 1
+    double searchMean[NUM_TIMINGS]; //Center of the sampling distribution
+    double stepSize; //Overall scale of the sampling distribution
+    double diagCovariance[NUM_TIMINGS]; //Relative variance of each timing
+    double covariancePath[NUM_TIMINGS]; //Recent movement of the mean
+    double stepSizePath[NUM_TIMINGS]; //Same, in the unscaled distribution
+    RandomStreamClass sampleStream; //Draws of the candidates
+    int numGenerations; //Generations run so far
+
+    std::map< std::vector< int >, double > scores; //Of every timing run
+    std::vector< int > bestTimes; //Lowest scoring timing so far
+    double bestScore; //Its score
+    double initialScore; //Score of the file's own timings
+
+    //Runs of the evaluation in progress, each a (timing, replication)
+    //pair
+    std::vector< std::vector< int > > pendingTimes; //Timings to run
+    std::vector< SimulationStatsStruct > runStats; //Of each run
+    std::vector< double > runDelays; //Mean car delay of each run
+    std::vector< int > uncachedRuns; //Runs not answered from the cache
+    int nextRunIdx; //Next of uncachedRuns a thread will take
+    pthread_mutex_t runMutex; //Guards nextRunIdx
+    int numCachedRuns; //Runs the last run answered from the cache
+
+    //What one thread is given to work with
+    struct WorkerStruct
+    {
+      SignalOptimizerClass *optimizer;
+      IntersectionSimulationClass *simObj;
+    };
+
+    //Thread body: does runs with the given simulation until none is
+    //left.  The argument is a WorkerStruct.
+    static void* runWorker(
+         void *workerPtr
+         );
+
+    //Returns the next run to do, or -1 if none is left.
+    int takeRun(
+         );
+
+    //Fills in the parameters of a run of one timing on one replication.
+    void makeRunParams(
+         const std::vector< int > &times,
+         const int replicationNum,
+         SimulationParamsStruct &outParams
+         ) const;
+
+    //Returns the objective of a run with the given statistics and mean
+    //car delay.
+    double getObjective(
+         const SimulationStatsStruct &stats,
+         const double meanDelay
+         ) const;
+
+    //Returns true if runs are looked up in and added to the result
+    //cache, i.e. one is open and the file uses only the required
+    //parameters and the random stream settings.
+    bool getIsCaching(
+         );
+
+    //Scores each timing (running only the ones not scored before, and
+    //of their runs only the ones not cached) into outScores, and keeps
+    //the best.  Returns false if a thread can't be started.
+    bool scoreTimings(
+         const std::vector< std::vector< int > > &timings,
+         std::vector< double > &outScores
+         );
+
+    //Converts a scaled point to whole tics within the bounds.
+    void unscale(
+         const double scaledPoint[NUM_TIMINGS],
+         std::vector< int > &outTimes
+         ) const;
+
+    //Returns a standard normal draw from the sample stream.
+    double drawNormal(
+         );
+
+    //Returns the largest sampling spread of any timing, in tics.
+    double getMaxSpread(
+         ) const;
+
+    //Copying would share the simulations; not allowed.
+    SignalOptimizerClass(
+         const SignalOptimizerClass &other
+         );
+    SignalOptimizerClass& operator=(
+         const SignalOptimizerClass &other
+         );
+
+  public:
+    //Creates an optimizer without simulations, with the default bounds.
+    SignalOptimizerClass(
+         );
+
+    ~SignalOptimizerClass(
+         );
+
+    //Reads the parameter file into a simulation pool of one simulation
+    //per thread, to minimize the given OPTIMIZE_* objective over the
+    //given number of replications.  Returns false, keeping no
+    //simulations, if a number isn't positive, the objective is unknown
+    //or the pool refuses the file.
+    bool setup(
+         const std::string &paramFname,
+         const int numThreads,
+         const int inNumReplications,
+         const int inObjective
+         );
+
+    //Opens the result cache file (creating it if need be) that runs
+    //check first and add their results to.  Returns false if it can't
+    //be opened.
+    bool setupCache(
+         const std::string &cacheFname
+         );
+
+    //Returns the result cache, which is open if setupCache succeeded.
+    const ResultCacheClass& getResultCache(
+         ) const
+    {
+      return resultCache;
+    }
+
+    //Sets the range a TIMING_* timing is searched over.  Returns false
+    //if the timing is unknown or the range is empty or not positive.
+    bool setBounds(
+         const int timingIdx,
+         const int minTime,
+         const int maxTime
+         );
+
+    //Returns the number of threads runs are done on.
+    int getNumThreads(
+         ) const
+    {
+      return simPool.getNumSimulations();
+    }
+
+    //Scores the file's own timings, then runs up to maxGenerations
+    //generations of the search from them (clamped to the bounds),
+    //stopping early once it has converged.  Prints a line per generation
+    //to progressStream, unless NULL.  Returns false if it isn't set up,
+    //the number isn't positive or a thread can't be started.
+    bool run(
+         const int maxGenerations,
+         std::ostream *progressStream
+         );
+
+    //Returns the number of generations the last run went through.
+    int getNumGenerations(
+         ) const
+    {
+      return numGenerations;
+    }
+
+    //Returns the number of (timing, replication) runs the last run
+    //answered from the result cache.
+    int getNumCachedRuns(
+         ) const
+    {
+      return numCachedRuns;
+    }
+
+    //Returns the number of distinct timings the last run scored.
+    int getNumScored(
+         ) const
+    {
+      return (int)scores.size();
+    }
+
+    //Returns a TIMING_* value of the best timings found.
+    int getBestTime(
+         const int timingIdx
+         ) const
+    {
+      return bestTimes[timingIdx];
+    }
+
+    //Returns the objective of the best timings found.
+    double getBestScore(
+         ) const
+    {
+      return bestScore;
+    }
+
+    //Returns the objective of the file's own timings.
+    double getInitialScore(
+         ) const
+    {
+      return initialScore;
+    }
+
+    //Prints the file's timings and the best found, with their objective,
+    //and how many timings were run (and runs answered from the cache).
+    void print(
+         std::ostream &outStream
+         ) const;
+};
+
+#endif // _SIGNALOPTIMIZERCLASS_H_
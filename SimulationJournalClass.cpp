@@ -0,0 +1,445 @@
+// James Zhu
+// October 2026
+// Implementation of the SimulationJournalClass, which journals a run so
+// it can be revisited at any step from periodic snapshots.
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include <cstdlib>
+#include <cerrno>
+#include <stdint.h>
+using namespace std;
+
+#include <unistd.h>
+
+#include "SimulationJournalClass.h"
+#include "RandomStreamClass.h"
+
+// Creates a temporary file, already removed so it goes once closed.
+// Returns its descriptor, or -1 if it couldn't be created.
+static int openTempFile() {
+    const char *tmpDir = getenv("TMPDIR");
+    const string dirName = (tmpDir != NULL && tmpDir[0] != '\0' ?
+                            string(tmpDir) : string("/tmp"));
+    const string fnameTemplate = dirName + "/simjournalXXXXXX";
+    vector< char > fname(fnameTemplate.begin(), fnameTemplate.end());
+
+    fname.push_back('\0');
+    const int fileDesc = mkstemp(&fname[0]);
+    if (fileDesc >= 0) {
+        unlink(&fname[0]);
+    }
+    return fileDesc;
+}
+
+// Writes all of the data at an offset of a file, retrying short and
+// interrupted writes.
+static bool writeFully(const int fileDesc, const void *data,
+                       const size_t length, const int64_t offset) {
+    const char *bytes = (const char *)data;
+    size_t numWritten = 0;
+
+    while (numWritten < length) {
+        const ssize_t numBytes = pwrite(fileDesc, bytes + numWritten,
+                                        length - numWritten,
+                                        offset + numWritten);
+        if (numBytes < 0 && errno == EINTR) {
+            continue;
+        }
+        if (numBytes <= 0) {
+            return false;
+        }
+        numWritten += numBytes;
+    }
+    return true;
+}
+
+// Reads all of the data at an offset of a file.  Returns false at the end
+// of the file.
+static bool readFully(const int fileDesc, void *data, const size_t length,
+                      const int64_t offset) {
+    char *bytes = (char *)data;
+    size_t numRead = 0;
+
+    while (numRead < length) {
+        const ssize_t numBytes = pread(fileDesc, bytes + numRead,
+                                       length - numRead, offset + numRead);
+        if (numBytes < 0 && errno == EINTR) {
+            continue;
+        }
+        if (numBytes <= 0) {
+            return false;
+        }
+        numRead += numBytes;
+    }
+    return true;
+}
+
+SimulationJournalClass::SimulationJournalClass()
+ : entryFileDesc(-1), chunkIdx(-1), numSteps(0), snapshotInterval(0),
+   snapshotBytes(0), currentStep(0), isDiverged(false) {
+    for (int i = 0; i < NUM_LANE_QUEUES; i++) {
+        laneFileDescs[i] = -1;
+        numLaneCars[i] = 0;
+        lastLaneCarIds[i] = CAR_ID_NOT_SET;
+    }
+}
+
+SimulationJournalClass::~SimulationJournalClass() {
+    closeFiles();
+}
+
+void SimulationJournalClass::closeFiles() {
+    if (entryFileDesc >= 0) {
+        close(entryFileDesc);
+        entryFileDesc = -1;
+    }
+    for (int i = 0; i < NUM_LANE_QUEUES; i++) {
+        if (laneFileDescs[i] >= 0) {
+            close(laneFileDescs[i]);
+            laneFileDescs[i] = -1;
+        }
+    }
+}
+
+bool SimulationJournalClass::openFiles() {
+    closeFiles();
+    entryFileDesc = openTempFile();
+    bool success = (entryFileDesc >= 0);
+    for (int i = 0; i < NUM_LANE_QUEUES; i++) {
+        laneFileDescs[i] = openTempFile();
+        success = success && laneFileDescs[i] >= 0;
+        numLaneCars[i] = 0;
+        lastLaneCarIds[i] = CAR_ID_NOT_SET;
+    }
+    if (!success) {
+        closeFiles();
+    }
+    return success;
+}
+
+bool SimulationJournalClass::writeEntry(const JournalEntryStruct &entry) {
+    if (chunk.empty()) {
+        chunkStartTimes.push_back(entry.eventTime);
+    }
+    chunk.push_back(entry);
+    numSteps++;
+    return ((int)chunk.size() < JOURNAL_CHUNK_ENTRIES || flushEntries());
+}
+
+bool SimulationJournalClass::flushEntries() {
+    const int64_t firstStep = numSteps - (int64_t)chunk.size();
+
+    if (!chunk.empty() &&
+        !writeFully(entryFileDesc, &chunk[0],
+                    chunk.size() * sizeof(JournalEntryStruct),
+                    firstStep * (int64_t)sizeof(JournalEntryStruct))) {
+        return false;
+    }
+    chunk.clear();
+    return true;
+}
+
+bool SimulationJournalClass::readChunk(const int64_t stepNum) const {
+    const int64_t inChunkIdx = stepNum / JOURNAL_CHUNK_ENTRIES;
+    const int64_t firstStep = inChunkIdx * JOURNAL_CHUNK_ENTRIES;
+
+    if (inChunkIdx == chunkIdx) {
+        return true;
+    }
+    chunkIdx = -1;
+    chunk.resize((size_t)min((int64_t)JOURNAL_CHUNK_ENTRIES,
+                             numSteps - firstStep));
+    if (chunk.empty() ||
+        !readFully(entryFileDesc, &chunk[0],
+                   chunk.size() * sizeof(JournalEntryStruct),
+                   firstStep * (int64_t)sizeof(JournalEntryStruct))) {
+        return false;
+    }
+    chunkIdx = inChunkIdx;
+    return true;
+}
+
+int64_t SimulationJournalClass::getSnapshotBytes(
+         const JournalSnapshotStruct &snapshot) {
+    int64_t numBytes = sizeof(JournalSnapshotStruct);
+
+    // The lane queues are kept on file, but each still holds a slot
+    for (int i = 0; i < NUM_LANE_QUEUES; i++) {
+        numBytes += (int64_t)snapshot.state.laneQueues[i].getCapacity() *
+                    sizeof(CarClass);
+    }
+    // An event list node holds an event and two pointers
+    numBytes += (int64_t)snapshot.state.eventList.getNumElems() *
+                (sizeof(EventClass) + 2 * sizeof(void *));
+    return numBytes;
+}
+
+bool SimulationJournalClass::saveSnapshot(
+         const IntersectionSimulationClass &simObj) {
+    snapshots.push_back(JournalSnapshotStruct());
+    JournalSnapshotStruct &snapshot = snapshots.back();
+    vector< JournalCarStruct > newCars;
+    CarClass car;
+
+    simObj.saveStateWithoutQueues(snapshot.state);
+    for (int i = 0; i < NUM_LANE_QUEUES; i++) {
+        const RingQueueClass< CarClass > &laneQueue = simObj.getLaneQueue(i);
+        JournalLaneStruct &lane = snapshot.lanes[i];
+        const int numCars = laneQueue.getNumElems();
+        int firstNewIdx = numCars;
+
+        // Cars get their ids as they are queued, so the cars queued since
+        // the lane's file was last written are the ones after the last
+        // car in it, and those before were still queued then, so they are
+        // already the last ones in it
+        while (firstNewIdx > 0 &&
+               laneQueue.getElemAtIndex(firstNewIdx - 1, car) &&
+               car.getId() > lastLaneCarIds[i]) {
+            firstNewIdx--;
+        }
+        newCars.resize(numCars - firstNewIdx);
+        for (int k = firstNewIdx; k < numCars; k++) {
+            laneQueue.getElemAtIndex(k, car);
+            newCars[k - firstNewIdx].carId = car.getId();
+            newCars[k - firstNewIdx].arrivalTime = car.getArrivalTime();
+        }
+        if (!newCars.empty()) {
+            if (!writeFully(laneFileDescs[i], &newCars[0],
+                            newCars.size() * sizeof(JournalCarStruct),
+                            numLaneCars[i] *
+                            (int64_t)sizeof(JournalCarStruct))) {
+                return false;
+            }
+            lastLaneCarIds[i] = newCars.back().carId;
+        }
+        lane.firstCarIdx = numLaneCars[i] - firstNewIdx;
+        lane.numCars = numCars;
+        lane.capacity = laneQueue.getCapacity();
+        lane.isFixedCapacity = laneQueue.getIsFixedCapacity();
+        numLaneCars[i] += (int64_t)newCars.size();
+        snapshot.state.laneQueues[i].setCapacity(1, false);
+    }
+    snapshotBytes += getSnapshotBytes(snapshot);
+    return true;
+}
+
+bool SimulationJournalClass::restoreSnapshot(
+         IntersectionSimulationClass &simObj, const int snapshotIdx) const {
+    const JournalSnapshotStruct &snapshot = snapshots[snapshotIdx];
+    SimulationSnapshotStruct state = snapshot.state;
+    vector< JournalCarStruct > cars;
+    const int nextCarId = CarClass::getNextId();
+
+    for (int i = 0; i < NUM_LANE_QUEUES; i++) {
+        const JournalLaneStruct &lane = snapshot.lanes[i];
+
+        cars.resize(lane.numCars);
+        if (!cars.empty() &&
+            !readFully(laneFileDescs[i], &cars[0],
+                       cars.size() * sizeof(JournalCarStruct),
+                       lane.firstCarIdx *
+                       (int64_t)sizeof(JournalCarStruct))) {
+            CarClass::setNextId(nextCarId);
+            return false;
+        }
+        state.laneQueues[i].setCapacity(lane.capacity, lane.isFixedCapacity);
+        for (int k = 0; k < lane.numCars; k++) {
+            // A car gets the next id as it is made, so it is set to the
+            // car's own; restoring the state sets it back afterwards
+            CarClass::setNextId(cars[k].carId);
+            state.laneQueues[i].enqueue(CarClass(
+                DIRECTION_NAMES[i / NUM_LANES], cars[k].arrivalTime));
+        }
+    }
+    simObj.restoreState(state);
+    return true;
+}
+
+void SimulationJournalClass::thinSnapshots() {
+    const int numKept = ((int)snapshots.size() + 1) / 2;
+
+    for (int i = 1; i < numKept; i++) {
+        snapshots[i] = snapshots[2 * i];
+    }
+    snapshots.resize(numKept);
+    snapshotInterval *= 2;
+    snapshotBytes = 0;
+    for (int i = 0; i < numKept; i++) {
+        snapshotBytes += getSnapshotBytes(snapshots[i]);
+    }
+}
+
+bool SimulationJournalClass::record(IntersectionSimulationClass &simObj,
+                                    const int inSnapshotInterval) {
+    EventClass nextEvent;
+    bool success = true;
+
+    if (inSnapshotInterval <= 0 || !simObj.getIsSetupProperly() ||
+        !simObj.getCanSaveState()) {
+        return false;
+    }
+    snapshots.clear();
+    chunkStartTimes.clear();
+    chunk.clear();
+    chunkIdx = -1;
+    numSteps = 0;
+    snapshotInterval = inSnapshotInterval;
+    snapshotBytes = 0;
+    currentStep = 0;
+    isDiverged = false;
+    // Going to a step never handles more events than the larger of these
+    const int maxInterval = max(inSnapshotInterval,
+                                JOURNAL_MAX_SNAPSHOT_INTERVAL);
+
+    success = openFiles();
+    simObj.restart();
+    simObj.scheduleSeedEvents();
+    while (success) {
+        if (currentStep % snapshotInterval == 0) {
+            success = saveSnapshot(simObj);
+            while (snapshotBytes > JOURNAL_MAX_SNAPSHOT_BYTES &&
+                   snapshots.size() > 1 &&
+                   snapshotInterval <= maxInterval / 2) {
+                thinSnapshots();
+            }
+        }
+        // An event the run ends at instead of handling isn't a step
+        if (!success || !simObj.getNextEvent(nextEvent)) {
+            break;
+        }
+        const int64_t drawsBefore = RandomStreamClass::getNumSharedDraws();
+        if (!simObj.handleNextEvent()) {
+            break;
+        }
+
+        JournalEntryStruct entry;
+        entry.eventTime = nextEvent.getTimeOccurs();
+        entry.eventType = nextEvent.getType();
+        entry.numSharedDraws = (int)(RandomStreamClass::getNumSharedDraws() -
+                                     drawsBefore);
+        success = writeEntry(entry);
+        currentStep++;
+    }
+    success = success && flushEntries() && restoreSnapshot(simObj, 0);
+    currentStep = 0;
+    if (!success) {
+        closeFiles();
+        snapshots.clear();
+        chunkStartTimes.clear();
+        chunk.clear();
+        numSteps = 0;
+    }
+    return success;
+}
+
+bool SimulationJournalClass::getEntry(const int64_t stepNum,
+                                      JournalEntryStruct &outEntry) const {
+    if (stepNum < 0 || stepNum >= numSteps || !readChunk(stepNum)) {
+        return false;
+    }
+    outEntry = chunk[stepNum % JOURNAL_CHUNK_ENTRIES];
+    return true;
+}
+
+int64_t SimulationJournalClass::getStepAtTime(const int simTime) const {
+    int lowChunk = 0;
+    int highChunk = (int)chunkStartTimes.size();
+
+    // Events are journalled in time order, so the step is the first one
+    // whose event is after the time, which is in the last chunk starting
+    // at or before it (or starts the chunk after)
+    while (lowChunk < highChunk) {
+        const int midChunk = lowChunk + (highChunk - lowChunk) / 2;
+        if (chunkStartTimes[midChunk] <= simTime) {
+            lowChunk = midChunk + 1;
+        }
+        else {
+            highChunk = midChunk;
+        }
+    }
+    if (lowChunk == 0) {
+        return 0;
+    }
+
+    const int64_t firstStep = (int64_t)(lowChunk - 1) * JOURNAL_CHUNK_ENTRIES;
+    int lowIdx = 0;
+    int highIdx = 0;
+    if (readChunk(firstStep)) {
+        highIdx = (int)chunk.size();
+    }
+    while (lowIdx < highIdx) {
+        const int midIdx = lowIdx + (highIdx - lowIdx) / 2;
+        if (chunk[midIdx].eventTime <= simTime) {
+            lowIdx = midIdx + 1;
+        }
+        else {
+            highIdx = midIdx;
+        }
+    }
+    return firstStep + lowIdx;
+}
+
+bool SimulationJournalClass::replayTo(IntersectionSimulationClass &simObj,
+                                      const int64_t stepNum) {
+    EventClass nextEvent;
+
+    while (currentStep < stepNum) {
+        // A journal that can't be read back can't vouch for the replay
+        if (!readChunk(currentStep)) {
+            isDiverged = true;
+            return false;
+        }
+        const JournalEntryStruct &entry =
+            chunk[currentStep % JOURNAL_CHUNK_ENTRIES];
+        const int64_t drawsBefore = RandomStreamClass::getNumSharedDraws();
+
+        if (!simObj.getNextEvent(nextEvent) ||
+            nextEvent.getTimeOccurs() != entry.eventTime ||
+            nextEvent.getType() != entry.eventType ||
+            !simObj.handleNextEvent() ||
+            RandomStreamClass::getNumSharedDraws() - drawsBefore !=
+            entry.numSharedDraws) {
+            isDiverged = true;
+            return false;
+        }
+        currentStep++;
+    }
+    return true;
+}
+
+bool SimulationJournalClass::goToStep(IntersectionSimulationClass &simObj,
+                                      const int64_t stepNum) {
+    if (stepNum < 0 || stepNum > numSteps || snapshots.empty()) {
+        return false;
+    }
+    // Carrying on from the current step is cheaper than restoring a
+    // snapshot, unless there is a snapshot between the two
+    const int snapshotIdx = (int)(stepNum / snapshotInterval);
+    const int64_t snapshotStep = (int64_t)snapshotIdx * snapshotInterval;
+    if (isDiverged || stepNum < currentStep || snapshotStep > currentStep) {
+        if (!restoreSnapshot(simObj, snapshotIdx)) {
+            isDiverged = true;
+            return false;
+        }
+        currentStep = snapshotStep;
+        isDiverged = false;
+    }
+    return replayTo(simObj, stepNum);
+}
+
+bool SimulationJournalClass::stepForward(IntersectionSimulationClass &simObj) {
+    if (isDiverged || currentStep == numSteps) {
+        return false;
+    }
+    return replayTo(simObj, currentStep + 1);
+}
+
+void SimulationJournalClass::print(ostream &outStream) const {
+    outStream << "Steps: " << numSteps << " Snapshots: " <<
+                 snapshots.size() << " (every " << snapshotInterval <<
+                 " steps)";
+}
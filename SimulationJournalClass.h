@@ -0,0 +1,275 @@
+#ifndef _SIMULATIONJOURNALCLASS_H_
+#define _SIMULATIONJOURNALCLASS_H_
+
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <stdint.h>
+
+#include "IntersectionSimulationClass.h"
+
+//Most memory, in bytes, the snapshots of a recording may take
+const int64_t JOURNAL_MAX_SNAPSHOT_BYTES = (int64_t)256 * 1024 * 1024;
+
+//Most steps the snapshots are thinned out to, so going to any step
+//handles no more than this many events after restoring one
+const int JOURNAL_MAX_SNAPSHOT_INTERVAL = 65536;
+
+//Entries written to, and read back from, the journal file at a time
+const int JOURNAL_CHUNK_ENTRIES = 65536;
+
+//One handled event of a recorded run.
+struct JournalEntryStruct
+{
+  int eventTime; //When the event occurred
+  int eventType; //The event's EVENT_* type
+  int numSharedDraws; //Draws the event took from the shared rand()
+                      //generator (always 0 with substreams)
+};
+
+//One car of a lane queue, as written to the lane's car file.
+struct JournalCarStruct
+{
+  int carId; //The car's unique id
+  int arrivalTime; //When the car arrived
+};
+
+//Where the cars of one lane queue of a snapshot are kept.
+struct JournalLaneStruct
+{
+  int64_t firstCarIdx; //The car at the head of the queue, in the lane's
+                       //car file
+  int numCars; //Cars in the queue
+  int capacity; //Slots the queue had
+  bool isFixedCapacity; //Whether the queue had a fixed capacity
+};
+
+//A snapshot of a recorded run, with its lane queues kept on file.
+struct JournalSnapshotStruct
+{
+  SimulationSnapshotStruct state; //The run's state, with empty lane queues
+  JournalLaneStruct lanes[NUM_LANE_QUEUES]; //Where its lane queues' cars
+                                            //are
+};
+
+//Programmer: James Zhu
+//Date: October 2026
+//Purpose: Lets a run be revisited at any point without rerunning it from
+//         the start.  Recording the run once journals every event it
+//         handles, as a small entry, and saves the whole state of the run
+//         every snapshotInterval events.  Going to any step (the number
+//         of events handled) then restores the last snapshot at or
+//         before it and handles the few events in between, so going
+//         backwards costs no more than going forwards, however far into
+//         the run the step is.  A time is turned into a step by searching
+//         the journal.
+//
+//         The entries are written to a temporary file, a chunk of
+//         JOURNAL_CHUNK_ENTRIES at a time, and read back a chunk at a
+//         time, so only the first time of each chunk is kept in memory.
+//         The lane queues of the snapshots, which a queue that grows
+//         without bound makes most of their size, go to a temporary file
+//         per lane: a car still queued at the next snapshot is not
+//         written again, so each car is written at most once.  Should the
+//         rest of the snapshots still exceed JOURNAL_MAX_SNAPSHOT_BYTES,
+//         every other one is dropped, doubling the interval, but never
+//         past JOURNAL_MAX_SNAPSHOT_INTERVAL (or the interval asked for,
+//         if more).  The files are removed when the journal is destroyed.
+//
+//         Replayed events are checked against the journal, so a replay
+//         that doesn't repeat the recording is reported rather than
+//         trusted.  The narration of replayed events goes to the
+//         simulation's log stream as usual, so it is set to NULL to go
+//         to a step silently.
+class SimulationJournalClass
+{
+  private:
+    int entryFileDesc; //Temporary file of every handled event's entry, in
+                       //step order, or -1 if none
+    int laneFileDescs[NUM_LANE_QUEUES]; //Temporary file of the cars of
+                                        //each lane queue at the snapshots,
+                                        //in queue order, or -1 if none
+    int64_t numLaneCars[NUM_LANE_QUEUES]; //Cars written to each lane's file
+    int lastLaneCarIds[NUM_LANE_QUEUES]; //Id of the last car written to
+                                         //each lane's file
+    std::vector< int > chunkStartTimes; //Time of the first event of each
+                                        //chunk of entries
+    mutable std::vector< JournalEntryStruct > chunk; //The chunk of entries
+                                                     //being written, or
+                                                     //last read
+    mutable int64_t chunkIdx; //Chunk last read, or -1 if none
+    int64_t numSteps; //Events the recorded run handled
+    std::deque< JournalSnapshotStruct > snapshots; //State at every
+                                                   //snapshotInterval steps
+                                                   //from step 0
+    int snapshotInterval; //Steps between snapshots
+    int64_t snapshotBytes; //Memory the snapshots take
+    int64_t currentStep; //Step the simulation is at
+    bool isDiverged; //Whether a replay stopped matching the journal
+
+    //Closes and so removes the temporary files.
+    void closeFiles(
+         );
+
+    //Creates the temporary files, removing any made before.  Returns
+    //false if one couldn't be created.
+    bool openFiles(
+         );
+
+    //Adds an entry to the chunk being written, writing the chunk to the
+    //entry file once it is full.  Returns false if the file couldn't be
+    //written.
+    bool writeEntry(
+         const JournalEntryStruct &entry
+         );
+
+    //Writes whatever there is of the chunk being written to the entry
+    //file.  Returns false if the file couldn't be written.
+    bool flushEntries(
+         );
+
+    //Makes the chunk the one holding the given step's entry, reading it
+    //from the entry file unless it is already.  Returns false if it
+    //couldn't be read.
+    bool readChunk(
+         const int64_t stepNum
+         ) const;
+
+    //Saves the state of the simulation as a new snapshot, writing the
+    //cars not already in the lane files to them.  Returns false if a
+    //lane file couldn't be written.
+    bool saveSnapshot(
+         const IntersectionSimulationClass &simObj
+         );
+
+    //Puts the simulation in the state of the given snapshot, reading its
+    //lane queues back from the lane files.  Returns false, leaving the
+    //simulation as it was, if they couldn't be read.
+    bool restoreSnapshot(
+         IntersectionSimulationClass &simObj,
+         const int snapshotIdx
+         ) const;
+
+    //Handles events until the simulation is at the given step, which is
+    //no earlier than the current one, checking each against the journal.
+    //Returns false, at the step it diverged, if the replay didn't match.
+    bool replayTo(
+         IntersectionSimulationClass &simObj,
+         const int64_t stepNum
+         );
+
+    //Returns the memory a snapshot takes, its lane queues being on file.
+    static int64_t getSnapshotBytes(
+         const JournalSnapshotStruct &snapshot
+         );
+
+    //Drops every other snapshot, keeping step 0's, and doubles the
+    //interval.
+    void thinSnapshots(
+         );
+
+    //Copying a journal would share its files, so it is not allowed.
+    SimulationJournalClass(
+         const SimulationJournalClass &other
+         );
+
+    //Assigning a journal would share its files, so it is not allowed.
+    SimulationJournalClass& operator=(
+         const SimulationJournalClass &other
+         );
+
+  public:
+    //Creates an empty journal.
+    SimulationJournalClass(
+         );
+
+    //Removes the journal's temporary files.
+    ~SimulationJournalClass(
+         );
+
+    //Restarts the simulation and runs it to the end, journalling it with
+    //a snapshot every inSnapshotInterval steps (or a multiple of it, if
+    //the snapshots get too big).  The simulation must be
+    //set up properly and able to save its state.  Returns false, having
+    //run nothing, if not or if the interval isn't positive, and with
+    //nothing recorded if the journal's temporary files couldn't be
+    //written.  The simulation is left at step 0, with the seed events
+    //scheduled.
+    bool record(
+         IntersectionSimulationClass &simObj,
+         const int inSnapshotInterval
+         );
+
+    //Returns the number of events the recorded run handled, which is
+    //also the last step.
+    int64_t getNumSteps(
+         ) const
+    {
+      return numSteps;
+    }
+
+    //Returns the number of snapshots saved.
+    int getNumSnapshots(
+         ) const
+    {
+      return (int)snapshots.size();
+    }
+
+    //Returns the number of steps between snapshots.
+    int getSnapshotInterval(
+         ) const
+    {
+      return snapshotInterval;
+    }
+
+    //Returns the step the simulation is at.
+    int64_t getCurrentStep(
+         ) const
+    {
+      return currentStep;
+    }
+
+    //Returns true if a replay stopped matching the journal, in which case
+    //the simulation is not where the journal says it is.
+    bool getIsDiverged(
+         ) const
+    {
+      return isDiverged;
+    }
+
+    //Reads into outEntry the entry of the event handled to go from the
+    //given step to the next.  Returns false if the step is out of range
+    //or the entry couldn't be read.
+    bool getEntry(
+         const int64_t stepNum,
+         JournalEntryStruct &outEntry
+         ) const;
+
+    //Returns the step at which every event at or before the given time
+    //has been handled, and none after it.
+    int64_t getStepAtTime(
+         const int simTime
+         ) const;
+
+    //Puts the simulation (the one recorded, or one with the same
+    //parameters) at the given step, between 0 and the number of steps.
+    //Returns false if the step is out of range or the replay diverged (a
+    //journal that can't be read back counts as diverging).
+    bool goToStep(
+         IntersectionSimulationClass &simObj,
+         const int64_t stepNum
+         );
+
+    //Handles the next event, moving the simulation one step on.  Returns
+    //false if it is at the last step or the replay diverged.
+    bool stepForward(
+         IntersectionSimulationClass &simObj
+         );
+
+    //Prints the size of the journal on a single line.
+    void print(
+         std::ostream &outStream
+         ) const;
+};
+
+#endif // _SIMULATIONJOURNALCLASS_H_
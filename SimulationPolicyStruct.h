@@ -0,0 +1,43 @@
+#ifndef _SIMULATIONPOLICYSTRUCT_H_
+#define _SIMULATIONPOLICYSTRUCT_H_
+
+//Number of distinct policies, one per combination of the features below
+const int NUM_SIMULATION_KERNELS = 16;
+
+//Programmer: James Zhu
+//Date: October 2026
+//Purpose: The compile-time configuration that the simulation's event
+//         handling is specialized on.  Each feature that costs a check on
+//         every event is a template flag.  With the flag false the feature
+//         is compiled out of the kernel altogether, so its checks cost
+//         nothing.  With it true the feature is compiled in and still
+//         checked at run time, so the kernel with every flag true is the
+//         generic one that handles any configuration.  The simulation
+//         runs the kernel whose flags match exactly the features in use.
+template <bool MAY_LOG, bool MAY_USE_SATURATION_FLOW, bool MAY_MONITOR,
+          bool MAY_USE_CONTROLLER>
+struct SimulationPolicyStruct
+{
+  static const bool HAS_LOGGING = MAY_LOG; //Events may be narrated
+  static const bool HAS_SATURATION_FLOW = MAY_USE_SATURATION_FLOW;
+                                           //Cars may depart via
+                                           //departure events
+  static const bool HAS_MONITORS = MAY_MONITOR; //Warm-up detection,
+                                                //convergence stopping or
+                                                //time series sampling
+                                                //may be on
+  static const bool HAS_CONTROLLER = MAY_USE_CONTROLLER; //A signal
+                                                         //controller may
+                                                         //pick green times
+
+  //Position of this policy's kernel in a table of all of them
+  static const int KERNEL_INDEX = (MAY_LOG ? 8 : 0) +
+                                  (MAY_USE_SATURATION_FLOW ? 4 : 0) +
+                                  (MAY_MONITOR ? 2 : 0) +
+                                  (MAY_USE_CONTROLLER ? 1 : 0);
+};
+
+//The kernel that handles every configuration
+typedef SimulationPolicyStruct< true, true, true, true > GenericPolicyStruct;
+
+#endif // _SIMULATIONPOLICYSTRUCT_H_
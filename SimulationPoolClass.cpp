@@ -0,0 +1,67 @@
+// James Zhu
+// October 2026
+// Implementation of the SimulationPoolClass, a set of identically
+// configured silent simulations for running side by side.
+
+#include <iostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+#include "SimulationPoolClass.h"
+
+SimulationPoolClass::SimulationPoolClass() {}
+
+SimulationPoolClass::~SimulationPoolClass() {
+    clear();
+}
+
+void SimulationPoolClass::clear() {
+    for (int i = 0; i < (int)simObjs.size(); i++) {
+        delete simObjs[i];
+    }
+    simObjs.clear();
+}
+
+bool SimulationPoolClass::setup(const string &paramFname,
+                                const int numSimulations) {
+    clear();
+    if (numSimulations <= 0) {
+        return false;
+    }
+
+    IntersectionSimulationClass *firstSim = new IntersectionSimulationClass;
+    simObjs.push_back(firstSim);
+    firstSim->setLogStream(NULL);
+    firstSim->readParametersFromFile(paramFname);
+    if (!firstSim->getIsSetupProperly()) {
+        clear();
+        return false;
+    }
+    if (firstSim->getWritesRunFiles()) {
+        cout << "ERROR: timeSeries and traceRecords lines can't be used "
+                "for runs done side by side, as every run would write the "
+                "same file" << endl;
+        clear();
+        return false;
+    }
+
+    // The other reads would only repeat the first one's messages
+    streambuf *coutBuf = cout.rdbuf(NULL);
+    for (int i = 1; i < numSimulations; i++) {
+        IntersectionSimulationClass *simObj = new IntersectionSimulationClass;
+        simObjs.push_back(simObj);
+        simObj->setLogStream(NULL);
+        simObj->readParametersFromFile(paramFname);
+    }
+    cout.rdbuf(coutBuf);
+
+    for (int i = 0; i < numSimulations; i++) {
+        if (!simObjs[i]->getIsSetupProperly()) {
+            clear();
+            return false;
+        }
+        simObjs[i]->setRandomStreams(true, simObjs[i]->getIsAntithetic());
+    }
+    return true;
+}
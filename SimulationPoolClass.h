@@ -0,0 +1,71 @@
+#ifndef _SIMULATIONPOOLCLASS_H_
+#define _SIMULATIONPOOLCLASS_H_
+
+#include <string>
+#include <vector>
+
+#include "IntersectionSimulationClass.h"
+
+//Programmer: James Zhu
+//Date: October 2026
+//Purpose: A set of identically configured simulations of one parameter
+//         file, one for each thread that runs them side by side.  Every
+//         simulation is silenced and draws from substreams (keeping an
+//         antithetic line), so each run depends on its own parameters
+//         alone and not on the thread running it.
+//
+//         A file whose runs write files of their own (timeSeries or
+//         traceRecords lines) is refused, as every simulation would
+//         write the same file at the same time.
+class SimulationPoolClass
+{
+  private:
+    std::vector< IntersectionSimulationClass* > simObjs; //The simulations
+
+    //Not copyable - the simulations belong to exactly one pool.
+    SimulationPoolClass(
+         const SimulationPoolClass &rhs
+         );
+    SimulationPoolClass& operator=(
+         const SimulationPoolClass &rhs
+         );
+
+  public:
+    //Creates a pool without simulations.
+    SimulationPoolClass(
+         );
+
+    //Deletes the simulations.
+    ~SimulationPoolClass(
+         );
+
+    //Reads the parameter file into the given number of simulations.  Only
+    //the first read prints its messages.  Returns false, keeping no
+    //simulations, if the number isn't positive, the file doesn't set the
+    //simulation up properly or its runs write files (printing why).
+    bool setup(
+         const std::string &paramFname,
+         const int numSimulations
+         );
+
+    //Deletes the simulations.
+    void clear(
+         );
+
+    //Returns the number of simulations.
+    int getNumSimulations(
+         ) const
+    {
+      return (int)simObjs.size();
+    }
+
+    //Returns one of the simulations.
+    IntersectionSimulationClass& getSimulation(
+         const int simIdx
+         )
+    {
+      return *simObjs[simIdx];
+    }
+};
+
+#endif // _SIMULATIONPOOLCLASS_H_
@@ -0,0 +1,39 @@
+// James Zhu
+// October 2026
+// Validation of the plain simulation structs.
+
+#include <cstddef>
+using namespace std;
+
+#include "SimulationStructs.h"
+
+const char* getSimulationParamsError(const SimulationParamsStruct &params) {
+    const char *ARRIVAL_ERRORS[NUM_DIRECTIONS] = {
+        "Unable to read/set east arrival distribution",
+        "Unable to read/set west arrival distribution",
+        "Unable to read/set north arrival distribution",
+        "Unable to read/set south arrival distribution" };
+
+    if (params.randomSeedVal < 0) {
+        return "Unable to read/set random generator seed";
+    }
+    if (params.timeToStopSim <= 0) {
+        return "Unable to read/set simulation end time";
+    }
+    if (params.eastWestGreenTime <= 0 || params.eastWestYellowTime <= 0) {
+        return "Unable to read/set east-west times";
+    }
+    if (params.northSouthGreenTime <= 0 || params.northSouthYellowTime <= 0) {
+        return "Unable to read/set north-south times";
+    }
+    for (int d = 0; d < NUM_DIRECTIONS; d++) {
+        if (params.arrivalMeans[d] <= 0 || params.arrivalStdDevs[d] < 0) {
+            return ARRIVAL_ERRORS[d];
+        }
+    }
+    if (params.percentCarsAdvanceOnYellow < 0 ||
+        params.percentCarsAdvanceOnYellow > 100) {
+        return "Unable to read/set percentage yellow advance";
+    }
+    return NULL;
+}
@@ -0,0 +1,48 @@
+#ifndef _SIMULATIONSTRUCTS_H_
+#define _SIMULATIONSTRUCTS_H_
+
+#include "constants.h"
+
+//Programmer: James Zhu
+//Date: October 2026
+//Purpose: Plain structs used to hand a simulation's parameters and results
+//         around in bulk, without going through a parameter file or
+//         parsing printed statistics.
+
+//The required simulation control parameters, exactly as they appear (in
+//the same order) in the first lines of a parameter file.  Arrays are
+//indexed by the DIRECTION_* constants.
+struct SimulationParamsStruct
+{
+  int randomSeedVal;
+  int timeToStopSim;
+  int eastWestGreenTime;
+  int eastWestYellowTime;
+  int northSouthGreenTime;
+  int northSouthYellowTime;
+  double arrivalMeans[NUM_DIRECTIONS];
+  double arrivalStdDevs[NUM_DIRECTIONS];
+  int percentCarsAdvanceOnYellow;
+};
+
+//Version of the simulation's results.  Increased by any change that
+//alters the statistics a run of the same parameters gives, so results
+//saved by an earlier version (see ResultCacheClass) are not reused.
+const int SIMULATOR_VERSION = 1;
+
+//The statistics printed at the end of a simulation run.  Arrays are
+//indexed by the DIRECTION_* constants.
+struct SimulationStatsStruct
+{
+  int maxQueueLengths[NUM_DIRECTIONS];
+  int numTotalAdvanced[NUM_DIRECTIONS];
+};
+
+//Checks parameters with the same rules readParametersFromFile uses.
+//Returns NULL if they are all valid, or otherwise the message for the
+//first invalid one (without the "ERROR: " prefix).
+const char* getSimulationParamsError(
+     const SimulationParamsStruct &params
+     );
+
+#endif // _SIMULATIONSTRUCTS_H_
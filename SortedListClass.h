@@ -71,6 +71,16 @@ public:
     bool removeFront(
         T &theVal
         );
+    //Removes the front item from the list only if it is not after
+    //limitVal (that is, front <= limitVal), returning it via theVal
+    //like removeFront.  Returns false, leaving the list unchanged (but
+    //theVal undefined), if the list is empty or its front item comes
+    //after limitVal, so a loop can peek, test against a limit and remove
+    //in a single call.
+    bool removeFrontIfNotAfter(
+        const T &limitVal,
+        T &theVal
+        );
     //Removes the last item from the list and returns the value that
     //was contained in it via the reference parameter. If the list
     //was empty, the function returns false to indicate failure, and
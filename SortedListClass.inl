@@ -133,6 +133,30 @@ bool SortedListClass<T>::removeFront(T &theVal) {
     return true;
 }
 
+// Removes the first node, if it is not after the limit, and retrieves its
+// value
+template <class T>
+bool SortedListClass<T>::removeFrontIfNotAfter(const T &limitVal,
+                                               T &theVal) {
+    if (head == NULL) {
+        return false;
+    }
+    theVal = head->getValue();
+    if (!(theVal <= limitVal)) {
+        return false;
+    }
+    LinkedNodeClass<T> *temp = head;
+    head = head->getNext();
+    delete temp;
+
+    if (head != NULL) {
+        head->setPreviousPointerToNull();
+    } else {
+        tail = NULL;
+    }
+    return true;
+}
+
 // Removes the last node and retrieves its value
 template <class T>
 bool SortedListClass<T>::removeLast(T &theVal) {
@@ -0,0 +1,564 @@
+// James Zhu
+// October 2026
+// Implementation of the SweepCoordinatorClass, which runs a sweep of
+// scenarios in worker processes fed in chunks over local sockets.
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <iomanip>
+#include <cstring>
+#include <cerrno>
+#include <stdint.h>
+using namespace std;
+
+#include <unistd.h>
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+
+#include "SweepCoordinatorClass.h"
+
+// Writes all of a message, retrying short and interrupted writes.  The
+// write fails instead of raising SIGPIPE if the other end is gone.
+static bool sendFully(const int socketFd, const void *data,
+                      const size_t length) {
+    const char *bytes = (const char *)data;
+    size_t numSent = 0;
+
+    while (numSent < length) {
+        const ssize_t numBytes = send(socketFd, bytes + numSent,
+                                      length - numSent, MSG_NOSIGNAL);
+        if (numBytes < 0 && errno == EINTR) {
+            continue;
+        }
+        if (numBytes <= 0) {
+            return false;
+        }
+        numSent += numBytes;
+    }
+    return true;
+}
+
+// Reads all of a message.  Returns false at the end of the stream.
+static bool receiveFully(const int socketFd, void *data,
+                         const size_t length) {
+    char *bytes = (char *)data;
+    size_t numReceived = 0;
+
+    while (numReceived < length) {
+        const ssize_t numBytes = read(socketFd, bytes + numReceived,
+                                      length - numReceived);
+        if (numBytes < 0 && errno == EINTR) {
+            continue;
+        }
+        if (numBytes <= 0) {
+            return false;
+        }
+        numReceived += numBytes;
+    }
+    return true;
+}
+
+// Writes a result as a line of a progress file:
+// index seed maxQueue x4 advanced x4
+static void writeProgressLine(ostream &outStream, const int scenarioIdx,
+                              const int seedVal,
+                              const SimulationStatsStruct &stats) {
+    outStream << scenarioIdx << " " << seedVal;
+    for (int i = 0; i < NUM_DIRECTIONS; i++) {
+        outStream << " " << stats.maxQueueLengths[i];
+    }
+    for (int i = 0; i < NUM_DIRECTIONS; i++) {
+        outStream << " " << stats.numTotalAdvanced[i];
+    }
+    outStream << "\n";
+}
+
+SweepCoordinatorClass::SweepCoordinatorClass()
+ : paramFileHash(0), numWorkers(0), chunkSize(0), nextPendingIdx(0),
+   numOutstanding(0),
+   numResumed(0), numCached(0), numRun(0), numFailed(0), numRestarts(0) {
+    simObj.setLogStream(NULL);
+}
+
+bool SweepCoordinatorClass::setScenarios(
+         const vector< SimulationParamsStruct > &inScenarios,
+         const int inNumWorkers, const int inChunkSize) {
+    scenarios.clear();
+    if (inScenarios.empty() || inNumWorkers <= 0 || inChunkSize <= 0) {
+        return false;
+    }
+    scenarios = inScenarios;
+    numWorkers = inNumWorkers;
+    chunkSize = inChunkSize;
+    return true;
+}
+
+bool SweepCoordinatorClass::setupSeedSweep(const string &paramFname,
+                                           const int numScenarios,
+                                           const int inNumWorkers,
+                                           const int inChunkSize) {
+    SimulationParamsStruct baseParams;
+    ifstream paramFile(paramFname.c_str());
+    ostringstream paramText;
+
+    scenarios.clear();
+    paramFileHash = 0;
+    simObj.readParametersFromFile(paramFname);
+    if (!simObj.getIsSetupProperly() || numScenarios <= 0) {
+        return false;
+    }
+    if (simObj.getWritesRunFiles()) {
+        // Every worker would write the same file at once
+        cout << "ERROR: timeSeries and traceRecords lines can't be used "
+                "in a sweep, as every scenario would write the same file" <<
+                endl;
+        return false;
+    }
+    simObj.getParameters(baseParams);
+
+    vector< SimulationParamsStruct > seedScenarios(numScenarios, baseParams);
+    for (int i = 0; i < numScenarios; i++) {
+        seedScenarios[i].randomSeedVal = baseParams.randomSeedVal + i;
+    }
+    if (!setScenarios(seedScenarios, inNumWorkers, inChunkSize)) {
+        return false;
+    }
+    // The optional lines aren't in the scenarios, but change the results
+    paramText << paramFile.rdbuf();
+    paramFileHash = ResultCacheClass::hashBytes(paramText.str().data(),
+                                                paramText.str().size());
+    return true;
+}
+
+bool SweepCoordinatorClass::setupScenarios(
+         const vector< SimulationParamsStruct > &inScenarios,
+         const int inNumWorkers, const int inChunkSize) {
+    paramFileHash = 0;
+    return setScenarios(inScenarios, inNumWorkers, inChunkSize);
+}
+
+bool SweepCoordinatorClass::setupCache(const string &cacheFname) {
+    return resultCache.open(cacheFname);
+}
+
+uint64_t SweepCoordinatorClass::getFingerprint() const {
+    vector< uint64_t > hashes(1, paramFileHash);
+    ResultCacheKeyStruct key;
+
+    for (int i = 0; i < (int)scenarios.size(); i++) {
+        ResultCacheClass::makeKey(scenarios[i], simObj.getIsUsingSubstreams(),
+                                  simObj.getIsAntithetic(), key);
+        hashes.push_back(ResultCacheClass::hashKey(key));
+    }
+    return ResultCacheClass::hashBytes(&hashes[0],
+                                       hashes.size() * sizeof(uint64_t));
+}
+
+bool SweepCoordinatorClass::loadProgress(const string &progressFname) {
+    const int numScenarios = (int)scenarios.size();
+    ifstream inFile(progressFname.c_str());
+    ostringstream fingerprintStream;
+    string line;
+    string header;
+    string fileFingerprint;
+    int fileNumScenarios = 0;
+    long validBytes = 0;
+
+    fingerprintStream << hex << setfill('0') << setw(16) << getFingerprint();
+    if (!inFile.is_open()) {
+        ofstream newFile(progressFname.c_str());
+        newFile << SWEEP_PROGRESS_HEADER << " " << numScenarios << " " <<
+                   fingerprintStream.str() << "\n";
+        if (newFile.fail()) {
+            cout << "ERROR: Unable to create progress file: " <<
+                    progressFname << endl;
+            return false;
+        }
+        return true;
+    }
+
+    // Only lines ending in a newline were completely written
+    getline(inFile, line);
+    istringstream headerStream(line);
+    headerStream >> header >> fileNumScenarios >> fileFingerprint;
+    if (inFile.eof() || headerStream.fail() ||
+        header != SWEEP_PROGRESS_HEADER ||
+        fileNumScenarios != numScenarios) {
+        cout << "ERROR: Progress file is not of a sweep of " <<
+                numScenarios << " scenarios: " << progressFname << endl;
+        return false;
+    }
+    // Same number of scenarios, but other parameters
+    if (fileFingerprint != fingerprintStream.str()) {
+        cout << "ERROR: Progress file is of a sweep of other scenarios: " <<
+                progressFname << endl;
+        return false;
+    }
+    validBytes = (long)line.size() + 1;
+    while (getline(inFile, line) && !inFile.eof()) {
+        istringstream lineStream(line);
+        SimulationStatsStruct stats;
+        int scenarioIdx = -1;
+        int seedVal = 0;
+
+        lineStream >> scenarioIdx >> seedVal;
+        for (int i = 0; i < NUM_DIRECTIONS; i++) {
+            lineStream >> stats.maxQueueLengths[i];
+        }
+        for (int i = 0; i < NUM_DIRECTIONS; i++) {
+            lineStream >> stats.numTotalAdvanced[i];
+        }
+        if (lineStream.fail() || scenarioIdx < 0 ||
+            scenarioIdx >= numScenarios ||
+            seedVal != scenarios[scenarioIdx].randomSeedVal) {
+            cout << "ERROR: Progress file does not match this sweep: " <<
+                    progressFname << endl;
+            return false;
+        }
+        if (scenarioStates[scenarioIdx] != SWEEP_DONE) {
+            scenarioStates[scenarioIdx] = SWEEP_DONE;
+            results[scenarioIdx] = stats;
+            numResumed++;
+        }
+        validBytes += (long)line.size() + 1;
+    }
+    inFile.close();
+
+    // The rest is a result cut off part way through being written
+    if (truncate(progressFname.c_str(), validBytes) != 0) {
+        cout << "ERROR: Unable to update progress file: " << progressFname <<
+                endl;
+        return false;
+    }
+    return true;
+}
+
+bool SweepCoordinatorClass::startWorker(const int workerIdx) {
+    WorkerStruct &worker = workers[workerIdx];
+    int socketFds[2];
+
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, socketFds) != 0) {
+        return false;
+    }
+    // Anything buffered would otherwise be written by the worker as well
+    cout.flush();
+    const pid_t pid = fork();
+    if (pid < 0) {
+        close(socketFds[0]);
+        close(socketFds[1]);
+        return false;
+    }
+    if (pid == 0) {
+        close(socketFds[0]);
+        for (int i = 0; i < (int)workers.size(); i++) {
+            if (workers[i].pid > 0) {
+                close(workers[i].socketFd);
+            }
+        }
+        runWorker(socketFds[1]);
+    }
+
+    close(socketFds[1]);
+    worker.pid = pid;
+    worker.socketFd = socketFds[0];
+    worker.numAssigned = 0;
+    worker.numReported = 0;
+    worker.inBuffer.clear();
+    return true;
+}
+
+void SweepCoordinatorClass::runWorker(const int socketFd) {
+    SweepChunkStruct chunk;
+    SweepResultStruct result;
+
+    while (receiveFully(socketFd, &chunk, sizeof(chunk)) &&
+           chunk.numScenarios > 0) {
+        for (int i = 0; i < chunk.numScenarios; i++) {
+            const SimulationParamsStruct &params =
+                scenarios[chunk.firstIdx + i];
+
+            simObj.setParameters(params);
+            simObj.runUntil(params.timeToStopSim);
+            result.scenarioIdx = chunk.firstIdx + i;
+            simObj.getStatistics(result.stats);
+            result.meanDelay = simObj.getMeanDelay();
+            if (!sendFully(socketFd, &result, sizeof(result))) {
+                _exit(1);
+            }
+        }
+    }
+    // The coordinator's objects and streams are its own to clean up
+    _exit(0);
+}
+
+bool SweepCoordinatorClass::findPendingScenario() {
+    const int numScenarios = (int)scenarios.size();
+
+    while (nextPendingIdx < numScenarios &&
+           scenarioStates[nextPendingIdx] != SWEEP_PENDING) {
+        nextPendingIdx++;
+    }
+    return nextPendingIdx < numScenarios;
+}
+
+bool SweepCoordinatorClass::assignChunk(const int workerIdx) {
+    WorkerStruct &worker = workers[workerIdx];
+    const int numScenarios = (int)scenarios.size();
+    SweepChunkStruct chunk;
+
+    // A chunk is a run of consecutive pending scenarios
+    chunk.firstIdx = nextPendingIdx;
+    chunk.numScenarios = 0;
+    while (nextPendingIdx < numScenarios && chunk.numScenarios < chunkSize &&
+           scenarioStates[nextPendingIdx] == SWEEP_PENDING) {
+        scenarioStates[nextPendingIdx] = SWEEP_ASSIGNED;
+        nextPendingIdx++;
+        chunk.numScenarios++;
+    }
+    worker.firstIdx = chunk.firstIdx;
+    worker.numAssigned = chunk.numScenarios;
+    worker.numReported = 0;
+    return sendFully(worker.socketFd, &chunk, sizeof(chunk));
+}
+
+void SweepCoordinatorClass::recordResult(const int scenarioIdx,
+                                         const SimulationStatsStruct &stats,
+                                         ostream &outStream,
+                                         ostream &progressStream) {
+    scenarioStates[scenarioIdx] = SWEEP_DONE;
+    results[scenarioIdx] = stats;
+    numOutstanding--;
+
+    writeProgressLine(progressStream, scenarioIdx,
+                      scenarios[scenarioIdx].randomSeedVal, stats);
+    progressStream.flush();
+    outStream << "Scenario: " << scenarioIdx << " Seed: " <<
+                 scenarios[scenarioIdx].randomSeedVal << " Max Queues:";
+    for (int d = 0; d < NUM_DIRECTIONS; d++) {
+        outStream << " " << stats.maxQueueLengths[d];
+    }
+    outStream << " Advanced:";
+    for (int d = 0; d < NUM_DIRECTIONS; d++) {
+        outStream << " " << stats.numTotalAdvanced[d];
+    }
+    outStream << endl;
+}
+
+bool SweepCoordinatorClass::readResults(const int workerIdx,
+                                        ostream &outStream,
+                                        ostream &progressStream) {
+    WorkerStruct &worker = workers[workerIdx];
+    char readBuffer[64 * sizeof(SweepResultStruct)];
+    SweepResultStruct result;
+    ResultCacheKeyStruct key;
+
+    const ssize_t numBytes = read(worker.socketFd, readBuffer,
+                                  sizeof(readBuffer));
+    if (numBytes < 0 && errno == EINTR) {
+        return true;
+    }
+    if (numBytes <= 0) {
+        return false;
+    }
+    worker.inBuffer.insert(worker.inBuffer.end(), readBuffer,
+                           readBuffer + numBytes);
+
+    size_t pos = 0;
+    for (; pos + sizeof(result) <= worker.inBuffer.size();
+         pos += sizeof(result)) {
+        memcpy(&result, &worker.inBuffer[pos], sizeof(result));
+        const int scenarioIdx = result.scenarioIdx;
+        // Results of a chunk come back in order
+        if (worker.numReported >= worker.numAssigned ||
+            scenarioIdx != worker.firstIdx + worker.numReported) {
+            return false;
+        }
+        worker.numReported++;
+        numRun++;
+        recordResult(scenarioIdx, result.stats, outStream, progressStream);
+        if (getIsCaching()) {
+            ResultCacheClass::makeKey(scenarios[scenarioIdx],
+                                      simObj.getIsUsingSubstreams(),
+                                      simObj.getIsAntithetic(), key);
+            resultCache.store(key, result.stats, result.meanDelay);
+        }
+    }
+    worker.inBuffer.erase(worker.inBuffer.begin(),
+                          worker.inBuffer.begin() + pos);
+    return true;
+}
+
+void SweepCoordinatorClass::handleWorkerExit(const int workerIdx,
+                                             ostream &outStream) {
+    WorkerStruct &worker = workers[workerIdx];
+    const int firstUnreported = worker.firstIdx + worker.numReported;
+    const int endIdx = worker.firstIdx + worker.numAssigned;
+
+    close(worker.socketFd);
+    waitpid(worker.pid, NULL, 0);
+    worker.pid = -1;
+
+    if (firstUnreported < endIdx) {
+        // The scenario it was running when it died is the likely cause
+        numAttempts[firstUnreported]++;
+        if (numAttempts[firstUnreported] >= SWEEP_MAX_ATTEMPTS) {
+            scenarioStates[firstUnreported] = SWEEP_FAILED;
+            numOutstanding--;
+            numFailed++;
+            outStream << "Scenario: " << firstUnreported << " Seed: " <<
+                         scenarios[firstUnreported].randomSeedVal <<
+                         " FAILED after " << SWEEP_MAX_ATTEMPTS <<
+                         " attempts" << endl;
+        }
+        else {
+            scenarioStates[firstUnreported] = SWEEP_PENDING;
+        }
+        for (int i = firstUnreported + 1; i < endIdx; i++) {
+            scenarioStates[i] = SWEEP_PENDING;
+        }
+        nextPendingIdx = min(nextPendingIdx, firstUnreported);
+    }
+    worker.numAssigned = 0;
+    worker.numReported = 0;
+}
+
+void SweepCoordinatorClass::stopWorker(const int workerIdx) {
+    WorkerStruct &worker = workers[workerIdx];
+    SweepChunkStruct exitChunk;
+
+    exitChunk.firstIdx = 0;
+    exitChunk.numScenarios = 0;
+    sendFully(worker.socketFd, &exitChunk, sizeof(exitChunk));
+    close(worker.socketFd);
+    waitpid(worker.pid, NULL, 0);
+    worker.pid = -1;
+}
+
+bool SweepCoordinatorClass::run(const string &progressFname,
+                                ostream &outStream) {
+    const int numScenarios = (int)scenarios.size();
+    vector< pollfd > pollFds;
+    vector< int > pollWorkerIdxs;
+
+    numResumed = 0;
+    numCached = 0;
+    numRun = 0;
+    numFailed = 0;
+    numRestarts = 0;
+    if (numScenarios == 0) {
+        return false;
+    }
+    scenarioStates.assign(numScenarios, SWEEP_PENDING);
+    numAttempts.assign(numScenarios, 0);
+    results.assign(numScenarios, SimulationStatsStruct());
+    if (!loadProgress(progressFname)) {
+        return false;
+    }
+    ofstream progressFile(progressFname.c_str(), ios::out | ios::app);
+    if (progressFile.fail()) {
+        cout << "ERROR: Unable to open progress file: " << progressFname <<
+                endl;
+        return false;
+    }
+    nextPendingIdx = 0;
+    numOutstanding = numScenarios - numResumed;
+
+    for (int i = 0; getIsCaching() && i < numScenarios; i++) {
+        ResultCacheKeyStruct key;
+        SimulationStatsStruct stats;
+        double meanDelay = 0;
+
+        ResultCacheClass::makeKey(scenarios[i], simObj.getIsUsingSubstreams(),
+                                  simObj.getIsAntithetic(), key);
+        if (scenarioStates[i] == SWEEP_PENDING &&
+            resultCache.lookup(key, stats, meanDelay)) {
+            recordResult(i, stats, outStream, progressFile);
+            numCached++;
+        }
+    }
+
+    workers.assign(min(numWorkers, max(numOutstanding, 1)), WorkerStruct());
+    for (int i = 0; i < (int)workers.size(); i++) {
+        workers[i].pid = -1;
+    }
+    for (int i = 0; numOutstanding > 0 && i < (int)workers.size(); i++) {
+        if (!startWorker(i)) {
+            break;
+        }
+    }
+    if (numOutstanding > 0 && workers[0].pid < 0) {
+        cout << "ERROR: Unable to start worker processes" << endl;
+        return false;
+    }
+
+    while (numOutstanding > 0) {
+        pollFds.clear();
+        pollWorkerIdxs.clear();
+        for (int i = 0; i < (int)workers.size(); i++) {
+            if (workers[i].pid < 0) {
+                continue;
+            }
+            // An idle worker gets a chunk; one with nothing left to run
+            // is still watched until its chunk is done
+            if (workers[i].numReported == workers[i].numAssigned &&
+                findPendingScenario() && !assignChunk(i)) {
+                handleWorkerExit(i, outStream);
+                numRestarts++;
+                startWorker(i);
+                continue;
+            }
+            pollfd workerPollFd;
+            workerPollFd.fd = workers[i].socketFd;
+            workerPollFd.events = POLLIN;
+            workerPollFd.revents = 0;
+            pollFds.push_back(workerPollFd);
+            pollWorkerIdxs.push_back(i);
+        }
+        if (pollFds.empty()) {
+            cout << "ERROR: No worker processes left" << endl;
+            break;
+        }
+        if (poll(&pollFds[0], pollFds.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            cout << "ERROR: Unable to wait for worker processes" << endl;
+            break;
+        }
+
+        for (int p = 0; p < (int)pollFds.size(); p++) {
+            const int workerIdx = pollWorkerIdxs[p];
+            if (pollFds[p].revents == 0) {
+                continue;
+            }
+            if (!readResults(workerIdx, outStream, progressFile)) {
+                handleWorkerExit(workerIdx, outStream);
+                numRestarts++;
+                if (numOutstanding > 0) {
+                    startWorker(workerIdx);
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < (int)workers.size(); i++) {
+        if (workers[i].pid > 0) {
+            stopWorker(i);
+        }
+    }
+    workers.clear();
+    return numOutstanding == 0;
+}
+
+void SweepCoordinatorClass::print(ostream &outStream) const {
+    outStream << "Resumed: " << numResumed << " Cached: " << numCached <<
+                 " Run: " << numRun <<
+                 " Failed: " << numFailed << " Worker restarts: " <<
+                 numRestarts;
+}
@@ -0,0 +1,279 @@
+#ifndef _SWEEPCOORDINATORCLASS_H_
+#define _SWEEPCOORDINATORCLASS_H_
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "IntersectionSimulationClass.h"
+#include "SimulationStructs.h"
+#include "ResultCacheClass.h"
+
+//Times a scenario is tried, by a fresh worker each time, before it is
+//given up on as the one crashing its workers
+const int SWEEP_MAX_ATTEMPTS = 3;
+
+//What has become of each scenario of a sweep
+const int SWEEP_PENDING = 0; //Not yet run
+const int SWEEP_ASSIGNED = 1; //In a chunk a worker is running
+const int SWEEP_DONE = 2; //Result received (or resumed from the progress
+                          //file)
+const int SWEEP_FAILED = 3; //Given up on after SWEEP_MAX_ATTEMPTS
+
+//First line of a progress file, followed by the number of scenarios and
+//the sweep's fingerprint (see getFingerprint)
+const std::string SWEEP_PROGRESS_HEADER = "SWEEP";
+
+//Sent from the coordinator to a worker: run the scenarios
+//[firstIdx, firstIdx + numScenarios), or exit if numScenarios is 0.
+struct SweepChunkStruct
+{
+  int firstIdx;
+  int numScenarios;
+};
+
+//Sent from a worker to the coordinator as each scenario finishes.
+struct SweepResultStruct
+{
+  int scenarioIdx;
+  SimulationStatsStruct stats;
+  double meanDelay; //For the result cache
+};
+
+//Programmer: James Zhu
+//Date: October 2026
+//Purpose: Runs a sweep of scenarios in worker processes on this machine,
+//         handing them out in chunks from a single coordinator.  Each
+//         worker is forked with the scenarios and a simulation already
+//         in memory, and talks to the coordinator over a local socket
+//         pair: the coordinator sends a chunk, and the worker sends back
+//         each scenario's statistics as soon as it is run, then gets
+//         another chunk once it is done.
+//
+//         Every result is streamed to the output and appended to a
+//         progress file as it arrives.  Running a sweep with the progress
+//         file of an earlier, interrupted run of it skips the scenarios
+//         already in the file, so a sweep can be stopped at any point and
+//         carried on later.
+//
+//         A worker that dies is replaced by a new one, and the scenarios
+//         of its chunk that hadn't reported are run again.  The first of
+//         them is the likely cause, so it is given up on (and reported)
+//         once it has been tried SWEEP_MAX_ATTEMPTS times.
+//
+//         A scenario's statistics depend on its parameters alone, as each
+//         run starts by reseeding, so they are the same whichever worker
+//         runs it, and the same as proj5.exe gives.  So with a result
+//         cache set up, scenarios run before (by this or any sweep) are
+//         answered from it without a worker, as long as the sweep uses
+//         only the required parameters (and the random stream settings).
+class SweepCoordinatorClass
+{
+  private:
+    //What the coordinator knows about one worker process
+    struct WorkerStruct
+    {
+      pid_t pid; //The process, or -1 if not running
+      int socketFd; //Coordinator's end of the socket pair
+      int firstIdx; //First scenario of the chunk it is running
+      int numAssigned; //Scenarios in the chunk, or 0 if idle
+      int numReported; //Of those, how many have reported
+      std::vector< char > inBuffer; //Bytes of a result not yet complete
+    };
+
+    IntersectionSimulationClass simObj; //Run by every worker, silenced
+    ResultCacheClass resultCache; //Results of earlier runs, if open
+    std::vector< SimulationParamsStruct > scenarios; //What to run
+    uint64_t paramFileHash; //Of the seed sweep's parameter file text, or
+                            //0 for scenarios given directly
+    std::vector< int > scenarioStates; //SWEEP_* state of each scenario
+    std::vector< int > numAttempts; //Times each one's worker has died
+    std::vector< SimulationStatsStruct > results; //Of the done scenarios
+    int numWorkers; //Worker processes to run at once
+    int chunkSize; //Most scenarios handed out at once
+
+    std::vector< WorkerStruct > workers; //Of the sweep in progress
+    int nextPendingIdx; //No scenario before this one is pending
+    int numOutstanding; //Scenarios pending or assigned
+    int numResumed; //Scenarios done before the sweep in progress started
+    int numCached; //Scenarios answered from the result cache
+    int numRun; //Scenarios run by the sweep in progress
+    int numFailed; //Scenarios given up on
+    int numRestarts; //Workers replaced after dying
+
+    //Sets the scenarios, the number of workers and the chunk size.
+    //Returns false if there are no scenarios or either number isn't
+    //positive.
+    bool setScenarios(
+         const std::vector< SimulationParamsStruct > &inScenarios,
+         const int inNumWorkers,
+         const int inChunkSize
+         );
+
+    //Returns the sweep's fingerprint: a hash of every scenario's result
+    //cache key (so its parameters and random stream settings) and of the
+    //parameter file text of a seed sweep (so its optional lines too).
+    uint64_t getFingerprint(
+         ) const;
+
+    //Reads the progress file, marking the scenarios in it done, and
+    //cuts off a last line left incomplete by an interrupted sweep.
+    //Creates the file if it doesn't exist.  Returns false, printing why,
+    //if it can't be created or read, or its header's number of scenarios
+    //or fingerprint isn't this sweep's.
+    bool loadProgress(
+         const std::string &progressFname
+         );
+
+    //Forks the given worker.  Returns false if it can't be started.
+    bool startWorker(
+         const int workerIdx
+         );
+
+    //Body of a worker process: runs each chunk it is sent, reporting
+    //every scenario, until told to exit.  Never returns.
+    void runWorker(
+         const int socketFd
+         );
+
+    //Moves nextPendingIdx past scenarios that aren't pending.  Returns
+    //true if a pending scenario is left.
+    bool findPendingScenario(
+         );
+
+    //Hands the next chunk of pending scenarios to an idle worker.  Only
+    //called when findPendingScenario has found one, so the chunk is never
+    //empty (which would tell the worker to exit).  Returns false if the
+    //worker can't be reached.
+    bool assignChunk(
+         const int workerIdx
+         );
+
+    //Marks a scenario done with the given statistics, appending them to
+    //the progress file and writing them as a line of outStream.
+    void recordResult(
+         const int scenarioIdx,
+         const SimulationStatsStruct &stats,
+         std::ostream &outStream,
+         std::ostream &progressStream
+         );
+
+    //Returns true if the sweep's results can be cached, i.e. a cache is
+    //open and the simulation uses only the required parameters and the
+    //random stream settings.
+    bool getIsCaching(
+         ) const
+    {
+      return resultCache.getIsOpen() &&
+             !simObj.getUsesOptionalModelParameters();
+    }
+
+    //Reads what a worker has sent, recording and streaming each complete
+    //result, and caching it.  Returns false if the worker has gone away.
+    bool readResults(
+         const int workerIdx,
+         std::ostream &outStream,
+         std::ostream &progressStream
+         );
+
+    //Cleans up after a worker that has gone away, putting its unreported
+    //scenarios back to be run (or giving up on the first of them).
+    void handleWorkerExit(
+         const int workerIdx,
+         std::ostream &outStream
+         );
+
+    //Tells a worker to exit and waits for it.
+    void stopWorker(
+         const int workerIdx
+         );
+
+    //Not copyable - the workers belong to exactly one coordinator.
+    SweepCoordinatorClass(
+         const SweepCoordinatorClass &rhs
+         );
+    SweepCoordinatorClass& operator=(
+         const SweepCoordinatorClass &rhs
+         );
+
+  public:
+    //Creates a coordinator with no scenarios.
+    SweepCoordinatorClass(
+         );
+
+    //Sets up a seed sweep of a parameter file: scenario i runs the file
+    //(optional parameters included) with the random seed increased by i.
+    //Returns false if the file doesn't set the simulation up properly,
+    //has timeSeries or traceRecords lines (refused with a message), or
+    //setScenarios fails.
+    bool setupSeedSweep(
+         const std::string &paramFname,
+         const int numScenarios,
+         const int inNumWorkers,
+         const int inChunkSize
+         );
+
+    //Sets up a sweep of the given scenarios, run with the required
+    //parameters only.  Returns false if setScenarios fails.
+    bool setupScenarios(
+         const std::vector< SimulationParamsStruct > &inScenarios,
+         const int inNumWorkers,
+         const int inChunkSize
+         );
+
+    //Opens the result cache file (creating it if need be) that runs
+    //check first and add their results to.  Returns false if it can't
+    //be opened.
+    bool setupCache(
+         const std::string &cacheFname
+         );
+
+    //Returns the result cache, which is open if setupCache succeeded.
+    const ResultCacheClass& getResultCache(
+         ) const
+    {
+      return resultCache;
+    }
+
+    //Runs every scenario not already in the progress file, writing each
+    //result as a line of outStream as it arrives.  Returns false, having
+    //run nothing, if it isn't set up, the progress file can't be used or
+    //no worker can be started.
+    bool run(
+         const std::string &progressFname,
+         std::ostream &outStream
+         );
+
+    //Returns the number of scenarios in the sweep.
+    int getNumScenarios(
+         ) const
+    {
+      return (int)scenarios.size();
+    }
+
+    //Returns the SWEEP_* state of a scenario.
+    int getScenarioState(
+         const int scenarioIdx
+         ) const
+    {
+      return scenarioStates[scenarioIdx];
+    }
+
+    //Returns a scenario's statistics, once it is done.
+    const SimulationStatsStruct& getResult(
+         const int scenarioIdx
+         ) const
+    {
+      return results[scenarioIdx];
+    }
+
+    //Prints how many scenarios the last run resumed, found cached, ran
+    //and gave up on, and how many workers it replaced, on a single line.
+    void print(
+         std::ostream &outStream
+         ) const;
+};
+
+#endif // _SWEEPCOORDINATORCLASS_H_
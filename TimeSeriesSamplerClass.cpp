@@ -0,0 +1,250 @@
+// James Zhu
+// October 2026
+// Implementation of the TimeSeriesSamplerClass, which samples queue
+// lengths into a ring buffer drained to a CSV file by a writer thread.
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+using namespace std;
+
+#include <pthread.h>
+
+#include "TimeSeriesSamplerClass.h"
+
+// Column names of the CSV file, for each direction after time and light
+const string COLUMN_PREFIXES[NUM_DIRECTIONS] = {
+    "east", "west", "north", "south" };
+const string MEAN_COLUMN_SUFFIX = "MeanQueue";
+const string MAX_COLUMN_SUFFIX = "MaxQueue";
+
+TimeSeriesSamplerClass::TimeSeriesSamplerClass()
+ : interval(0), decimation(1), isRunning(false), isFinished(false),
+   nextSampleTime(0), windowSamples(0), fillChunk(0), fillCount(0),
+   isStopping(false) {
+    pthread_mutex_init(&ringMutex, NULL);
+    pthread_cond_init(&chunkFilled, NULL);
+    pthread_cond_init(&chunkEmptied, NULL);
+}
+
+TimeSeriesSamplerClass::~TimeSeriesSamplerClass() {
+    if (isRunning) {
+        stopRun();
+    }
+    pthread_cond_destroy(&chunkEmptied);
+    pthread_cond_destroy(&chunkFilled);
+    pthread_mutex_destroy(&ringMutex);
+}
+
+bool TimeSeriesSamplerClass::setup(const int inInterval,
+                                   const int inDecimation,
+                                   const string &inOutFname) {
+    restart();
+    if (inInterval <= 0 || inDecimation <= 0 || inOutFname.empty()) {
+        interval = 0;
+        return false;
+    }
+    interval = inInterval;
+    decimation = inDecimation;
+    outFname = inOutFname;
+    return true;
+}
+
+void TimeSeriesSamplerClass::restart() {
+    if (isRunning) {
+        stopRun();
+    }
+    isFinished = false;
+    nextSampleTime = 0;
+    windowSamples = 0;
+}
+
+bool TimeSeriesSamplerClass::startRun() {
+    outFile.clear();
+    outFile.open(outFname.c_str(), ios::out | ios::trunc);
+    if (outFile.fail()) {
+        cout << "ERROR: Unable to create time series file: " << outFname <<
+                endl;
+        return false;
+    }
+    outFile << "time,light";
+    for (int d = 0; d < NUM_DIRECTIONS; d++) {
+        outFile << "," << COLUMN_PREFIXES[d] << MEAN_COLUMN_SUFFIX;
+    }
+    for (int d = 0; d < NUM_DIRECTIONS; d++) {
+        outFile << "," << COLUMN_PREFIXES[d] << MAX_COLUMN_SUFFIX;
+    }
+    outFile << "\n";
+
+    // Allocated once, on the first run sampled
+    ringRecords.resize(TIME_SERIES_NUM_CHUNKS * TIME_SERIES_CHUNK_RECORDS);
+    for (int i = 0; i < TIME_SERIES_NUM_CHUNKS; i++) {
+        isChunkFull[i] = false;
+        chunkCounts[i] = 0;
+    }
+    fillChunk = 0;
+    fillCount = 0;
+    isStopping = false;
+    if (pthread_create(&writerThread, NULL, runWriter, this) != 0) {
+        cout << "ERROR: Unable to start the time series writer" << endl;
+        outFile.close();
+        return false;
+    }
+    isRunning = true;
+    return true;
+}
+
+void TimeSeriesSamplerClass::stopRun() {
+    if (windowSamples > 0) {
+        storeRecord(pendingRecord);
+        windowSamples = 0;
+    }
+    pthread_mutex_lock(&ringMutex);
+    if (fillCount > 0) {
+        chunkCounts[fillChunk] = fillCount;
+        isChunkFull[fillChunk] = true;
+    }
+    isStopping = true;
+    pthread_cond_signal(&chunkFilled);
+    pthread_mutex_unlock(&ringMutex);
+
+    pthread_join(writerThread, NULL);
+    outFile.close();
+    isRunning = false;
+}
+
+void TimeSeriesSamplerClass::addSamplesBefore(
+    const int eventTime, const int light,
+    const int queueLengths[NUM_DIRECTIONS]) {
+    if (isFinished) {
+        return;
+    }
+    if (!isRunning && !startRun()) {
+        // Without a file, this run goes unsampled
+        isFinished = true;
+        return;
+    }
+    while (nextSampleTime < eventTime) {
+        addSample(nextSampleTime, light, queueLengths);
+        nextSampleTime += interval;
+    }
+}
+
+void TimeSeriesSamplerClass::finishRun(
+    const int endTime, const int light,
+    const int queueLengths[NUM_DIRECTIONS]) {
+    if (interval == 0 || isFinished) {
+        return;
+    }
+    addSamplesBefore(endTime + 1, light, queueLengths);
+    if (isRunning) {
+        stopRun();
+    }
+    isFinished = true;
+}
+
+void TimeSeriesSamplerClass::addSample(
+    const int sampleTime, const int light,
+    const int queueLengths[NUM_DIRECTIONS]) {
+    if (windowSamples == 0) {
+        pendingRecord.time = sampleTime;
+        pendingRecord.light = light;
+        for (int d = 0; d < NUM_DIRECTIONS; d++) {
+            pendingRecord.meanQueueLengths[d] = 0;
+            pendingRecord.maxQueueLengths[d] = queueLengths[d];
+        }
+    }
+    windowSamples++;
+    for (int d = 0; d < NUM_DIRECTIONS; d++) {
+        // A running mean, so the record is complete whenever it is stored
+        pendingRecord.meanQueueLengths[d] +=
+            (queueLengths[d] - pendingRecord.meanQueueLengths[d]) /
+            windowSamples;
+        pendingRecord.maxQueueLengths[d] =
+            max(pendingRecord.maxQueueLengths[d], queueLengths[d]);
+    }
+    if (windowSamples == decimation) {
+        storeRecord(pendingRecord);
+        windowSamples = 0;
+    }
+}
+
+void TimeSeriesSamplerClass::storeRecord(
+    const TimeSeriesRecordStruct &record) {
+    ringRecords[fillChunk * TIME_SERIES_CHUNK_RECORDS + fillCount] = record;
+    fillCount++;
+    if (fillCount == TIME_SERIES_CHUNK_RECORDS) {
+        handOverChunk();
+    }
+}
+
+void TimeSeriesSamplerClass::handOverChunk() {
+    pthread_mutex_lock(&ringMutex);
+    chunkCounts[fillChunk] = fillCount;
+    isChunkFull[fillChunk] = true;
+    pthread_cond_signal(&chunkFilled);
+
+    fillChunk = (fillChunk + 1) % TIME_SERIES_NUM_CHUNKS;
+    while (isChunkFull[fillChunk]) {
+        pthread_cond_wait(&chunkEmptied, &ringMutex);
+    }
+    pthread_mutex_unlock(&ringMutex);
+    fillCount = 0;
+}
+
+void* TimeSeriesSamplerClass::runWriter(void *samplerPtr) {
+    TimeSeriesSamplerClass *sampler = (TimeSeriesSamplerClass *)samplerPtr;
+    int writeChunk = 0;
+
+    while (true) {
+        pthread_mutex_lock(&sampler->ringMutex);
+        while (!sampler->isChunkFull[writeChunk] && !sampler->isStopping) {
+            pthread_cond_wait(&sampler->chunkFilled, &sampler->ringMutex);
+        }
+        // Chunks are handed over in order, so once stopping, a chunk that
+        // isn't full means everything has been written
+        const bool isDone = !sampler->isChunkFull[writeChunk];
+        const int numRecords = sampler->chunkCounts[writeChunk];
+        pthread_mutex_unlock(&sampler->ringMutex);
+        if (isDone) {
+            break;
+        }
+
+        // The simulation doesn't touch a full chunk, so no lock is needed
+        const TimeSeriesRecordStruct *records =
+            &sampler->ringRecords[writeChunk * TIME_SERIES_CHUNK_RECORDS];
+        for (int i = 0; i < numRecords; i++) {
+            sampler->writeRecord(records[i]);
+        }
+
+        pthread_mutex_lock(&sampler->ringMutex);
+        sampler->isChunkFull[writeChunk] = false;
+        pthread_cond_signal(&sampler->chunkEmptied);
+        pthread_mutex_unlock(&sampler->ringMutex);
+        writeChunk = (writeChunk + 1) % TIME_SERIES_NUM_CHUNKS;
+    }
+    sampler->outFile.flush();
+    return NULL;
+}
+
+void TimeSeriesSamplerClass::writeRecord(
+    const TimeSeriesRecordStruct &record) {
+    outFile << record.time << "," << record.light;
+    for (int d = 0; d < NUM_DIRECTIONS; d++) {
+        outFile << "," << record.meanQueueLengths[d];
+    }
+    for (int d = 0; d < NUM_DIRECTIONS; d++) {
+        outFile << "," << record.maxQueueLengths[d];
+    }
+    outFile << "\n";
+}
+
+void TimeSeriesSamplerClass::print(ostream &outStream) const {
+    outStream << "Every " << interval << " tics";
+    if (decimation > 1) {
+        outStream << ", " << decimation << " samples per record";
+    }
+    outStream << ", to " << outFname;
+}
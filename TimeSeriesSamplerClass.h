@@ -0,0 +1,190 @@
+#ifndef _TIMESERIESSAMPLERCLASS_H_
+#define _TIMESERIESSAMPLERCLASS_H_
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <pthread.h>
+
+#include "constants.h"
+
+//The ring buffer is split into this many chunks, each handed to the
+//writer thread whole once full
+const int TIME_SERIES_NUM_CHUNKS = 8;
+//Records per chunk
+const int TIME_SERIES_CHUNK_RECORDS = 1024;
+
+//One line of the time series: the state at a sample time, or with
+//decimation, summarized over a window of consecutive samples.
+struct TimeSeriesRecordStruct
+{
+  int time; //Time of the (first) sample
+  int light; //LIGHT_* state at that sample
+  double meanQueueLengths[NUM_DIRECTIONS]; //Cars queued, averaged over
+                                           //the window's samples
+  int maxQueueLengths[NUM_DIRECTIONS]; //Most cars queued at any sample
+                                       //of the window
+};
+
+//Programmer: James Zhu
+//Date: October 2026
+//Purpose: Samples each approach's queue length and the light state every
+//         interval tics of a run, and writes them to a CSV file without
+//         the simulation waiting on the disk.  Since the state only
+//         changes at events, the simulation hands over its state just
+//         before each event, and every sample time passed since the last
+//         event gets that state.
+//
+//         With a decimation above 1, every decimation consecutive samples
+//         are summarized into one record (the mean and the maximum of
+//         each queue over them), so very long runs give files of a
+//         manageable size while keeping their peaks.
+//
+//         Records go into a ring buffer allocated once, of
+//         TIME_SERIES_NUM_CHUNKS chunks.  A full chunk is handed to a
+//         background thread that formats and writes it while the
+//         simulation fills the next, so the simulation only stops when
+//         the writer falls a whole ring behind.  The file is created,
+//         and the thread started, at the first sample of each run.
+class TimeSeriesSamplerClass
+{
+  private:
+    int interval; //Tics between samples, or 0 when not sampling
+    int decimation; //Samples summarized into each record
+    std::string outFname; //File the records are written to
+
+    //State of the run being sampled
+    bool isRunning; //Whether the file is open and the writer running
+    bool isFinished; //Whether the run's file has been completed
+    int nextSampleTime; //Time of the next sample not yet taken
+    int windowSamples; //Samples taken into the pending record
+    TimeSeriesRecordStruct pendingRecord; //The record being summarized
+
+    //The ring buffer, filled by the simulation and drained by the writer
+    std::vector< TimeSeriesRecordStruct > ringRecords; //The chunks, in turn
+    int chunkCounts[TIME_SERIES_NUM_CHUNKS]; //Records in each full chunk
+    bool isChunkFull[TIME_SERIES_NUM_CHUNKS]; //Handed to the writer and
+                                              //not yet written
+    int fillChunk; //Chunk the simulation is filling
+    int fillCount; //Records in it so far
+    bool isStopping; //Set once the last chunk has been handed over
+
+    std::ofstream outFile; //Written only by the writer thread
+    pthread_t writerThread;
+    pthread_mutex_t ringMutex; //Guards isChunkFull, chunkCounts and
+                               //isStopping
+    pthread_cond_t chunkFilled; //Signalled when a chunk is handed over
+    pthread_cond_t chunkEmptied; //Signalled when a chunk is written
+
+    //Creates the file and starts the writer.  Returns false, leaving
+    //sampling off for this run, if the file can't be created.
+    bool startRun(
+         );
+
+    //Stores any partly summarized record, hands everything pending to
+    //the writer, waits for it to finish and closes the file.
+    void stopRun(
+         );
+
+    //Adds one sample to the pending record, storing the record once its
+    //window is complete.
+    void addSample(
+         const int sampleTime,
+         const int light,
+         const int queueLengths[NUM_DIRECTIONS]
+         );
+
+    //Stores a record in the ring, handing the chunk over once full.
+    void storeRecord(
+         const TimeSeriesRecordStruct &record
+         );
+
+    //Hands the chunk being filled to the writer, waiting for the next
+    //one to be free.
+    void handOverChunk(
+         );
+
+    //Thread body: writes full chunks in order until told to stop.  The
+    //argument is the sampler.
+    static void* runWriter(
+         void *samplerPtr
+         );
+
+    //Formats one record as a CSV line.
+    void writeRecord(
+         const TimeSeriesRecordStruct &record
+         );
+
+    //Not copyable - the thread and its file belong to exactly one object.
+    TimeSeriesSamplerClass(
+         const TimeSeriesSamplerClass &rhs
+         );
+    TimeSeriesSamplerClass& operator=(
+         const TimeSeriesSamplerClass &rhs
+         );
+
+  public:
+    //Creates a sampler that is not sampling.
+    TimeSeriesSamplerClass(
+         );
+
+    //Finishes any run being sampled.
+    ~TimeSeriesSamplerClass(
+         );
+
+    //Sets the tics between samples, the samples per record and the file,
+    //all reused by every run.  Returns false, leaving sampling off, if
+    //the interval or decimation isn't positive or the name is empty.
+    bool setup(
+         const int inInterval,
+         const int inDecimation,
+         const std::string &inOutFname
+         );
+
+    //Returns true if sampling has been set up.
+    bool getIsEnabled(
+         ) const
+    {
+      return interval > 0;
+    }
+
+    //Returns true if a sample is due before the given event time, so the
+    //state should be handed over with addSamplesBefore first.
+    bool getIsDue(
+         const int eventTime
+         ) const
+    {
+      return interval > 0 && eventTime > nextSampleTime;
+    }
+
+    //Takes every sample due before the given event time, all with the
+    //given state, starting the run's file at the first one.
+    void addSamplesBefore(
+         const int eventTime,
+         const int light,
+         const int queueLengths[NUM_DIRECTIONS]
+         );
+
+    //Takes every sample due up to and including the run's end time with
+    //the final state, writes out everything pending, stops the writer
+    //and closes the file.  Does nothing if the run's file is already
+    //complete.
+    void finishRun(
+         const int endTime,
+         const int light,
+         const int queueLengths[NUM_DIRECTIONS]
+         );
+
+    //Forgets the run being sampled (finishing its file as it stands), so
+    //the next run starts from time 0 with a new file.
+    void restart(
+         );
+
+    //Prints the settings on a single line.
+    void print(
+         std::ostream &outStream
+         ) const;
+};
+
+#endif // _TIMESERIESSAMPLERCLASS_H_
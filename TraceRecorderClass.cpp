@@ -0,0 +1,322 @@
+// James Zhu
+// October 2026
+// Implementation of the TraceRecorderClass, which records narration as
+// compact records and renders them to text on demand.
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstring>
+using namespace std;
+
+#include "TraceRecorderClass.h"
+#include "EventClass.h"
+#include "constants.h"
+
+TraceRecorderClass::TraceRecorderClass()
+ : isFileOpen(false), isFinished(false) {}
+
+TraceRecorderClass::~TraceRecorderClass() {
+    finishRun();
+}
+
+bool TraceRecorderClass::setup(const string &inOutFname) {
+    restart();
+    outFname = inOutFname;
+    return !outFname.empty();
+}
+
+void TraceRecorderClass::writeRecords() {
+    if (!isFileOpen) {
+        outFile.clear();
+        outFile.open(outFname.c_str(), ios::out | ios::binary | ios::trunc);
+        if (outFile.fail()) {
+            cout << "ERROR: Unable to create trace file: " << outFname <<
+                    endl;
+            // Dropped, so a run without its file still uses bounded memory
+            records.clear();
+            return;
+        }
+        outFile.write(TRACE_MAGIC, TRACE_MAGIC_LENGTH);
+        isFileOpen = true;
+    }
+    if (!records.empty()) {
+        outFile.write((const char *)&records[0],
+                      records.size() * sizeof(TraceRecordStruct));
+    }
+    records.clear();
+}
+
+void TraceRecorderClass::finishRun() {
+    if (outFname.empty() || isFinished) {
+        return;
+    }
+    // Even a run that narrated nothing gets a (header only) file
+    writeRecords();
+    if (isFileOpen) {
+        outFile.close();
+        isFileOpen = false;
+    }
+    isFinished = true;
+}
+
+void TraceRecorderClass::restart() {
+    if (isFileOpen) {
+        finishRun();
+    }
+    records.clear();
+    isFinished = false;
+}
+
+void TraceRecorderClass::render(ostream &outStream) const {
+    for (int i = 0; i < (int)records.size(); i++) {
+        renderRecord(outStream, records[i]);
+    }
+}
+
+// Writes a lane given by its lane queue index as "<bound> <lane>"
+static void renderLane(ostream &outStream, const int laneQueueIdx) {
+    outStream << DIRECTION_BOUND_LABELS[laneQueueIdx / NUM_LANES] << " " <<
+                 LANE_NAMES[laneQueueIdx % NUM_LANES];
+}
+
+// Writes a lane as its direction, followed by its movement for turns
+static void renderTurn(ostream &outStream, const int laneQueueIdx) {
+    outStream << DIRECTION_BOUND_LABELS[laneQueueIdx / NUM_LANES];
+    if (laneQueueIdx % NUM_LANES != LANE_THROUGH) {
+        outStream << " turning " << LANE_NAMES[laneQueueIdx % NUM_LANES];
+    }
+}
+
+// Writes the phase a light state belongs to, e.g. "left-turn yellow"
+static void renderPhase(ostream &outStream, const int light) {
+    if (light >= LIGHT_GREEN_LEFT_EW) {
+        outStream << "left-turn ";
+    }
+    // Yellow states always immediately follow their green states
+    outStream << ((light % 2 == 0) ? "yellow" : "green");
+}
+
+// Returns true if the record's directions, lanes and light states are
+// ones its format can name, so rendering it can't index past a label
+static bool getAreArgsValid(const TraceRecordStruct &record) {
+    const int *args = record.args;
+    int dirIdx = 0;
+    int laneQueueIdx = 0;
+    int light = LIGHT_GREEN_EW;
+
+    switch (record.formatId) {
+    case TRACE_CAR_ARRIVES:
+    case TRACE_CAR_ENTERS:
+    case TRACE_CAR_DEPARTS:
+        laneQueueIdx = args[2];
+        break;
+    case TRACE_CAR_DIVERTED:
+    case TRACE_CAR_HELD:
+    case TRACE_TRACE_ENDED:
+    case TRACE_RATE_ZERO:
+    case TRACE_PAST_LAST_TIME:
+        dirIdx = args[1];
+        break;
+    case TRACE_NO_YELLOW_ADVANCE:
+    case TRACE_RED_NO_DEPARTURE:
+    case TRACE_CAR_YIELDS:
+    case TRACE_NO_YELLOW_DEPARTURE:
+        laneQueueIdx = args[0];
+        break;
+    case TRACE_CAR_ADVANCES:
+        laneQueueIdx = args[1];
+        break;
+    case TRACE_ADVANCING:
+        light = args[0];
+        break;
+    case TRACE_NONE_ON_YELLOW:
+        dirIdx = args[0];
+        break;
+    case TRACE_NUM_ADVANCED:
+        dirIdx = args[0];
+        light = args[1];
+        break;
+    }
+    return (dirIdx >= 0 && dirIdx < NUM_DIRECTIONS &&
+            laneQueueIdx >= 0 && laneQueueIdx < NUM_LANE_QUEUES &&
+            light >= LIGHT_GREEN_EW && light <= LIGHT_YELLOW_LEFT_NS);
+}
+
+bool TraceRecorderClass::renderRecord(ostream &outStream,
+                                      const TraceRecordStruct &record) {
+    const int *args = record.args;
+    // Records that aren't valid go to the unknown format line below
+    const int formatId = getAreArgsValid(record) ? record.formatId : -1;
+    bool isKnown = true;
+
+    switch (formatId) {
+    case TRACE_HANDLING:
+        outStream << "\nHandling " << EventClass(args[1], args[0]);
+        break;
+    case TRACE_SCHEDULED:
+        outStream << "Time: " << args[0] << " Scheduled " <<
+                     EventClass(args[2], args[1]);
+        break;
+    case TRACE_GREEN_EXTENDED:
+        outStream << "Time: " << args[0] << " Green extended, Scheduled " <<
+                     EventClass(args[2], args[1]);
+        break;
+    case TRACE_CAR_ARRIVES:
+    case TRACE_CAR_ENTERS:
+        outStream << "Time: " << args[0] << " Car #" << args[1] <<
+                     ((formatId == TRACE_CAR_ENTERS) ?
+                      " enters from upstream " : " arrives ") <<
+                     DIRECTION_BOUND_LABELS[args[2] / NUM_LANES];
+        if (args[2] % NUM_LANES != LANE_THROUGH) {
+            outStream << " in " << LANE_NAMES[args[2] % NUM_LANES] << " lane";
+        }
+        outStream << " - queue length: " << args[3];
+        break;
+    case TRACE_CAR_DIVERTED:
+        outStream << "Time: " << args[0] << " A " <<
+                     DIRECTION_BOUND_LABELS[args[1]] <<
+                     " car is diverted - storage full";
+        break;
+    case TRACE_CAR_HELD:
+        outStream << "Time: " << args[0] << " A " <<
+                     DIRECTION_BOUND_LABELS[args[1]] <<
+                     " car is held upstream - storage full, cars held: " <<
+                     args[2];
+        break;
+    case TRACE_TRACE_ENDED:
+        outStream << "Time: " << args[0] << " No further " <<
+                     DIRECTION_NAMES[args[1]] << "-bound arrivals in trace";
+        break;
+    case TRACE_RATE_ZERO:
+        outStream << "Time: " << args[0] << " " << DIRECTION_NAMES[args[1]] <<
+                     "-bound arrival rate is zero from now on";
+        break;
+    case TRACE_PAST_LAST_TIME:
+        outStream << "Time: " << args[0] << " No further " <<
+                     DIRECTION_NAMES[args[1]] <<
+                     "-bound arrivals - the next is past the last time";
+        break;
+    case TRACE_NO_YELLOW_ADVANCE:
+        outStream << "  Next ";
+        renderTurn(outStream, args[0]);
+        outStream << " car will NOT advance on yellow";
+        break;
+    case TRACE_CAR_ADVANCES:
+        outStream << "  Car #" << args[0] << " advances ";
+        renderTurn(outStream, args[1]);
+        break;
+    case TRACE_ADVANCING:
+        outStream << "Advancing cars on " <<
+                     ((args[0] == LIGHT_GREEN_EW ||
+                       args[0] == LIGHT_YELLOW_EW ||
+                       args[0] == LIGHT_GREEN_LEFT_EW ||
+                       args[0] == LIGHT_YELLOW_LEFT_EW) ?
+                      "east-west " : "north-south ");
+        renderPhase(outStream, args[0]);
+        break;
+    case TRACE_NONE_ON_YELLOW:
+        outStream << "  No " << DIRECTION_BOUND_LABELS[args[0]] <<
+                     " cars waiting to advance on yellow";
+        break;
+    case TRACE_NUM_ADVANCED:
+        outStream << DIRECTION_NAMES[args[0]] << "-bound cars advanced on ";
+        renderPhase(outStream, args[1]);
+        outStream << ": " << args[2] << " Remaining queue: " << args[3];
+        break;
+    case TRACE_RED_NO_DEPARTURE:
+        outStream << "  Light is red, no ";
+        renderLane(outStream, args[0]);
+        outStream << " departure";
+        break;
+    case TRACE_CAR_YIELDS:
+        outStream << "  Next ";
+        renderLane(outStream, args[0]);
+        outStream << " car yields to oncoming traffic";
+        break;
+    case TRACE_NO_YELLOW_DEPARTURE:
+        outStream << "  Next ";
+        renderLane(outStream, args[0]);
+        outStream << " car will NOT advance on yellow";
+        break;
+    case TRACE_CAR_DEPARTS:
+        outStream << "Time: " << args[0] << " Car #" << args[1] <<
+                     " departs ";
+        renderLane(outStream, args[2]);
+        outStream << " lane - queue length: " << args[3];
+        break;
+    case TRACE_CONVERGED:
+        outStream << "Statistics converged at time " << args[0] <<
+                     ", ending the run";
+        break;
+    case TRACE_WARMUP_ENDED:
+        outStream << "Warm-up ended at time " << args[0] <<
+                     ", statistics reset to it";
+        break;
+    case TRACE_NO_EVENTS:
+        outStream << "No events to handle. Simulation complete.";
+        break;
+    case TRACE_AFTER_END:
+        outStream << "Next event occurs AFTER the simulation end time (" <<
+                     EventClass(args[1], args[0]) << ")!";
+        break;
+    case TRACE_INVALID_DIRECTION:
+        outStream << "Error: Invalid travel direction!";
+        break;
+    case TRACE_INVALID_LIGHT:
+        outStream << "Error: Invalid light state!";
+        break;
+    case TRACE_UNKNOWN_EVENT:
+        outStream << "Unknown event type encountered.";
+        break;
+    default:
+        outStream << "Unknown trace record format: " << record.formatId;
+        isKnown = false;
+        break;
+    }
+    outStream << "\n";
+    return isKnown;
+}
+
+bool TraceRecorderClass::renderFile(const string &inFname,
+                                    ostream &outStream) {
+    ifstream inFile(inFname.c_str(), ios::in | ios::binary);
+    char magic[TRACE_MAGIC_LENGTH];
+    vector< TraceRecordStruct > chunk(TRACE_CHUNK_RECORDS);
+    bool areAllKnown = true;
+
+    inFile.read(magic, TRACE_MAGIC_LENGTH);
+    if (inFile.fail() || memcmp(magic, TRACE_MAGIC, TRACE_MAGIC_LENGTH) != 0) {
+        return false;
+    }
+    while (true) {
+        inFile.read((char *)&chunk[0],
+                    TRACE_CHUNK_RECORDS * sizeof(TraceRecordStruct));
+        const streamsize numBytes = inFile.gcount();
+        const int numRecords = (int)(numBytes / sizeof(TraceRecordStruct));
+        for (int i = 0; i < numRecords; i++) {
+            if (!renderRecord(outStream, chunk[i])) {
+                areAllKnown = false;
+            }
+        }
+        if (numBytes % sizeof(TraceRecordStruct) != 0) {
+            // The file ends part way through a record
+            return false;
+        }
+        if (numRecords < TRACE_CHUNK_RECORDS) {
+            break;
+        }
+    }
+    outStream.flush();
+    return areAllKnown;
+}
+
+void TraceRecorderClass::print(ostream &outStream) const {
+    if (outFname.empty()) {
+        outStream << "Held for rendering on demand";
+    }
+    else {
+        outStream << "Written to " << outFname;
+    }
+}
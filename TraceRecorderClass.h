@@ -0,0 +1,195 @@
+#ifndef _TRACERECORDERCLASS_H_
+#define _TRACERECORDERCLASS_H_
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+
+//The lines the simulation narrates, one format per kind of line.  The
+//arguments each takes are listed in order; a lane is given by its lane
+//queue index (dirIdx * NUM_LANES + laneIdx) and an event by its type and
+//time.
+const int TRACE_HANDLING = 0; //Event type, event time
+const int TRACE_SCHEDULED = 1; //Time, event type, event time
+const int TRACE_GREEN_EXTENDED = 2; //Time, event type, event time
+const int TRACE_CAR_ARRIVES = 3; //Time, car id, lane, queue length
+const int TRACE_CAR_ENTERS = 4; //Time, car id, lane, queue length
+const int TRACE_CAR_DIVERTED = 5; //Time, direction
+const int TRACE_CAR_HELD = 6; //Time, direction, cars held
+const int TRACE_TRACE_ENDED = 7; //Time, direction
+const int TRACE_RATE_ZERO = 8; //Time, direction
+const int TRACE_NO_YELLOW_ADVANCE = 9; //Lane
+const int TRACE_CAR_ADVANCES = 10; //Car id, lane
+const int TRACE_ADVANCING = 11; //Light state of the phase ending
+const int TRACE_NONE_ON_YELLOW = 12; //Direction
+const int TRACE_NUM_ADVANCED = 13; //Direction, light state of the phase
+                                   //ending, cars advanced, queue length
+const int TRACE_RED_NO_DEPARTURE = 14; //Lane
+const int TRACE_CAR_YIELDS = 15; //Lane
+const int TRACE_NO_YELLOW_DEPARTURE = 16; //Lane
+const int TRACE_CAR_DEPARTS = 17; //Time, car id, lane, queue length
+const int TRACE_CONVERGED = 18; //Time
+const int TRACE_WARMUP_ENDED = 19; //Warm-up end time
+const int TRACE_NO_EVENTS = 20; //None
+const int TRACE_AFTER_END = 21; //Event type, event time
+const int TRACE_INVALID_DIRECTION = 22; //None
+const int TRACE_INVALID_LIGHT = 23; //None
+const int TRACE_UNKNOWN_EVENT = 24; //None
+const int TRACE_PAST_LAST_TIME = 25; //Time, direction
+const int NUM_TRACE_FORMATS = 26;
+
+//Most arguments any format takes
+const int TRACE_MAX_ARGS = 4;
+
+//Records held before they are written to the trace file, if there is one
+const int TRACE_CHUNK_RECORDS = 65536;
+
+//Marks the start of a trace file
+const char TRACE_MAGIC[] = "SIMTRC01";
+const int TRACE_MAGIC_LENGTH = 8;
+
+//One narrated line, not yet formatted: which kind of line, and the
+//numbers that go into it (unused ones are 0).
+struct TraceRecordStruct
+{
+  int formatId; //One of the TRACE_* formats
+  int args[TRACE_MAX_ARGS]; //The format's arguments, in order
+};
+
+//Programmer: James Zhu
+//Date: October 2026
+//Purpose: Captures a simulation's narration as compact records instead
+//         of text.  Recording a line costs a few stores; the labels,
+//         event descriptions and number formatting are only done when
+//         the records are rendered, which gives exactly the text the
+//         simulation would have narrated.
+//
+//         Records are either held in memory, to be rendered on demand,
+//         or, once a trace file is set up, written to it in chunks of
+//         TRACE_CHUNK_RECORDS so that long runs use bounded memory.  A
+//         trace file is TRACE_MAGIC followed by the records as native
+//         ints, and is rendered later by renderFile (tracefmt.exe).  The
+//         file is created at the first chunk of each run.
+class TraceRecorderClass
+{
+  private:
+    std::vector< TraceRecordStruct > records; //Held, not yet written
+    std::string outFname; //Trace file, or empty to hold every record
+    std::ofstream outFile; //Open from a run's first chunk to its end
+    bool isFileOpen; //Whether outFile holds this run's trace so far
+    bool isFinished; //Whether this run's trace file has been completed
+
+    //Writes the held records to the trace file, creating it if this is
+    //the run's first chunk, and forgets them.
+    void writeRecords(
+         );
+
+    //Not copyable - the trace file belongs to exactly one object.
+    TraceRecorderClass(
+         const TraceRecorderClass &rhs
+         );
+    TraceRecorderClass& operator=(
+         const TraceRecorderClass &rhs
+         );
+
+  public:
+    //Creates a recorder that holds every record in memory.
+    TraceRecorderClass(
+         );
+
+    //Writes out any records held for the trace file.
+    ~TraceRecorderClass(
+         );
+
+    //Sets the file every run's records are written to.  Returns false,
+    //leaving records held in memory, if the name is empty.
+    bool setup(
+         const std::string &inOutFname
+         );
+
+    //Returns true if records go to a trace file.
+    bool getHasFile(
+         ) const
+    {
+      return !outFname.empty();
+    }
+
+    //Records one line in the given format.
+    void add(
+         const int formatId,
+         const int arg0,
+         const int arg1,
+         const int arg2,
+         const int arg3
+         )
+    {
+      TraceRecordStruct record;
+
+      record.formatId = formatId;
+      record.args[0] = arg0;
+      record.args[1] = arg1;
+      record.args[2] = arg2;
+      record.args[3] = arg3;
+      records.push_back(record);
+      if ((int)records.size() == TRACE_CHUNK_RECORDS && !outFname.empty())
+      {
+        writeRecords();
+      }
+    }
+
+    //Returns the number of records held in memory.
+    int getNumRecords(
+         ) const
+    {
+      return (int)records.size();
+    }
+
+    //Returns a record held in memory.
+    const TraceRecordStruct& getRecord(
+         const int recordIdx
+         ) const
+    {
+      return records[recordIdx];
+    }
+
+    //Writes the records held in memory to the stream as text.
+    void render(
+         std::ostream &outStream
+         ) const;
+
+    //Writes out the records held for the trace file and closes it.
+    //Does nothing if records are held in memory, or if the run's file
+    //is already complete.
+    void finishRun(
+         );
+
+    //Forgets the records of the run so far (finishing the trace file as
+    //it stands), so the next run starts a new trace.
+    void restart(
+         );
+
+    //Writes one record to the stream as the line the simulation would
+    //have narrated, newline included.  A record of an unknown format, or
+    //whose direction, lane or light state is out of range, is written as
+    //an unknown format line instead, and false is returned.
+    static bool renderRecord(
+         std::ostream &outStream,
+         const TraceRecordStruct &record
+         );
+
+    //Writes every record of a trace file to the stream as text.  Returns
+    //false if the file can't be opened, isn't a complete trace file or
+    //has a record renderRecord can't render.
+    static bool renderFile(
+         const std::string &inFname,
+         std::ostream &outStream
+         );
+
+    //Prints the settings on a single line.
+    void print(
+         std::ostream &outStream
+         ) const;
+};
+
+#endif // _TRACERECORDERCLASS_H_
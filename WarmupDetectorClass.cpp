@@ -0,0 +1,151 @@
+// James Zhu
+// October 2026
+// Implementation of the WarmupDetectorClass, which finds the end of a
+// run's start-up transient with the MSER-5 rule as the run goes.
+
+#include <iostream>
+#include <algorithm>
+using namespace std;
+
+#include "WarmupDetectorClass.h"
+
+WarmupDetectorClass::WarmupDetectorClass()
+ : checkEvents(0) {
+    restart();
+}
+
+bool WarmupDetectorClass::setup(const int inCheckEvents) {
+    if (inCheckEvents <= 0) {
+        checkEvents = 0;
+        return false;
+    }
+    checkEvents = inCheckEvents;
+    restart();
+    return true;
+}
+
+void WarmupDetectorClass::restart() {
+    eventsSinceCheck = 0;
+    lastEventTime = 0;
+    lastCheckTime = 0;
+    queueArea = 0;
+
+    observationsPerBatch = WARMUP_OBSERVATIONS_PER_BATCH;
+    observationsInBatch = 0;
+    pendingSum = 0;
+    for (int i = 0; i < NUM_DIRECTIONS; i++) {
+        pendingMaxQueues[i] = 0;
+    }
+
+    numBatches = 0;
+    numTruncated = -1;
+}
+
+void WarmupDetectorClass::mergeBatches() {
+    numBatches /= 2;
+    for (int i = 0; i < numBatches; i++) {
+        batchMeans[i] = (batchMeans[2 * i] + batchMeans[2 * i + 1]) / 2;
+        batchEndTimes[i] = batchEndTimes[2 * i + 1];
+        for (int d = 0; d < NUM_DIRECTIONS; d++) {
+            batchMaxQueues[i][d] = max(batchMaxQueues[2 * i][d],
+                                       batchMaxQueues[2 * i + 1][d]);
+        }
+        for (int l = 0; l < NUM_LANE_QUEUES; l++) {
+            batchEndAdvanced[i][l] = batchEndAdvanced[2 * i + 1][l];
+        }
+    }
+    observationsPerBatch *= 2;
+}
+
+int WarmupDetectorClass::findTruncationPoint() const {
+    double sum = 0;
+    double sumSquares = 0;
+    double bestMser = 0;
+    int bestTruncation = 0;
+
+    // Sums over the batches after each candidate point, built from the end
+    for (int d = numBatches - 1; d >= 0; d--) {
+        sum += batchMeans[d];
+        sumSquares += batchMeans[d] * batchMeans[d];
+        const int numKept = numBatches - d;
+        if (numKept < MIN_WARMUP_BATCHES_KEPT) {
+            continue;
+        }
+        double mser = (sumSquares - sum * sum / numKept) /
+                      ((double)numKept * numKept);
+        // Ties go to the earlier point, which keeps more of the run
+        if (numKept == MIN_WARMUP_BATCHES_KEPT || mser <= bestMser) {
+            bestMser = mser;
+            bestTruncation = d;
+        }
+    }
+    return bestTruncation;
+}
+
+bool WarmupDetectorClass::addObservation(
+    const int numAdvanced[NUM_LANE_QUEUES]) {
+    const int observedTics = lastEventTime - lastCheckTime;
+
+    // An observation in which no time has passed has no average, so it
+    // simply carries on into the next one
+    eventsSinceCheck = 0;
+    if (observedTics <= 0) {
+        return false;
+    }
+    pendingSum += queueArea / observedTics;
+    queueArea = 0;
+    lastCheckTime = lastEventTime;
+    observationsInBatch++;
+    if (observationsInBatch < observationsPerBatch) {
+        return false;
+    }
+
+    batchMeans[numBatches] = pendingSum / observationsInBatch;
+    batchEndTimes[numBatches] = lastEventTime;
+    for (int d = 0; d < NUM_DIRECTIONS; d++) {
+        batchMaxQueues[numBatches][d] = pendingMaxQueues[d];
+        pendingMaxQueues[d] = 0;
+    }
+    for (int l = 0; l < NUM_LANE_QUEUES; l++) {
+        batchEndAdvanced[numBatches][l] = numAdvanced[l];
+    }
+    numBatches++;
+    observationsInBatch = 0;
+    pendingSum = 0;
+    if (numBatches == MAX_WARMUP_BATCHES) {
+        mergeBatches();
+    }
+
+    if (numBatches >= MIN_WARMUP_BATCHES) {
+        int truncation = findTruncationPoint();
+        if (2 * truncation < numBatches) {
+            numTruncated = truncation;
+            return true;
+        }
+    }
+    return false;
+}
+
+int WarmupDetectorClass::getWarmupEndTime() const {
+    return (numTruncated > 0) ? batchEndTimes[numTruncated - 1] : 0;
+}
+
+int WarmupDetectorClass::getAdvancedAtWarmupEnd(
+    const int laneQueueIdx) const {
+    return (numTruncated > 0) ?
+           batchEndAdvanced[numTruncated - 1][laneQueueIdx] : 0;
+}
+
+int WarmupDetectorClass::getMaxQueueSinceWarmup(const int dirIdx) const {
+    int maxQueue = pendingMaxQueues[dirIdx];
+
+    for (int i = max(numTruncated, 0); i < numBatches; i++) {
+        maxQueue = max(maxQueue, batchMaxQueues[i][dirIdx]);
+    }
+    return maxQueue;
+}
+
+void WarmupDetectorClass::print(ostream &outStream) const {
+    outStream << "MSER-" << WARMUP_OBSERVATIONS_PER_BATCH
+              << ", observation every " << checkEvents << " events";
+}
@@ -0,0 +1,171 @@
+#ifndef _WARMUPDETECTORCLASS_H_
+#define _WARMUPDETECTORCLASS_H_
+
+#include <iostream>
+
+#include "constants.h"
+
+//Batches kept at once; when full, neighbouring batches are merged in
+//pairs, doubling the batch size
+const int MAX_WARMUP_BATCHES = 64;
+//Fewest batches the warm-up end is judged from
+const int MIN_WARMUP_BATCHES = 10;
+//Observations averaged into each batch to begin with (the 5 of MSER-5)
+const int WARMUP_OBSERVATIONS_PER_BATCH = 5;
+//Fewest batches that must be left after the truncation point, so the
+//rule isn't fooled by a few similar batches at the very end
+const int MIN_WARMUP_BATCHES_KEPT = 5;
+
+//Programmer: James Zhu
+//Date: October 2026
+//Purpose: Detects, while a run is in progress, when the start-up
+//         transient of empty queues has ended, using the MSER-5 rule.
+//         Every checkEvents events the time-average total queue length
+//         since the last observation is taken as one observation, and
+//         observations are averaged in batches of 5.  The truncation
+//         point d is the number of leading batches whose removal
+//         minimizes the variance of the mean of the rest,
+//           MSER(d) = sum over i > d of (x_i - mean)^2 / (n - d)^2
+//         and the warm-up is taken to have ended once d falls in the
+//         first half of the batches seen so far.
+//
+//         So the statistics can be reset to exactly the truncation point,
+//         even though it is only found later, each batch also keeps the
+//         longest queue of every direction during it and the cars
+//         advanced from every lane by its end.  Memory is bounded: once
+//         MAX_WARMUP_BATCHES batches are full, neighbouring pairs are
+//         merged and each batch from then on averages twice as many
+//         observations.
+class WarmupDetectorClass
+{
+  private:
+    int checkEvents; //Events per observation, or 0 when not detecting
+
+    int eventsSinceCheck; //Events counted since the last observation
+    int lastEventTime; //Time of the most recent event
+    int lastCheckTime; //Time of the last observation
+    double queueArea; //Sum of cars queued times tics, since the last
+                      //observation
+
+    int observationsPerBatch; //Observations averaged into each batch
+    int observationsInBatch; //Observations in the batch being filled
+    double pendingSum; //Sum of the observations of the batch being filled
+    int pendingMaxQueues[NUM_DIRECTIONS]; //Longest queues of the batch
+                                          //being filled
+
+    int numBatches; //Batches completed
+    double batchMeans[MAX_WARMUP_BATCHES]; //Mean observation of each batch
+    int batchEndTimes[MAX_WARMUP_BATCHES]; //Time each batch ended
+    int batchMaxQueues[MAX_WARMUP_BATCHES][NUM_DIRECTIONS]; //Longest
+                                           //queue of each direction during
+                                           //each batch
+    int batchEndAdvanced[MAX_WARMUP_BATCHES][NUM_LANE_QUEUES]; //Cars
+                                           //advanced from each lane by the
+                                           //end of each batch
+    int numTruncated; //Batches found to be warm-up, or -1 until found
+
+    //Merges neighbouring batches in pairs.
+    void mergeBatches(
+         );
+
+    //Returns the MSER truncation point of the batches so far.
+    int findTruncationPoint(
+         ) const;
+
+  public:
+    //Creates a detector that is not detecting.
+    WarmupDetectorClass(
+         );
+
+    //Starts detecting, taking an observation every inCheckEvents events.
+    //Returns false, leaving the detector off, if it is not positive.
+    bool setup(
+         const int inCheckEvents
+         );
+
+    //Returns true if the detector is set up.
+    bool getIsEnabled(
+         ) const
+    {
+      return (checkEvents > 0);
+    }
+
+    //Returns true once the end of the warm-up has been found.
+    bool getIsDetected(
+         ) const
+    {
+      return (numTruncated >= 0);
+    }
+
+    //Forgets everything, ready to watch a new run from time 0.
+    void restart(
+         );
+
+    //Notes the length of a direction's queue after a car joined it.
+    void addQueueLength(
+         const int dirIdx,
+         const int queueLength
+         )
+    {
+      if (queueLength > pendingMaxQueues[dirIdx])
+      {
+        pendingMaxQueues[dirIdx] = queueLength;
+      }
+    }
+
+    //Accounts for an event about to be handled at eventTime, the queues
+    //having held numQueued cars since the previous event.  Returns true
+    //when this event completes an observation, which the caller must
+    //then pass to addObservation.
+    bool addEvent(
+         const int eventTime,
+         const int numQueued
+         )
+    {
+      queueArea += (double)numQueued * (eventTime - lastEventTime);
+      lastEventTime = eventTime;
+      eventsSinceCheck++;
+      return (eventsSinceCheck >= checkEvents);
+    }
+
+    //Closes an observation, given the cars advanced from each lane so
+    //far, and returns true if the end of the warm-up has just been found.
+    bool addObservation(
+         const int numAdvanced[NUM_LANE_QUEUES]
+         );
+
+    //Returns the number of batches completed.
+    int getNumBatches(
+         ) const
+    {
+      return numBatches;
+    }
+
+    //Returns the number of leading batches found to be warm-up.
+    int getNumTruncated(
+         ) const
+    {
+      return numTruncated;
+    }
+
+    //Returns the time the warm-up ended.
+    int getWarmupEndTime(
+         ) const;
+
+    //Returns the cars advanced from a lane by the end of the warm-up.
+    int getAdvancedAtWarmupEnd(
+         const int laneQueueIdx
+         ) const;
+
+    //Returns the longest queue of a direction since the warm-up ended.
+    int getMaxQueueSinceWarmup(
+         const int dirIdx
+         ) const;
+
+    //Prints the observation interval.
+    void print(
+         std::ostream &outStream
+         ) const;
+};
+
+#endif // _WARMUPDETECTORCLASS_H_
@@ -0,0 +1,316 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <time.h>
+using namespace std;
+
+#include "IntersectionSimulationClass.h"
+#include "BatchSimulationClass.h"
+#include "ScenarioBatchClass.h"
+#include "ColumnarWriterClass.h"
+#include "ColumnarReaderClass.h"
+
+//Option, given last, that writes the statistics to a columnar file
+const string COLUMNS_OPTION = "--columns";
+
+//Option, given alone, that summarizes a columnar file written before
+const string READ_OPTION = "--read";
+
+//Prints one scenario's seed and statistics on a line, after the given
+//prefix.
+void printResult(
+     const string &prefix,
+     const SimulationParamsStruct &params,
+     const SimulationStatsStruct &stats
+     )
+{
+  cout << prefix << "Seed: " << params.randomSeedVal << " Max Queues:";
+  for (int d = 0; d < NUM_DIRECTIONS; d++)
+  {
+    cout << " " << stats.maxQueueLengths[d];
+  }
+  cout << " Advanced:";
+  for (int d = 0; d < NUM_DIRECTIONS; d++)
+  {
+    cout << " " << stats.numTotalAdvanced[d];
+  }
+  cout << endl;
+}
+
+//Returns true if two scenarios have the same parameters and statistics.
+bool getIsSameResult(
+     const SimulationParamsStruct &paramsA,
+     const SimulationStatsStruct &statsA,
+     const SimulationParamsStruct &paramsB,
+     const SimulationStatsStruct &statsB
+     )
+{
+  bool isSame = (paramsA.randomSeedVal == paramsB.randomSeedVal &&
+                 paramsA.timeToStopSim == paramsB.timeToStopSim &&
+                 paramsA.eastWestGreenTime == paramsB.eastWestGreenTime &&
+                 paramsA.eastWestYellowTime == paramsB.eastWestYellowTime &&
+                 paramsA.northSouthGreenTime == paramsB.northSouthGreenTime &&
+                 paramsA.northSouthYellowTime ==
+                 paramsB.northSouthYellowTime &&
+                 paramsA.percentCarsAdvanceOnYellow ==
+                 paramsB.percentCarsAdvanceOnYellow);
+
+  for (int d = 0; isSame && d < NUM_DIRECTIONS; d++)
+  {
+    isSame = (paramsA.arrivalMeans[d] == paramsB.arrivalMeans[d] &&
+              paramsA.arrivalStdDevs[d] == paramsB.arrivalStdDevs[d] &&
+              statsA.maxQueueLengths[d] == statsB.maxQueueLengths[d] &&
+              statsA.numTotalAdvanced[d] == statsB.numTotalAdvanced[d]);
+  }
+  return isSame;
+}
+
+//Scans a columnar result file, printing its row and row group counts and
+//the first row of each group.  If expectedParams isn't NULL, checks
+//instead (printing only errors) that the file holds one row per expected
+//scenario and that each group's first row is the scenario written there.
+//Returns false if the file can't be read or a check fails.
+bool scanColumnarFile(
+     const string &fname,
+     const vector< SimulationParamsStruct > *expectedParams,
+     const vector< SimulationStatsStruct > *expectedStats
+     )
+{
+  bool success = true;
+  ColumnarReaderClass reader;
+  int64_t groupStartRow = 0;
+
+  if (!reader.open(fname))
+  {
+    cout << "ERROR: Unable to read columnar file: " << fname << endl;
+    success = false;
+  }
+  else if (!getIsSimulationResultFile(reader))
+  {
+    cout << "ERROR: Columnar file doesn't hold simulation results: " <<
+            fname << endl;
+    success = false;
+  }
+  else if (expectedParams == NULL)
+  {
+    cout << "Rows: " << reader.getNumRows() << " Row groups: " <<
+            reader.getNumRowGroups() << endl;
+  }
+  else if (reader.getNumRows() != (int64_t)expectedParams->size())
+  {
+    cout << "ERROR: Columnar file has " << reader.getNumRows() <<
+            " rows, not " << expectedParams->size() << endl;
+    success = false;
+  }
+
+  for (int g = 0; success && g < reader.getNumRowGroups(); g++)
+  {
+    SimulationParamsStruct params;
+    SimulationStatsStruct stats;
+
+    if (reader.getRowGroupNumRows(g) > 0 &&
+        !readSimulationResult(reader, g, 0, params, stats))
+    {
+      cout << "ERROR: Unable to read row group " << g << endl;
+      success = false;
+    }
+    else if (expectedParams == NULL)
+    {
+      cout << "Group " << g << ": " << reader.getRowGroupNumRows(g) <<
+              " rows" << endl;
+      if (reader.getRowGroupNumRows(g) > 0)
+      {
+        printResult("  First row: ", params, stats);
+      }
+    }
+    else if (reader.getRowGroupNumRows(g) > 0 &&
+             (groupStartRow >= (int64_t)expectedParams->size() ||
+              !getIsSameResult(params, stats,
+                               (*expectedParams)[groupStartRow],
+                               (*expectedStats)[groupStartRow])))
+    {
+      cout << "ERROR: First row of row group " << g <<
+              " isn't the scenario written there" << endl;
+      success = false;
+    }
+    groupStartRow += reader.getRowGroupNumRows(g);
+  }
+
+  if (success && groupStartRow != reader.getNumRows())
+  {
+    cout << "ERROR: Row groups hold " << groupStartRow << " rows, not " <<
+            reader.getNumRows() << endl;
+    success = false;
+  }
+  return success;
+}
+
+//Programmer: James Zhu
+//Date: October 2026
+//Purpose: Runs many scenarios with the lockstep batch simulation, either
+//         every row of a scenario batch file, or a seed sweep of a
+//         parameter file (scenario i uses the file's parameters with the
+//         random seed increased by i).  Prints each scenario's statistics
+//         on one line, or with the columns option writes each scenario's
+//         parameters and statistics as a row of a columnar result file
+//         instead (read back and checked once written), followed by the
+//         overall throughput.  With the read option alone, summarizes a
+//         columnar result file written before instead.
+int main(
+     int argc,
+     char *argv[]
+     )
+{
+  bool success = true;
+  int numArgs = argc;
+  string columnsFname;
+  vector< SimulationParamsStruct > params;
+  vector< int > lineNums;
+  timespec loadStartTime;
+  timespec loadEndTime;
+  const bool isReading = (numArgs == 3 && string(argv[1]) == READ_OPTION);
+
+  if (numArgs >= 4 && string(argv[numArgs - 2]) == COLUMNS_OPTION)
+  {
+    columnsFname = argv[numArgs - 1];
+    numArgs -= 2;
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &loadStartTime);
+  if (isReading)
+  {
+    success = scanColumnarFile(string(argv[2]), NULL, NULL);
+  }
+  else if (numArgs == 2)
+  {
+    ScenarioBatchClass batchFile;
+
+    if (!batchFile.loadFile(string(argv[1])))
+    {
+      cout << "ERROR: Unable to open scenario batch file: " << argv[1] <<
+              endl;
+      success = false;
+    }
+    else
+    {
+      for (int i = 0; i < batchFile.getNumErrors(); i++)
+      {
+        cout << "ERROR: Line " << batchFile.getError(i).lineNum << ": " <<
+                batchFile.getError(i).message << endl;
+      }
+      params.assign(batchFile.getScenarios(), batchFile.getScenarios() +
+                    batchFile.getNumScenarios());
+      for (int i = 0; i < batchFile.getNumScenarios(); i++)
+      {
+        lineNums.push_back(batchFile.getScenarioLineNum(i));
+      }
+    }
+  }
+  else if (numArgs == 3)
+  {
+    IntersectionSimulationClass simObj;
+    SimulationParamsStruct baseParams;
+    int numScenarios = atoi(argv[2]);
+
+    simObj.readParametersFromFile(string(argv[1]));
+    if (numScenarios <= 0)
+    {
+      cout << "ERROR: Number of scenarios must be positive" << endl;
+      success = false;
+    }
+    else if (!simObj.getIsSetupProperly())
+    {
+      cout << "Cannot run batch as parameters are not setup properly!" << endl;
+      success = false;
+    }
+    else if (simObj.getUsesOptionalParameters())
+    {
+      cout << "ERROR: The batch simulation only supports the required "
+              "parameters" << endl;
+      success = false;
+    }
+    else
+    {
+      simObj.getParameters(baseParams);
+      params.assign(numScenarios, baseParams);
+      for (int i = 0; i < numScenarios; i++)
+      {
+        params[i].randomSeedVal = baseParams.randomSeedVal + i;
+      }
+    }
+  }
+  else
+  {
+    cout << "Usage: " << argv[0] << " <scenarioBatchFile> [" <<
+            COLUMNS_OPTION << " <outputFile>]" << endl;
+    cout << "       " << argv[0] << " <parameterFile> <numScenarios> [" <<
+            COLUMNS_OPTION << " <outputFile>]" << endl;
+    cout << "       " << argv[0] << " " << READ_OPTION <<
+            " <columnarFile>" << endl;
+    success = false;
+  }
+  clock_gettime(CLOCK_MONOTONIC, &loadEndTime);
+
+  if (success && !isReading && params.empty())
+  {
+    cout << "ERROR: No valid scenarios to run" << endl;
+    success = false;
+  }
+
+  if (success && !isReading)
+  {
+    const int numScenarios = (int)params.size();
+    vector< SimulationStatsStruct > stats(numScenarios);
+    BatchSimulationClass batchObj;
+    timespec startTime;
+    timespec endTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    batchObj.runScenarios(&params[0], numScenarios, &stats[0]);
+    clock_gettime(CLOCK_MONOTONIC, &endTime);
+
+    if (!columnsFname.empty())
+    {
+      ColumnarWriterClass writer;
+      vector< ColumnSpecStruct > columns;
+
+      getSimulationResultColumns(columns);
+      success = writer.open(columnsFname, columns);
+      for (int i = 0; success && i < numScenarios; i++)
+      {
+        success = writeSimulationResult(writer, params[i], stats[i]);
+      }
+      if (!success || !writer.close())
+      {
+        cout << "ERROR: Unable to write columnar output file: " <<
+                columnsFname << endl;
+        success = false;
+      }
+      else
+      {
+        success = scanColumnarFile(columnsFname, &params, &stats);
+      }
+    }
+    for (int i = 0; columnsFname.empty() && i < numScenarios; i++)
+    {
+      if (!lineNums.empty())
+      {
+        cout << "Line: " << lineNums[i] << " ";
+      }
+      printResult("", params[i], stats[i]);
+    }
+
+    double loadSecs = (loadEndTime.tv_sec - loadStartTime.tv_sec) +
+                      (loadEndTime.tv_nsec - loadStartTime.tv_nsec) / 1e9;
+    double elapsedSecs = (endTime.tv_sec - startTime.tv_sec) +
+                         (endTime.tv_nsec - startTime.tv_nsec) / 1e9;
+    cout << "Loaded " << numScenarios << " scenarios in " << loadSecs <<
+            " seconds" << endl;
+    cout << "Ran " << numScenarios << " scenarios in " << elapsedSecs <<
+            " seconds (" << numScenarios / elapsedSecs <<
+            " scenarios per second)" << endl;
+  }
+
+  return (success ? 0 : 1);
+}
@@ -0,0 +1,179 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstdlib>
+#include <stdint.h>
+#include <time.h>
+using namespace std;
+
+#include "IntersectionSimulationClass.h"
+
+//The ways of driving the simulation that are compared
+const int LOOP_NARRATED = 0; //handleNextEvent loop, narration discarded
+const int LOOP_SILENT = 1; //handleNextEvent loop, log stream NULL
+const int LOOP_RUN_UNTIL = 2; //runUntil, log stream NULL
+const int LOOP_GENERIC = 3; //As LOOP_RUN_UNTIL, but with the generic kernel
+const int LOOP_ASYNC_LOG = 4; //As LOOP_NARRATED, but written by a thread
+const int LOOP_DEFERRED = 5; //As LOOP_NARRATED, but recorded unformatted
+const int NUM_LOOPS = 6;
+const string LOOP_LABELS[NUM_LOOPS] = {
+     "handleNextEvent, narration discarded",
+     "handleNextEvent, silent",
+     "runUntil, silent",
+     "runUntil, silent, generic kernel",
+     "handleNextEvent, narration discarded by writer thread",
+     "handleNextEvent, narration recorded for later" };
+
+//Runs the parameters numRuns times, with the seed increased by one each
+//run, driving the simulation the given way.  Returns the elapsed
+//seconds, and the total events handled and a sum of every statistic
+//via the reference parameters.
+double runLoop(
+     IntersectionSimulationClass &simObj,
+     const SimulationParamsStruct &baseParams,
+     const int numRuns,
+     const int loopIdx,
+     ofstream &discardStream,
+     int64_t &outNumEvents,
+     int64_t &outStatsSum
+     )
+{
+  SimulationParamsStruct params = baseParams;
+  SimulationStatsStruct stats;
+  timespec startTime;
+  timespec endTime;
+
+  outNumEvents = 0;
+  outStatsSum = 0;
+  simObj.setIsLogAsync(loopIdx == LOOP_ASYNC_LOG);
+  simObj.setIsTraceDeferred(loopIdx == LOOP_DEFERRED);
+  simObj.setLogStream((loopIdx == LOOP_NARRATED ||
+                       loopIdx == LOOP_ASYNC_LOG) ? &discardStream : NULL);
+  simObj.setIsKernelSpecialized(loopIdx != LOOP_GENERIC);
+
+  clock_gettime(CLOCK_MONOTONIC, &startTime);
+  for (int i = 0; i < numRuns; i++)
+  {
+    params.randomSeedVal = baseParams.randomSeedVal + i;
+    simObj.setParameters(params);
+    if (loopIdx == LOOP_RUN_UNTIL || loopIdx == LOOP_GENERIC)
+    {
+      simObj.runUntil(params.timeToStopSim);
+    }
+    else
+    {
+      simObj.scheduleSeedEvents();
+      while (simObj.handleNextEvent())
+      {
+      }
+    }
+    outNumEvents += simObj.getNumEventsHandled();
+    simObj.getStatistics(stats);
+    for (int d = 0; d < NUM_DIRECTIONS; d++)
+    {
+      outStatsSum += stats.maxQueueLengths[d] + stats.numTotalAdvanced[d];
+    }
+  }
+  clock_gettime(CLOCK_MONOTONIC, &endTime);
+
+  return (endTime.tv_sec - startTime.tv_sec) +
+         (endTime.tv_nsec - startTime.tv_nsec) / 1e9;
+}
+
+//Programmer: James Zhu
+//Date: October 2026
+//Purpose: Measures how fast the event-driven simulation runs when driven
+//         one handleNextEvent call at a time (with its narration sent to
+//         /dev/null, as when proj5's output is discarded, and silenced)
+//         compared to the runUntil loop, over a seed sweep of one
+//         parameter file, and checks that every way gives the same
+//         statistics.  The runUntil loop is also timed with the generic
+//         event-handling kernel in place of the one specialized to the
+//         parameters, to show what the specialization gains, and the
+//         narrated loop with its narration written by a background
+//         thread, to show what taking the writes off the simulation's
+//         thread gains, and with it recorded as trace records, to show
+//         what leaving the formatting until later gains.
+int main(
+     int argc,
+     char *argv[]
+     )
+{
+  bool success = true;
+  IntersectionSimulationClass simObj;
+  SimulationParamsStruct baseParams;
+  ofstream discardStream;
+  int numRuns = 0;
+
+  if (argc != 3)
+  {
+    cout << "Usage: " << argv[0] << " <parameterFile> <numRuns>" << endl;
+    success = false;
+  }
+  else
+  {
+    numRuns = atoi(argv[2]);
+    simObj.setLogStream(NULL);
+    simObj.readParametersFromFile(string(argv[1]));
+    discardStream.open("/dev/null");
+    if (numRuns <= 0)
+    {
+      cout << "ERROR: Number of runs must be positive" << endl;
+      success = false;
+    }
+    else if (!simObj.getIsSetupProperly())
+    {
+      cout << "Cannot run benchmark as parameters are not setup properly!" <<
+              endl;
+      success = false;
+    }
+    else if (discardStream.fail())
+    {
+      cout << "ERROR: Unable to open /dev/null" << endl;
+      success = false;
+    }
+  }
+
+  if (success)
+  {
+    int64_t numEvents[NUM_LOOPS];
+    int64_t statsSums[NUM_LOOPS];
+    double elapsedSecs[NUM_LOOPS];
+
+    simObj.getParameters(baseParams);
+    for (int i = 0; i < NUM_LOOPS; i++)
+    {
+      elapsedSecs[i] = runLoop(simObj, baseParams, numRuns, i, discardStream,
+                               numEvents[i], statsSums[i]);
+      cout << LOOP_LABELS[i] << ": " << numEvents[i] << " events in " <<
+              elapsedSecs[i] << " seconds (" <<
+              numEvents[i] / elapsedSecs[i] << " events per second)" << endl;
+    }
+    cout << "runUntil speedup: " <<
+            elapsedSecs[LOOP_NARRATED] / elapsedSecs[LOOP_RUN_UNTIL] <<
+            "x over narrated, " <<
+            elapsedSecs[LOOP_SILENT] / elapsedSecs[LOOP_RUN_UNTIL] <<
+            "x over silent" << endl;
+    cout << "Specialized kernel speedup: " <<
+            elapsedSecs[LOOP_GENERIC] / elapsedSecs[LOOP_RUN_UNTIL] <<
+            "x over generic" << endl;
+    cout << "Writer thread speedup: " <<
+            elapsedSecs[LOOP_NARRATED] / elapsedSecs[LOOP_ASYNC_LOG] <<
+            "x over narrated" << endl;
+    cout << "Trace record speedup: " <<
+            elapsedSecs[LOOP_NARRATED] / elapsedSecs[LOOP_DEFERRED] <<
+            "x over narrated" << endl;
+
+    for (int i = 1; i < NUM_LOOPS; i++)
+    {
+      if (numEvents[i] != numEvents[0] || statsSums[i] != statsSums[0])
+      {
+        cout << "ERROR: " << LOOP_LABELS[i] << " gave different results" <<
+                endl;
+        success = false;
+      }
+    }
+  }
+
+  return (success ? 0 : 1);
+}
@@ -22,6 +22,18 @@ const int EVENT_CHANGE_GREEN_EW = 4;
 const int EVENT_CHANGE_YELLOW_EW = 5;
 const int EVENT_CHANGE_GREEN_NS = 6;
 const int EVENT_CHANGE_YELLOW_NS = 7;
+const int EVENT_CHECK_GREEN = 8; //Signal controller decides whether to
+                                 //extend the current green phase
+const int EVENT_CHANGE_GREEN_LEFT_EW = 9;
+const int EVENT_CHANGE_YELLOW_LEFT_EW = 10;
+const int EVENT_CHANGE_GREEN_LEFT_NS = 11;
+const int EVENT_CHANGE_YELLOW_LEFT_NS = 12;
+//Departure events of the saturation flow model, one per lane queue, so
+//the event type is EVENT_DEPART_FIRST plus the lane queue index
+const int EVENT_DEPART_FIRST = 13;
+
+//Last arrival time of a direction no car has arrived from yet
+const int NO_ARRIVAL_TIME = -1;
 
 //Car-related constants
 const int CAR_ID_NOT_SET = -1;
@@ -32,11 +44,67 @@ const std::string WEST_DIRECTION = "West";
 const std::string NORTH_DIRECTION = "North";
 const std::string SOUTH_DIRECTION = "South";
 
+//Direction index constants, used wherever per-direction data is kept in
+//an array.  The order matches the EVENT_ARRIVE_* event types.
+const int DIRECTION_EAST = 0;
+const int DIRECTION_WEST = 1;
+const int DIRECTION_NORTH = 2;
+const int DIRECTION_SOUTH = 3;
+const int NUM_DIRECTIONS = 4;
+
+//Printable direction names, indexed by the DIRECTION_* constants
+const std::string DIRECTION_NAMES[NUM_DIRECTIONS] = {
+     EAST_DIRECTION, WEST_DIRECTION, NORTH_DIRECTION, SOUTH_DIRECTION };
+const std::string DIRECTION_BOUND_LABELS[NUM_DIRECTIONS] = {
+     "east-bound", "west-bound", "north-bound", "south-bound" };
+
+//Lane constants.  Each approach has one lane per movement, and per-lane
+//data is kept in flat arrays indexed by dirIdx * NUM_LANES + laneIdx.
+//Cars go straight unless turning movements are configured.
+const int LANE_THROUGH = 0;
+const int LANE_LEFT = 1;
+const int LANE_RIGHT = 2;
+const int NUM_LANES = 3;
+const int NUM_LANE_QUEUES = NUM_DIRECTIONS * NUM_LANES;
+const std::string LANE_NAMES[NUM_LANES] = { "through", "left", "right" };
+
+//What a car arriving at an approach whose storage is full does
+const int STORAGE_BLOCK = 0; //Waits upstream until there is room
+const int STORAGE_DIVERT = 1; //Goes elsewhere and is lost to the approach
+const int NUM_STORAGE_BEHAVIORS = 2;
+const std::string STORAGE_BEHAVIOR_NAMES[NUM_STORAGE_BEHAVIORS] = {
+     "block", "divert" };
+
+//Last departure event type - see EVENT_DEPART_FIRST
+const int EVENT_DEPART_LAST = EVENT_DEPART_FIRST + NUM_LANE_QUEUES - 1;
+
 //Traffic light state constants
 const int LIGHT_GREEN_EW = 1;
 const int LIGHT_YELLOW_EW = 2;
 const int LIGHT_GREEN_NS = 3;
 const int LIGHT_YELLOW_NS = 4;
+//Protected left turn arrows, used only when protected lefts are enabled
+const int LIGHT_GREEN_LEFT_EW = 5;
+const int LIGHT_YELLOW_LEFT_EW = 6;
+const int LIGHT_GREEN_LEFT_NS = 7;
+const int LIGHT_YELLOW_LEFT_NS = 8;
+
+const int LIGHT_UNKNOWN = 0;
+
+//The event type that changes the light to each state, indexed by state
+const int LIGHT_CHANGE_EVENTS[LIGHT_YELLOW_LEFT_NS + 1] = {
+     EVENT_UNKNOWN,
+     EVENT_CHANGE_GREEN_EW, EVENT_CHANGE_YELLOW_EW,
+     EVENT_CHANGE_GREEN_NS, EVENT_CHANGE_YELLOW_NS,
+     EVENT_CHANGE_GREEN_LEFT_EW, EVENT_CHANGE_YELLOW_LEFT_EW,
+     EVENT_CHANGE_GREEN_LEFT_NS, EVENT_CHANGE_YELLOW_LEFT_NS };
+
+//What the cars in one lane may do under the current light
+const int LANE_SIGNAL_RED = 0;
+const int LANE_SIGNAL_GREEN = 1;
+const int LANE_SIGNAL_YELLOW = 2;
+const int LANE_SIGNAL_PERMITTED = 3; //Left turn on a circular green,
+                                     //yielding to oncoming through cars
 
 //Stop At Yellow Light
 const bool STOP_AT_YELLOW = true;
@@ -49,4 +117,8 @@ const int INCLUSIVE_MAX = 100;
 //Queue is empty
 const int NO_QUEUE = 0;
 
+//Arrival trace files - binary traces begin with this magic string
+const char ARRIVAL_TRACE_MAGIC[] = "ARRTRC01";
+const unsigned int ARRIVAL_TRACE_MAGIC_LEN = 8;
+
 #endif //_CONSTANTS_H_
\ No newline at end of file
@@ -0,0 +1,156 @@
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <time.h>
+using namespace std;
+
+#include "SignalOptimizerClass.h"
+
+//Objective names accepted on the command line
+const string DELAY_OBJECTIVE_NAME = "delay";
+const string MAX_QUEUE_OBJECTIVE_NAME = "maxQueue";
+
+//Option, given last, that sets the range green and yellow times are
+//searched over
+const string BOUNDS_OPTION = "--bounds";
+const int NUM_BOUNDS_ARGS = 5;
+
+//Option, given last (after any bounds), that answers runs made before
+//from a result cache file, and adds new runs to it
+const string CACHE_OPTION = "--cache";
+
+//Programmer: James Zhu
+//Date: October 2026
+//Purpose: Searches a parameter file's green and yellow times for the ones
+//         with the lowest mean car delay or longest queue, averaged over
+//         numReplications replications (the seed increased by one each
+//         time, with substreams, the same for every candidate).  Runs up
+//         to maxGenerations generations of a CMA-ES search on numThreads
+//         threads, printing the best timings after each, then compares
+//         the best with the file's own.  The search is the same whatever
+//         the number of threads.  Files with timeSeries or traceRecords
+//         lines are refused, as every run would write the file.  With the
+//         cache option, runs found in the result cache are not run again.
+int main(
+     int argc,
+     char *argv[]
+     )
+{
+  bool success = true;
+  int numArgs = argc;
+  SignalOptimizerClass optimizer;
+  string cacheFname;
+  int objective = OPTIMIZE_DELAY;
+  int maxGenerations = 0;
+
+  if (numArgs >= 8 && string(argv[numArgs - 2]) == CACHE_OPTION)
+  {
+    cacheFname = argv[numArgs - 1];
+    numArgs -= 2;
+  }
+
+  if (numArgs >= 6 + NUM_BOUNDS_ARGS &&
+      string(argv[numArgs - NUM_BOUNDS_ARGS]) == BOUNDS_OPTION)
+  {
+    const int firstBound = numArgs - NUM_BOUNDS_ARGS + 1;
+
+    if (!optimizer.setBounds(TIMING_EW_GREEN, atoi(argv[firstBound]),
+                             atoi(argv[firstBound + 1])) ||
+        !optimizer.setBounds(TIMING_NS_GREEN, atoi(argv[firstBound]),
+                             atoi(argv[firstBound + 1])) ||
+        !optimizer.setBounds(TIMING_EW_YELLOW, atoi(argv[firstBound + 2]),
+                             atoi(argv[firstBound + 3])) ||
+        !optimizer.setBounds(TIMING_NS_YELLOW, atoi(argv[firstBound + 2]),
+                             atoi(argv[firstBound + 3])))
+    {
+      cout << "ERROR: Bounds must be positive, each minimum no more than "
+              "its maximum" << endl;
+      success = false;
+    }
+    numArgs -= NUM_BOUNDS_ARGS;
+  }
+
+  if (success && numArgs != 6)
+  {
+    cout << "Usage: " << argv[0] << " <parameterFile> <" <<
+            DELAY_OBJECTIVE_NAME << "|" << MAX_QUEUE_OBJECTIVE_NAME <<
+            "> <numReplications> <maxGenerations> <numThreads>" << endl;
+    cout << "       [" << BOUNDS_OPTION << " <minGreen> <maxGreen> "
+            "<minYellow> <maxYellow>] [" << CACHE_OPTION << " <cacheFile>]" <<
+            endl;
+    cout << "       (the file may not have timeSeries or traceRecords "
+            "lines)" << endl;
+    success = false;
+  }
+  else if (success)
+  {
+    maxGenerations = atoi(argv[4]);
+    if (string(argv[2]) == MAX_QUEUE_OBJECTIVE_NAME)
+    {
+      objective = OPTIMIZE_MAX_QUEUE;
+    }
+
+    if (string(argv[2]) != DELAY_OBJECTIVE_NAME &&
+        string(argv[2]) != MAX_QUEUE_OBJECTIVE_NAME)
+    {
+      cout << "ERROR: Objective must be " << DELAY_OBJECTIVE_NAME <<
+              " or " << MAX_QUEUE_OBJECTIVE_NAME << endl;
+      success = false;
+    }
+    else if (atoi(argv[3]) <= 0 || maxGenerations <= 0)
+    {
+      cout << "ERROR: Number of replications and generations must be "
+              "positive" << endl;
+      success = false;
+    }
+    else if (atoi(argv[5]) <= 0)
+    {
+      cout << "ERROR: Number of threads must be positive" << endl;
+      success = false;
+    }
+    else if (!optimizer.setup(string(argv[1]), atoi(argv[5]), atoi(argv[3]),
+                              objective))
+    {
+      cout << "Cannot optimize timings as parameters are not setup "
+              "properly!" << endl;
+      success = false;
+    }
+  }
+
+  if (success && !cacheFname.empty() && !optimizer.setupCache(cacheFname))
+  {
+    cout << "ERROR: Unable to open result cache file: " << cacheFname << endl;
+    success = false;
+  }
+
+  if (success)
+  {
+    timespec startTime;
+    timespec endTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    success = optimizer.run(maxGenerations, &cout);
+    clock_gettime(CLOCK_MONOTONIC, &endTime);
+
+    if (!success)
+    {
+      cout << "ERROR: Unable to start " << optimizer.getNumThreads() <<
+              " threads" << endl;
+    }
+    else
+    {
+      optimizer.print(cout);
+      if (optimizer.getResultCache().getIsOpen())
+      {
+        optimizer.getResultCache().print(cout);
+        cout << endl;
+      }
+      cout << "Threads: " << optimizer.getNumThreads() <<
+              " Elapsed seconds: " <<
+              (endTime.tv_sec - startTime.tv_sec) +
+              (endTime.tv_nsec - startTime.tv_nsec) / 1e9 << endl;
+    }
+  }
+
+  return (success ? 0 : 1);
+}
@@ -24,6 +24,14 @@ int getPositiveNormal(
      const double meanVal,
      const double stdDev
      )
+{
+  return ((int)getPositiveNormalReal(meanVal, stdDev));
+}
+
+double getPositiveNormalReal(
+     const double meanVal,
+     const double stdDev
+     )
 {
   const int NUM_UNIFORM = 12;
   const int MAX = 1000;
@@ -51,5 +59,11 @@ int getPositiveNormal(
   {
     newNormal *= - 1;
   }
-  return ((int)newNormal);
+  return (newNormal);
+}
+
+double getUniformReal(
+     )
+{
+  return ((rand() + 0.5) / ((double)RAND_MAX + 1.0));
 }
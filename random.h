@@ -31,4 +31,15 @@ int getPositiveNormal(
      const double stdDev
      );
 
+//Same as getPositiveNormal, but without truncating the result to an int.
+double getPositiveNormalReal(
+     const double meanVal,
+     const double stdDev
+     );
+
+//Returns a real value from a uniform distribution over the open
+//interval (0, 1), so it is always safe to take its logarithm.
+double getUniformReal(
+     );
+
 #endif // _RANDOM_H_
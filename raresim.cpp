@@ -0,0 +1,97 @@
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <time.h>
+using namespace std;
+
+#include "IntersectionSimulationClass.h"
+#include "RareEventSplitterClass.h"
+
+//Name accepted on the command line for the longest queue of any approach
+const string ANY_DIRECTION = "Any";
+
+//Programmer: James Zhu
+//Date: October 2026
+//Purpose: Estimates the probability that a queue reaches a rare length
+//         (such as the storage of an approach) before the simulation end
+//         time, by multilevel splitting with numLevels evenly spaced
+//         levels and runsPerLevel runs per level.  The direction is East,
+//         West, North or South for one approach's queue, or Any for the
+//         longest of them.
+int main(
+     int argc,
+     char *argv[]
+     )
+{
+  bool success = true;
+  IntersectionSimulationClass simObj;
+  RareEventSplitterClass splitter;
+  int dirIdx = -1;
+
+  if (argc != 6)
+  {
+    cout << "Usage: " << argv[0] << " <parameterFile> <direction|" <<
+            ANY_DIRECTION << "> <queueLength> <numLevels> <runsPerLevel>" <<
+            endl;
+    success = false;
+  }
+  else
+  {
+    string dirName = argv[2];
+
+    simObj.setLogStream(NULL);
+    simObj.readParametersFromFile(string(argv[1]));
+    if (dirName != ANY_DIRECTION)
+    {
+      for (int i = 0; i < NUM_DIRECTIONS; i++)
+      {
+        if (dirName == DIRECTION_NAMES[i])
+        {
+          dirIdx = i;
+        }
+      }
+    }
+
+    if (dirIdx < 0 && dirName != ANY_DIRECTION)
+    {
+      cout << "ERROR: Unknown direction: " << dirName << endl;
+      success = false;
+    }
+    else if (!splitter.setupEvenLevels(atoi(argv[3]), atoi(argv[4]),
+                                       atoi(argv[5])))
+    {
+      cout << "ERROR: Queue length, levels and runs per level must be "
+              "positive, with no more levels than cars" << endl;
+      success = false;
+    }
+    else if (!simObj.getIsSetupProperly())
+    {
+      cout << "Cannot run splitting as parameters are not setup properly!" <<
+              endl;
+      success = false;
+    }
+    else if (!simObj.getCanSaveState())
+    {
+      cout << "ERROR: Splitting does not support arrival traces" << endl;
+      success = false;
+    }
+  }
+
+  if (success)
+  {
+    timespec startTime;
+    timespec endTime;
+
+    //Every run needs substreams of its own
+    simObj.setRandomStreams(true, false);
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    splitter.run(simObj, dirIdx);
+    clock_gettime(CLOCK_MONOTONIC, &endTime);
+
+    splitter.print(cout);
+    cout << "Elapsed seconds: " << (endTime.tv_sec - startTime.tv_sec) +
+            (endTime.tv_nsec - startTime.tv_nsec) / 1e9 << endl;
+  }
+
+  return (success ? 0 : 1);
+}
@@ -0,0 +1,221 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+#include <algorithm>
+#include <climits>
+#include <stdint.h>
+#include <time.h>
+using namespace std;
+
+#include "IntersectionSimulationClass.h"
+#include "SimulationJournalClass.h"
+
+//Names of the LIGHT_* states
+const string LIGHT_NAMES[LIGHT_YELLOW_LEFT_NS + 1] = {
+     "unknown", "east-west green", "east-west yellow", "north-south green",
+     "north-south yellow", "east-west left-turn green",
+     "east-west left-turn yellow", "north-south left-turn green",
+     "north-south left-turn yellow" };
+
+//Returns the seconds from startTime to now.
+double getSecondsSince(
+     const timespec &startTime
+     )
+{
+  timespec endTime;
+
+  clock_gettime(CLOCK_MONOTONIC, &endTime);
+  return ((endTime.tv_sec - startTime.tv_sec) +
+          (endTime.tv_nsec - startTime.tv_nsec) / 1e9);
+}
+
+//Prints the step, time, light and queue lengths the simulation is at.
+void printState(
+     const IntersectionSimulationClass &simObj,
+     const SimulationJournalClass &journal
+     )
+{
+  cout << "Step: " << journal.getCurrentStep() << " of " <<
+          journal.getNumSteps() << " Time: " << simObj.getCurrentTime() <<
+          " Light: " << LIGHT_NAMES[simObj.getCurrentLight()] <<
+          " Queues:";
+  for (int i = 0; i < NUM_DIRECTIONS; i++)
+  {
+    cout << " " << DIRECTION_NAMES[i] << " " <<
+            simObj.getApproachQueueLength(i);
+  }
+  cout << endl;
+}
+
+//Programmer: James Zhu
+//Date: October 2026
+//Purpose: Records a run of a parameter file once, with a snapshot every
+//         snapshotEvents events, then takes commands from standard input
+//         to revisit it at any point, forwards or backwards, without
+//         rerunning it from the start:
+//           seek <time>  - go to just after the last event at or before
+//                          the time
+//           goto <step>  - go to just after the given number of events
+//           step [n]     - handle the next n (default 1) events, narrated
+//           back [n]     - go back n (default 1) events
+//           list [n]     - list the next n (default 10) journalled events
+//           state        - print where the run is
+//           quit         - exit
+int main(
+     int argc,
+     char *argv[]
+     )
+{
+  bool success = true;
+  IntersectionSimulationClass simObj;
+  SimulationJournalClass journal;
+
+  if (argc != 3)
+  {
+    cout << "Usage: " << argv[0] << " <parameterFile> <snapshotEvents>" <<
+            endl;
+    success = false;
+  }
+  else
+  {
+    simObj.setLogStream(NULL);
+    simObj.readParametersFromFile(string(argv[1]));
+    if (atoi(argv[2]) <= 0)
+    {
+      cout << "ERROR: Events between snapshots must be positive" << endl;
+      success = false;
+    }
+    else if (!simObj.getIsSetupProperly())
+    {
+      cout << "Cannot replay as parameters are not setup properly!" << endl;
+      success = false;
+    }
+    else if (!simObj.getCanSaveState())
+    {
+      cout << "ERROR: Replay does not support arrival traces" << endl;
+      success = false;
+    }
+  }
+
+  if (success)
+  {
+    timespec startTime;
+    string commandLine;
+
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    if (!journal.record(simObj, atoi(argv[2])))
+    {
+      cout << "ERROR: Unable to write the journal's temporary files" << endl;
+      success = false;
+    }
+    else
+    {
+      cout << "Recorded in " << getSecondsSince(startTime) << " seconds - ";
+      journal.print(cout);
+      cout << endl;
+      printState(simObj, journal);
+    }
+
+    while (success && getline(cin, commandLine))
+    {
+      istringstream commandStream(commandLine);
+      string command;
+      int64_t number;
+      int64_t count = 1;
+      bool isMoved = false;
+
+      commandStream >> command;
+      if (command.empty())
+      {
+        continue;
+      }
+      if (command == "quit")
+      {
+        break;
+      }
+      if (command == "list")
+      {
+        count = 10;
+      }
+      if (commandStream >> number)
+      {
+        count = number;
+      }
+      else if (command == "seek" || command == "goto")
+      {
+        cout << "ERROR: " << command << " needs a number" << endl;
+        continue;
+      }
+
+      clock_gettime(CLOCK_MONOTONIC, &startTime);
+      if (command == "seek")
+      {
+        isMoved = journal.goToStep(simObj, journal.getStepAtTime(
+                      (int)max(min(count, (int64_t)INT_MAX),
+                               (int64_t)INT_MIN)));
+      }
+      else if (command == "goto")
+      {
+        isMoved = journal.goToStep(simObj, count);
+        if (!isMoved && !journal.getIsDiverged())
+        {
+          cout << "ERROR: Steps run from 0 to " << journal.getNumSteps() <<
+                  endl;
+          continue;
+        }
+      }
+      else if (command == "back")
+      {
+        isMoved = journal.goToStep(simObj,
+                                   max(journal.getCurrentStep() - count,
+                                       (int64_t)0));
+      }
+      else if (command == "step")
+      {
+        //Only the events stepped through are narrated
+        simObj.setLogStream(&cout);
+        isMoved = true;
+        for (int64_t i = 0; isMoved && i < count; i++)
+        {
+          isMoved = journal.stepForward(simObj);
+        }
+        simObj.setLogStream(NULL);
+        isMoved = !journal.getIsDiverged();
+      }
+      else if (command == "list")
+      {
+        const int64_t endStep = min(journal.getCurrentStep() + count,
+                                    journal.getNumSteps());
+        JournalEntryStruct entry;
+
+        for (int64_t i = journal.getCurrentStep();
+             i < endStep && journal.getEntry(i, entry); i++)
+        {
+          cout << "Step " << i << ": " <<
+                  EventClass(entry.eventTime, entry.eventType) <<
+                  " Shared draws: " << entry.numSharedDraws << endl;
+        }
+        continue;
+      }
+      else if (command != "state")
+      {
+        cout << "ERROR: Unknown command: " << command << endl;
+        continue;
+      }
+
+      if (journal.getIsDiverged())
+      {
+        cout << "ERROR: Replay diverged from the journal at step " <<
+                journal.getCurrentStep() << endl;
+      }
+      else if (isMoved)
+      {
+        cout << "(" << getSecondsSince(startTime) << " seconds)" << endl;
+      }
+      printState(simObj, journal);
+    }
+  }
+
+  return (success ? 0 : 1);
+}
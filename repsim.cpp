@@ -0,0 +1,79 @@
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <time.h>
+using namespace std;
+
+#include "ReplicationRunnerClass.h"
+
+//Programmer: James Zhu
+//Date: October 2026
+//Purpose: Runs numReplications replications of a parameter file (the
+//         seed increased by one each time, with substreams) on numThreads
+//         threads, and prints the mean, spread and range of every
+//         statistic over them.  The summary is identical whatever the
+//         number of threads.  Files with timeSeries or traceRecords
+//         lines are refused, as every replication would write the file.
+int main(
+     int argc,
+     char *argv[]
+     )
+{
+  bool success = true;
+  ReplicationRunnerClass runner;
+  int numReplications = 0;
+
+  if (argc != 4)
+  {
+    cout << "Usage: " << argv[0] <<
+            " <parameterFile> <numReplications> <numThreads>" << endl;
+    cout << "       (the file may not have timeSeries or traceRecords "
+            "lines)" << endl;
+    success = false;
+  }
+  else
+  {
+    numReplications = atoi(argv[2]);
+    if (numReplications <= 0)
+    {
+      cout << "ERROR: Number of replications must be positive" << endl;
+      success = false;
+    }
+    else if (atoi(argv[3]) <= 0)
+    {
+      cout << "ERROR: Number of threads must be positive" << endl;
+      success = false;
+    }
+    else if (!runner.setup(string(argv[1]), atoi(argv[3])))
+    {
+      cout << "Cannot run replications as parameters are not setup "
+              "properly!" << endl;
+      success = false;
+    }
+  }
+
+  if (success)
+  {
+    timespec startTime;
+    timespec endTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    success = runner.run(numReplications);
+    clock_gettime(CLOCK_MONOTONIC, &endTime);
+
+    if (!success)
+    {
+      cout << "ERROR: Unable to start " << runner.getNumThreads() <<
+              " threads" << endl;
+    }
+    else
+    {
+      runner.getStats().print(cout);
+      cout << "Threads: " << runner.getNumThreads() << " Elapsed seconds: " <<
+              (endTime.tv_sec - startTime.tv_sec) +
+              (endTime.tv_nsec - startTime.tv_nsec) / 1e9 << endl;
+    }
+  }
+
+  return (success ? 0 : 1);
+}
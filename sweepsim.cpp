@@ -0,0 +1,145 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <time.h>
+using namespace std;
+
+#include "SweepCoordinatorClass.h"
+#include "ScenarioBatchClass.h"
+
+//Option, given last, that answers scenarios run before from a result
+//cache file, and adds new results to it
+const string CACHE_OPTION = "--cache";
+
+//Programmer: James Zhu
+//Date: October 2026
+//Purpose: Runs a sweep in numWorkers worker processes, handed out
+//         chunkSize scenarios at a time: either every row of a scenario
+//         batch file, or a seed sweep of a parameter file (scenario i
+//         uses the file's parameters with the random seed increased by
+//         i).  Each scenario's statistics are printed as soon as a worker
+//         sends them, and recorded in the progress file, so running the
+//         same command again after an interruption only runs the
+//         scenarios not yet in it.  With the cache option, scenarios
+//         found in the result cache are not run at all.  Parameter files
+//         with timeSeries or traceRecords lines are refused, as every
+//         scenario would write the file.
+int main(
+     int argc,
+     char *argv[]
+     )
+{
+  bool success = true;
+  int numArgs = argc;
+  string cacheFname;
+  SweepCoordinatorClass coordinator;
+
+  if (numArgs >= 4 && string(argv[numArgs - 2]) == CACHE_OPTION)
+  {
+    cacheFname = argv[numArgs - 1];
+    numArgs -= 2;
+  }
+
+  if (numArgs == 5)
+  {
+    ScenarioBatchClass batchFile;
+
+    if (atoi(argv[2]) <= 0 || atoi(argv[3]) <= 0)
+    {
+      cout << "ERROR: Number of workers and chunk size must be positive" <<
+              endl;
+      success = false;
+    }
+    else if (!batchFile.loadFile(string(argv[1])))
+    {
+      cout << "ERROR: Unable to open scenario batch file: " << argv[1] <<
+              endl;
+      success = false;
+    }
+    else
+    {
+      for (int i = 0; i < batchFile.getNumErrors(); i++)
+      {
+        cout << "ERROR: Line " << batchFile.getError(i).lineNum << ": " <<
+                batchFile.getError(i).message << endl;
+      }
+      if (!coordinator.setupScenarios(
+                vector< SimulationParamsStruct >(batchFile.getScenarios(),
+                                                 batchFile.getScenarios() +
+                                                 batchFile.getNumScenarios()),
+                atoi(argv[2]), atoi(argv[3])))
+      {
+        cout << "ERROR: No valid scenarios to run" << endl;
+        success = false;
+      }
+    }
+  }
+  else if (numArgs == 6)
+  {
+    if (atoi(argv[2]) <= 0)
+    {
+      cout << "ERROR: Number of scenarios must be positive" << endl;
+      success = false;
+    }
+    else if (atoi(argv[3]) <= 0 || atoi(argv[4]) <= 0)
+    {
+      cout << "ERROR: Number of workers and chunk size must be positive" <<
+              endl;
+      success = false;
+    }
+    else if (!coordinator.setupSeedSweep(string(argv[1]), atoi(argv[2]),
+                                         atoi(argv[3]), atoi(argv[4])))
+    {
+      cout << "Cannot run sweep as parameters are not setup properly!" <<
+              endl;
+      success = false;
+    }
+  }
+  else
+  {
+    cout << "Usage: " << argv[0] <<
+            " <scenarioBatchFile> <numWorkers> <chunkSize> <progressFile>"
+            " [" << CACHE_OPTION << " <cacheFile>]" << endl;
+    cout << "       " << argv[0] << " <parameterFile> <numScenarios> "
+            "<numWorkers> <chunkSize> <progressFile> [" << CACHE_OPTION <<
+            " <cacheFile>]" << endl;
+    cout << "       (the parameter file may not have timeSeries or "
+            "traceRecords lines)" << endl;
+    success = false;
+  }
+
+  if (success && !cacheFname.empty() && !coordinator.setupCache(cacheFname))
+  {
+    cout << "ERROR: Unable to open result cache file: " <<
+            cacheFname << endl;
+    success = false;
+  }
+
+  if (success)
+  {
+    timespec startTime;
+    timespec endTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    success = coordinator.run(string(argv[numArgs - 1]), cout);
+    clock_gettime(CLOCK_MONOTONIC, &endTime);
+
+    if (success)
+    {
+      double elapsedSecs = (endTime.tv_sec - startTime.tv_sec) +
+                           (endTime.tv_nsec - startTime.tv_nsec) / 1e9;
+      coordinator.print(cout);
+      cout << endl;
+      if (coordinator.getResultCache().getIsOpen())
+      {
+        coordinator.getResultCache().print(cout);
+        cout << endl;
+      }
+      cout << "Swept " << coordinator.getNumScenarios() <<
+              " scenarios in " << elapsedSecs << " seconds" << endl;
+    }
+  }
+
+  return (success ? 0 : 1);
+}
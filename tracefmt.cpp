@@ -0,0 +1,32 @@
+#include <iostream>
+#include <string>
+using namespace std;
+
+#include "TraceRecorderClass.h"
+
+//Programmer: James Zhu
+//Date: October 2026
+//Purpose: Renders a trace file, written by a simulation run with the
+//         traceRecords parameter, as the narration the run would have
+//         printed.
+int main(
+     int argc,
+     char *argv[]
+     )
+{
+  bool success = true;
+
+  if (argc != 2)
+  {
+    cout << "Usage: " << argv[0] << " <traceFile>" << endl;
+    success = false;
+  }
+  else if (!TraceRecorderClass::renderFile(string(argv[1]), cout))
+  {
+    cout << "ERROR: Unable to read trace file, or it has records that "
+            "can't be rendered: " << argv[1] << endl;
+    success = false;
+  }
+
+  return (success ? 0 : 1);
+}